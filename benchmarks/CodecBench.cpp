@@ -0,0 +1,229 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pickup/buffer/ByteBuffer.h"
+#include "pickup/codec/base64.h"
+#include "pickup/codec/hex.h"
+#include "pickup/codec/url.h"
+#include "pickup/utils/CpuFeatures.h"
+
+#include "RandomData.h"
+
+using namespace pickup;
+using Clock = std::chrono::steady_clock;
+using utils::SimdLevel;
+using test::randomBytes;
+
+namespace {
+
+constexpr size_t kSizes[] = {16, 256, 4 << 10, 64 << 10, 1 << 20, 16 << 20, 64 << 20};
+constexpr double kMinSeconds = 0.05;
+
+volatile uint8_t gSink;  // 防止编译器消除被测代码
+
+// 以文本为主、约 1/8 的字节需要转义的 URL 输入
+std::string urlText(size_t len, uint32_t seed) {
+  static const char kPlain[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-._~";
+  static const char kSpecial[] = " /?&=+%#:@\xE4\xB8\xAD";
+  std::string s(len, '\0');
+  for (auto& c : s) {
+    seed = seed * 1664525u + 1013904223u;
+    const uint32_t r = seed >> 16;
+    c = (r & 7) == 0 ? kSpecial[r % (sizeof(kSpecial) - 1)] : kPlain[r % (sizeof(kPlain) - 1)];
+  }
+  return s;
+}
+
+// 重复执行 body 直到累计时间不少于 kMinSeconds，返回吞吐量（MB/s，按输入字节计）
+double throughput(size_t bytes, const std::function<void()>& body) {
+  size_t iterations = 0;
+  const auto start = Clock::now();
+  double elapsed = 0;
+  do {
+    body();
+    ++iterations;
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  } while (elapsed < kMinSeconds);
+  return static_cast<double>(bytes) * static_cast<double>(iterations) / elapsed / 1e6;
+}
+
+struct Inputs {
+  std::string raw;      ///< 随机字节
+  std::string b64;      ///< raw 的标准 Base64
+  std::string b64Url;   ///< raw 的 URL 安全无填充 Base64
+  std::string hex;      ///< raw 的十六进制
+  std::string hexSep;   ///< raw 的带 ':' 分隔十六进制
+  std::string text;     ///< URL 原文
+  std::string urlForm;  ///< text 的表单编码
+};
+
+Inputs makeInputs(size_t size) {
+  Inputs in;
+  in.raw = randomBytes(size, 1);
+  in.b64 = codec::base64::encode(in.raw);
+  in.b64Url = codec::base64::encode(in.raw, codec::base64::Variant::UrlSafeNoPad);
+  in.hex = codec::hex::encode(reinterpret_cast<const uint8_t*>(in.raw.data()), in.raw.size());
+  in.hexSep = codec::hex::encodeWithSeparator(reinterpret_cast<const uint8_t*>(in.raw.data()), in.raw.size(),
+                                              true, ':');
+  in.text = urlText(size, 2);
+  in.urlForm = codec::url::encode(in.text, codec::url::Component::Form);
+  return in;
+}
+
+struct Case {
+  const char* name;
+  bool perLevel;  ///< 是否在每个 SIMD 级别下分别测量（否则只测当前最高级别）
+  SimdLevel maxLevel;
+  std::string Inputs::*input;  ///< 被测函数读取的输入，吞吐量按它的长度计算
+  std::function<void(const Inputs&, std::vector<uint8_t>&)> run;
+};
+
+const uint8_t* bytesOf(const std::string& s) { return reinterpret_cast<const uint8_t*>(s.data()); }
+
+std::vector<Case> makeCases() {
+  namespace b64 = codec::base64;
+  namespace hex = codec::hex;
+  namespace url = codec::url;
+  return {
+      {"base64.encode", true, SimdLevel::AVX512VBMI, &Inputs::raw,
+       [](const Inputs& in, std::vector<uint8_t>& out) {
+         b64::encode(bytesOf(in.raw), in.raw.size(), reinterpret_cast<char*>(out.data()));
+       }},
+      {"base64.decode", true, SimdLevel::AVX512VBMI, &Inputs::b64,
+       [](const Inputs& in, std::vector<uint8_t>& out) { b64::decode(in.b64.data(), in.b64.size(), out.data()); }},
+      {"base64.decodeStrict", true, SimdLevel::AVX512VBMI, &Inputs::b64,
+       [](const Inputs& in, std::vector<uint8_t>& out) {
+         (void)b64::decodeStrict(in.b64.data(), in.b64.size(), out.data(), b64::Variant::Standard);
+       }},
+      {"base64.encode.urlNoPad", false, SimdLevel::AVX512VBMI, &Inputs::raw,
+       [](const Inputs& in, std::vector<uint8_t>& out) {
+         b64::encode(bytesOf(in.raw), in.raw.size(), reinterpret_cast<char*>(out.data()), b64::Variant::UrlSafeNoPad);
+       }},
+      {"base64.decodeStrict.urlNoPad", false, SimdLevel::AVX512VBMI, &Inputs::b64Url,
+       [](const Inputs& in, std::vector<uint8_t>& out) {
+         (void)b64::decodeStrict(in.b64Url.data(), in.b64Url.size(), out.data(), b64::Variant::UrlSafeNoPad);
+       }},
+      {"base64.Encoder/64K", false, SimdLevel::AVX512VBMI, &Inputs::raw,
+       [](const Inputs& in, std::vector<uint8_t>&) {
+         static buffer::ByteBuffer sink;
+         sink.clear();
+         b64::Encoder enc;
+         const std::string_view data(in.raw);
+         for (size_t pos = 0; pos < data.size(); pos += 64 << 10) {
+           const auto chunk = data.substr(pos, 64 << 10);
+           enc.update(std::span(reinterpret_cast<const uint8_t*>(chunk.data()), chunk.size()), sink);
+         }
+         enc.finish(sink);
+       }},
+      {"base64.Decoder/64K", false, SimdLevel::AVX512VBMI, &Inputs::b64,
+       [](const Inputs& in, std::vector<uint8_t>&) {
+         static buffer::ByteBuffer sink;
+         sink.clear();
+         b64::Decoder dec;
+         const std::string_view data(in.b64);
+         for (size_t pos = 0; pos < data.size(); pos += 64 << 10) {
+           dec.update(data.substr(pos, 64 << 10), sink);
+         }
+         dec.finish(sink);
+       }},
+      {"hex.encode", true, SimdLevel::AVX2, &Inputs::raw,
+       [](const Inputs& in, std::vector<uint8_t>& out) {
+         hex::encode(std::span(bytesOf(in.raw), in.raw.size()),
+                     std::span(reinterpret_cast<char*>(out.data()), out.size()));
+       }},
+      {"hex.decode", true, SimdLevel::AVX2, &Inputs::hex,
+       [](const Inputs& in, std::vector<uint8_t>& out) { (void)hex::decode(in.hex, out); }},
+      {"hex.decodeWithSeparator", false, SimdLevel::AVX2, &Inputs::hexSep,
+       [](const Inputs& in, std::vector<uint8_t>& out) { (void)hex::decodeWithSeparator(in.hexSep, out, ':'); }},
+      {"url.encode.form", true, SimdLevel::AVX2, &Inputs::text,
+       [](const Inputs& in, std::vector<uint8_t>& out) {
+         url::encode(in.text, std::span(reinterpret_cast<char*>(out.data()), out.size()), url::Component::Form);
+       }},
+      {"url.encode.path", false, SimdLevel::AVX2, &Inputs::text,
+       [](const Inputs& in, std::vector<uint8_t>& out) {
+         url::encode(in.text, std::span(reinterpret_cast<char*>(out.data()), out.size()), url::Component::Path);
+       }},
+      {"url.decode.form", true, SimdLevel::AVX2, &Inputs::urlForm,
+       [](const Inputs& in, std::vector<uint8_t>& out) {
+         (void)url::decode(in.urlForm, std::span(reinterpret_cast<char*>(out.data()), out.size()),
+                           url::Component::Form);
+       }},
+  };
+}
+
+std::string sizeLabel(size_t size) {
+  if (size >= (1 << 20)) return std::to_string(size >> 20) + "M";
+  if (size >= (1 << 10)) return std::to_string(size >> 10) + "K";
+  return std::to_string(size) + "B";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::string filter = argc > 1 ? argv[1] : "";
+  const size_t maxSize = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : (64u << 20);
+
+  const SimdLevel detected = utils::detectedSimdLevel();
+  const SimdLevel previousLimit = utils::simdLevelLimit();
+  // 列为原始数据大小；解码类用例的输入是它编码后的结果，吞吐量按实际输入长度计算
+  std::printf("codec throughput (MB/s of input; columns: raw data size), cpu: %s\n", utils::toString(detected));
+  std::printf("%-40s", "case");
+  std::vector<size_t> sizes;
+  for (size_t size : kSizes) {
+    if (size <= maxSize) {
+      sizes.push_back(size);
+      std::printf(" %9s", sizeLabel(size).c_str());
+    }
+  }
+  std::printf("\n");
+
+  const std::vector<Case> cases = makeCases();
+  const SimdLevel levels[] = {SimdLevel::None, SimdLevel::SSSE3, SimdLevel::AVX2, SimdLevel::AVX512VBMI};
+
+  // 按尺寸外层循环，每种尺寸只生成一次输入；结果暂存后按行输出
+  std::vector<std::string> names;
+  std::vector<std::vector<double>> results;
+  for (size_t s = 0; s < sizes.size(); ++s) {
+    const Inputs inputs = makeInputs(sizes[s]);
+    std::vector<uint8_t> out(sizes[s] * 3 + 64);
+    size_t row = 0;
+    for (const Case& c : cases) {
+      if (!filter.empty() && std::string_view(c.name).find(filter) == std::string_view::npos) {
+        continue;
+      }
+      for (SimdLevel level : levels) {
+        if (level > detected || level > c.maxLevel) {
+          continue;
+        }
+        if (!c.perLevel && level != std::min(detected, c.maxLevel)) {
+          continue;
+        }
+        if (s == 0) {
+          names.push_back(std::string(c.name) + " [" + utils::toString(level) + "]");
+          results.emplace_back();
+        }
+        utils::setSimdLevelLimit(level);
+        results[row++].push_back(throughput((inputs.*c.input).size(), [&] {
+          c.run(inputs, out);
+          gSink = out[0];
+        }));
+      }
+    }
+    utils::setSimdLevelLimit(previousLimit);
+  }
+
+  for (size_t row = 0; row < names.size(); ++row) {
+    std::printf("%-40s", names[row].c_str());
+    for (double mbps : results[row]) {
+      std::printf(" %9.0f", mbps);
+    }
+    std::printf("\n");
+  }
+  return 0;
+}
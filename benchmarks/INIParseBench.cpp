@@ -0,0 +1,69 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "pickup/config/INIParser.h"
+#include "pickup/config/INIReader.h"
+
+using namespace pickup::config;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// 模拟生成的路由表：少量 section，每个 section 大量键
+std::string routingTable(size_t keys) {
+  std::string text;
+  text.reserve(keys * 40);
+  for (size_t i = 0; i < keys; ++i) {
+    if (i % 50000 == 0) text += "\n[zone" + std::to_string(i / 50000) + "]\n";
+    text += "route_" + std::to_string(i) + " = 10." + std::to_string((i >> 16) & 255) + "." +
+            std::to_string((i >> 8) & 255) + "." + std::to_string(i & 255) + " ; gw\n";
+  }
+  return text;
+}
+
+template <typename Body>
+double bestSeconds(int rounds, Body&& body) {
+  double best = 1e30;
+  for (int r = 0; r < rounds; ++r) {
+    const auto start = Clock::now();
+    body();
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    if (elapsed < best) best = elapsed;
+  }
+  return best;
+}
+
+void report(const char* name, size_t keys, size_t bytes, double seconds) {
+  std::printf("%-24s %10.1f ms %10.1f MB/s %10.2f Mkeys/s\n", name, seconds * 1e3,
+              static_cast<double>(bytes) / seconds / 1e6, static_cast<double>(keys) / seconds / 1e6);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const size_t keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500000;
+  const std::string text = routingTable(keys);
+  std::printf("%zu keys, %.1f MB\n", keys, static_cast<double>(text.size()) / 1e6);
+
+  size_t counted = 0;
+  report("INIParser (SAX)", keys, text.size(), bestSeconds(5, [&] {
+           counted = 0;
+           INIParser::parse(text, [&](std::string_view, std::string_view, std::string_view) {
+             ++counted;
+             return true;
+           });
+         }));
+
+  size_t found = 0;
+  report("INIReader (indexed)", keys, text.size(), bestSeconds(3, [&] {
+           std::istringstream stream(text);
+           INIReader reader(stream);
+           found = reader.hasValue("zone0", "route_1") ? 1 : 0;
+         }));
+
+  return counted == keys && found == 1 ? 0 : 1;
+}
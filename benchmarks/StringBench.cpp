@@ -0,0 +1,200 @@
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pickup/utils/CpuFeatures.h"
+#include "pickup/utils/StringUtils.h"
+
+using namespace pickup;
+using Clock = std::chrono::steady_clock;
+using utils::SimdLevel;
+
+namespace {
+
+constexpr size_t kLines = 4096;
+constexpr double kMinSeconds = 0.1;
+
+volatile size_t gSink;  // 防止编译器消除被测代码
+
+// 形如访问日志的行，长度约 120~260 字节，行首尾带少量空白
+std::vector<std::string> logLines(size_t count) {
+  static const char* const kLevels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+  static const char* const kPaths[] = {"/api/v1/orders", "/api/v1/users/profile", "/static/app.js",
+                                       "/api/v1/search?q=pickup&page=2", "/healthz"};
+  std::vector<std::string> lines;
+  lines.reserve(count);
+  uint32_t seed = 12345;
+  auto next = [&seed] {
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+  };
+  for (size_t i = 0; i < count; ++i) {
+    std::string line = std::string(next() % 3, ' ');
+    line += "2026-10-18 12:" + std::to_string(next() % 60) + ":" + std::to_string(next() % 60) + "." +
+            std::to_string(next() % 1000) + " " + kLevels[next() % 4] + " [worker-" + std::to_string(next() % 16) +
+            "] request_id=" + std::to_string(next()) + " method=GET path=" + kPaths[next() % 5] +
+            " status=" + std::to_string(next() % 8 == 0 ? 500 : 200) + " latency_ms=" + std::to_string(next() % 900) +
+            " user_agent=\"Mozilla/5.0 (X11; Linux x86_64)\" bytes=" + std::to_string(next() % 100000);
+    if (next() % 2) line += " referer=https://example.com/index.html";
+    line += std::string(next() % 3, ' ') + "\t";
+    lines.push_back(std::move(line));
+  }
+  return lines;
+}
+
+// ---------------------------------------------------------------------------
+// 改为 SIMD 内核之前的实现，作为对照
+// ---------------------------------------------------------------------------
+
+std::vector<std::string> baselineSplit(const std::string& str, const std::string& delimiter) {
+  std::vector<std::string> vec;
+  size_t start = 0;
+  size_t pos = 0;
+  while ((pos = str.find(delimiter, start)) != std::string::npos) {
+    vec.emplace_back(str.substr(start, pos - start));
+    start = pos + delimiter.size();
+  }
+  vec.emplace_back(str.substr(start));
+  return vec;
+}
+
+std::vector<std::string> baselineSplitAnyOf(const std::string& str, const std::string& delimiters) {
+  std::vector<std::string> vec;
+  size_t old_pos = 0;
+  size_t pos = 0;
+  while ((pos = str.find_first_of(delimiters, old_pos)) != std::string::npos) {
+    vec.emplace_back(str.substr(old_pos, pos - old_pos));
+    old_pos = pos + 1;
+  }
+  vec.emplace_back(str.substr(old_pos));
+  return vec;
+}
+
+std::string baselineReplaceAll(const std::string& str, const std::string& from, const std::string& to) {
+  std::string result = str;
+  size_t pos = 0;
+  while ((pos = result.find(from, pos)) != std::string::npos) {
+    result.replace(pos, from.length(), to);
+    pos += to.length();
+  }
+  return result;
+}
+
+void baselineTrim(std::string& str, const std::string& chars) {
+  const auto pos = str.find_last_not_of(chars);
+  if (pos == std::string::npos) {
+    str.clear();
+  } else {
+    str.erase(pos + 1);
+  }
+  str.erase(0, str.find_first_not_of(chars));
+}
+
+struct Case {
+  const char* name;
+  std::function<size_t(const std::string&)> baseline;
+  std::function<size_t(const std::string&)> current;
+};
+
+std::vector<Case> makeCases() {
+  return {
+      {"contains(\"status=503\") miss",
+       [](const std::string& s) { return static_cast<size_t>(s.find("status=503") != std::string::npos); },
+       [](const std::string& s) { return static_cast<size_t>(utils::contains(s, "status=503")); }},
+      {"contains(\"referer=\")",
+       [](const std::string& s) { return static_cast<size_t>(s.find("referer=") != std::string::npos); },
+       [](const std::string& s) { return static_cast<size_t>(utils::contains(s, "referer=")); }},
+      {"replaceAll(\"/api/v1\", \"/api/v2\")",
+       [](const std::string& s) { return baselineReplaceAll(s, "/api/v1", "/api/v2").size(); },
+       [](const std::string& s) { return utils::replaceAll(s, "/api/v1", "/api/v2").size(); }},
+      {"replaceAll(\"=\", \": \")", [](const std::string& s) { return baselineReplaceAll(s, "=", ": ").size(); },
+       [](const std::string& s) { return utils::replaceAll(s, "=", ": ").size(); }},
+      {"split(\" \")", [](const std::string& s) { return baselineSplit(s, " ").size(); },
+       [](const std::string& s) { return utils::split(s, ' ').size(); }},
+      {"split(\" status=\")", [](const std::string& s) { return baselineSplit(s, " status=").size(); },
+       [](const std::string& s) { return utils::split(s, " status=").size(); }},
+      {"splitAnyOf(\" =[]\\\"\")", [](const std::string& s) { return baselineSplitAnyOf(s, " =[]\"").size(); },
+       [](const std::string& s) { return utils::splitAnyOf(s, " =[]\"").size(); }},
+      {"splitView(' ') count", [](const std::string& s) { return baselineSplit(s, " ").size(); },
+       [](const std::string& s) {
+         size_t n = 0;
+         for (std::string_view token : utils::splitView(s, ' ')) n += !token.empty();
+         return n;
+       }},
+      {"splitAnyOfView(\" =[]\\\"\") count",
+       [](const std::string& s) { return baselineSplitAnyOf(s, " =[]\"").size(); },
+       [](const std::string& s) {
+         size_t n = 0;
+         for (std::string_view token : utils::splitAnyOfView(s, " =[]\"")) n += !token.empty();
+         return n;
+       }},
+      {"splitAnyOf(\"|\") miss", [](const std::string& s) { return baselineSplitAnyOf(s, "|").size(); },
+       [](const std::string& s) { return utils::splitAnyOf(s, "|").size(); }},
+      {"trim(\" \\t\")",
+       [](const std::string& s) {
+         std::string t = s;
+         baselineTrim(t, " \t");
+         return t.size();
+       },
+       [](const std::string& s) {
+         std::string t = s;
+         utils::trim(t, " \t");
+         return t.size();
+       }},
+      {"isBlank", [](const std::string& s) { return static_cast<size_t>(s.find_first_not_of(" \t\n\r\f\v") == std::string::npos); },
+       [](const std::string& s) { return static_cast<size_t>(utils::isBlank(s)); }},
+  };
+}
+
+// 重复遍历所有行直到累计时间不少于 kMinSeconds，返回每行平均耗时（ns）
+double nsPerLine(const std::vector<std::string>& lines, const std::function<size_t(const std::string&)>& body) {
+  size_t rounds = 0;
+  size_t sink = 0;
+  const auto start = Clock::now();
+  double elapsed = 0;
+  do {
+    for (const auto& line : lines) sink += body(line);
+    ++rounds;
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  } while (elapsed < kMinSeconds);
+  gSink = sink;
+  return elapsed * 1e9 / static_cast<double>(rounds * lines.size());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::string filter = argc > 1 ? argv[1] : "";
+  const std::vector<std::string> lines = logLines(kLines);
+  size_t bytes = 0;
+  for (const auto& line : lines) bytes += line.size();
+
+  const SimdLevel detected = utils::detectedSimdLevel();
+  const SimdLevel previousLimit = utils::simdLevelLimit();
+  const SimdLevel levels[] = {SimdLevel::None, SimdLevel::SSSE3, SimdLevel::SSE42, SimdLevel::AVX2};
+  std::printf("StringUtils on log lines (ns/line, avg %zu bytes), cpu: %s\n", bytes / lines.size(),
+              utils::toString(detected));
+  std::printf("%-36s %9s", "case", "baseline");
+  for (SimdLevel level : levels) {
+    if (level <= detected) std::printf(" %9s", utils::toString(level));
+  }
+  std::printf("\n");
+
+  for (const Case& c : makeCases()) {
+    if (!filter.empty() && std::string_view(c.name).find(filter) == std::string_view::npos) {
+      continue;
+    }
+    std::printf("%-36s %9.1f", c.name, nsPerLine(lines, c.baseline));
+    for (SimdLevel level : levels) {
+      if (level > detected) continue;
+      utils::setSimdLevelLimit(level);
+      std::printf(" %9.1f", nsPerLine(lines, c.current));
+    }
+    utils::setSimdLevelLimit(previousLimit);
+    std::printf("\n");
+  }
+  return 0;
+}
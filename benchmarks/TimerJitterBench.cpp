@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "pickup/timer/Timer.h"
+
+using namespace pickup::timer;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// 逐个调度一次性任务：每个任务触发时记录相对目标时刻的滞后，并调度下一个
+std::vector<double> measure(const TimerOptions& options, int samples, std::chrono::microseconds delay) {
+  Timer timer(options);
+  std::vector<double> lagsUs;
+  lagsUs.reserve(static_cast<size_t>(samples));
+  std::promise<void> done;
+
+  struct Chain {
+    Timer* timer;
+    std::chrono::microseconds delay;
+    int remaining;
+    Clock::time_point target;
+    std::vector<double>* lags;
+    std::promise<void>* done;
+
+    void arm(const std::shared_ptr<Chain>& self) {
+      target = Clock::now() + delay;
+      timer->schedule([self] { self->fire(self); }, delay);
+    }
+    void fire(const std::shared_ptr<Chain>& self) {
+      const auto lag = Clock::now() - target;
+      lags->push_back(std::chrono::duration<double, std::micro>(lag).count());
+      if (--remaining > 0) {
+        arm(self);
+      } else {
+        done->set_value();
+      }
+    }
+  };
+
+  auto chain = std::make_shared<Chain>(Chain{&timer, delay, samples, {}, &lagsUs, &done});
+  chain->arm(chain);
+  done.get_future().wait();
+  return lagsUs;
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+  const auto index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+  return sorted[index];
+}
+
+void report(const std::string& name, std::vector<double> lags) {
+  if (lags.empty()) {
+    std::printf("%-22s (no samples)\n", name.c_str());
+    return;
+  }
+  std::sort(lags.begin(), lags.end());
+  std::printf("%-22s %9.2f %9.2f %9.2f %9.2f %9.2f\n", name.c_str(), percentile(lags, 0.50),
+              percentile(lags, 0.90), percentile(lags, 0.99), percentile(lags, 0.999), lags.back());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int samples = argc > 1 ? std::atoi(argv[1]) : 2000;
+  const auto delay = std::chrono::microseconds(argc > 2 ? std::atoi(argv[2]) : 500);
+  if (samples <= 0) {
+    std::fprintf(stderr, "usage: %s [samples > 0] [delay_us]\n", argv[0]);
+    return 1;
+  }
+
+  std::printf("firing lag (us), %d samples, delay %lld us\n", samples, static_cast<long long>(delay.count()));
+  std::printf("%-22s %9s %9s %9s %9s %9s\n", "mode", "p50", "p90", "p99", "p99.9", "max");
+
+  report("condition_variable", measure(TimerOptions{}, samples, delay));
+  for (int spinUs : {0, 20, 50, 100, 200}) {
+    TimerOptions options;
+    options.highResolution = true;
+    options.spinWindow = std::chrono::microseconds(spinUs);
+    report("high-res spin " + std::to_string(spinUs) + "us", measure(options, samples, delay));
+  }
+  return 0;
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "pickup/buffer/ByteBuffer.h"
+#include "pickup/buffer/Varint.h"
+#include "pickup/utils/Endian.hpp"
+
+namespace pickup {
+namespace buffer {
+
+/**
+ * @brief 从字节区解析 BinaryWriter 格式字段的反序列化器
+ *
+ * 所有读取都做边界检查：数据不足或编码非法时返回 false、不移动读位置，并进入失败
+ * 状态；失败状态是粘滞的，之后的读取一律返回 false。因此可以连续读取多个字段，
+ * 最后只检查一次 ok()。
+ *
+ * readString()/readBytes() 返回指向源数据的 string_view，不拷贝；源数据须在使用
+ * 这些视图期间保持不变。
+ *
+ * @code
+ * BinaryReader r(buffer);
+ * uint32_t id = 0;
+ * std::string_view name;
+ * r.read(id);
+ * r.readString(name);
+ * if (!r.ok()) return;       // 帧不完整或已损坏
+ * buffer.shift(r.position());
+ * @endcode
+ */
+class BinaryReader {
+ public:
+  using Byte = ByteBuffer::Byte;
+
+  /**
+   * @brief 在一段字节上构造
+   * @param data  数据起始
+   * @param size  数据长度
+   * @param order 定长数值的字节序
+   */
+  BinaryReader(const Byte* data, size_t size, utils::Endian order = utils::Endian::Big)
+      : data_(data), size_(size), order_(order) {}
+
+  /** @brief 在 ByteBuffer 的当前内容上构造（不消费缓冲区） */
+  explicit BinaryReader(const ByteBuffer& buffer, utils::Endian order = utils::Endian::Big)
+      : BinaryReader(buffer.data(), buffer.size(), order) {}
+
+  /** @brief 在字符串视图上构造 */
+  explicit BinaryReader(std::string_view bytes, utils::Endian order = utils::Endian::Big)
+      : BinaryReader(reinterpret_cast<const Byte*>(bytes.data()), bytes.size(), order) {}
+
+  /**
+   * @brief 读取定长数值
+   * @tparam T 整数或浮点类型（不含 bool）
+   * @return 成功返回 true；失败时 value 不变
+   */
+  template <typename T>
+  bool read(T& value) {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "T must be a non-bool arithmetic type");
+    if (!require(sizeof(T))) {
+      return false;
+    }
+    T raw;
+    std::memcpy(&raw, data_ + pos_, sizeof(T));
+    value = utils::convert_endian(raw, order_, utils::system_endian());
+    pos_ += sizeof(T);
+    return true;
+  }
+
+  /** @brief 读取无符号 varint（超过 10 字节或溢出 64 位视为非法） */
+  bool readVarint(uint64_t& value);
+
+  /** @brief 读取无符号 varint，值超出 32 位视为非法 */
+  bool readVarint(uint32_t& value);
+
+  /** @brief 读取 zig-zag 编码的有符号 varint */
+  bool readSignedVarint(int64_t& value);
+
+  /** @brief 读取 varint 长度前缀的字符串，value 指向源数据 */
+  bool readString(std::string_view& value);
+
+  /** @brief 读取 varint 长度前缀的字节串，value 指向源数据 */
+  bool readBytes(std::string_view& value) { return readString(value); }
+
+  /** @brief 原样读取 size 字节，value 指向源数据 */
+  bool readRaw(std::string_view& value, size_t size);
+
+  /** @brief 跳过 size 字节 */
+  bool skip(size_t size);
+
+  /** @brief 此前所有读取是否都成功 */
+  [[nodiscard]] bool ok() const { return !failed_; }
+
+  /** @brief 已读取的字节数 */
+  [[nodiscard]] size_t position() const { return pos_; }
+
+  /** @brief 剩余可读字节数 */
+  [[nodiscard]] size_t remaining() const { return size_ - pos_; }
+
+  /** @brief 是否已读到末尾 */
+  [[nodiscard]] bool atEnd() const { return pos_ == size_; }
+
+  /** @brief 定长数值的字节序 */
+  [[nodiscard]] utils::Endian order() const { return order_; }
+
+ private:
+  /** @brief 检查是否仍可读取 n 字节，不足时进入失败状态 */
+  bool require(size_t n) {
+    if (failed_ || n > size_ - pos_) {
+      failed_ = true;
+      return false;
+    }
+    return true;
+  }
+
+  const Byte* data_;
+  size_t size_;
+  size_t pos_{0};
+  utils::Endian order_;
+  bool failed_{false};
+};
+
+}  // namespace buffer
+}  // namespace pickup
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "pickup/buffer/ByteBuffer.h"
+#include "pickup/buffer/Varint.h"
+#include "pickup/utils/Endian.hpp"
+
+namespace pickup {
+namespace buffer {
+
+/**
+ * @brief 向 ByteBuffer 追加二进制字段的序列化器
+ *
+ * 定长数值按构造时指定的字节序写出（默认网络字节序/大端），变长整数使用 LEB128
+ * varint，有符号变长整数先做 zig-zag 映射；字符串/字节串以 varint 长度为前缀。
+ * 写入直接追加到目标 ByteBuffer 的末尾，不持有数据。
+ *
+ * 已知消息大小时先调用 reserve() 一次性预留空间，之后的写入不会再触发扩容：
+ * @code
+ * ByteBuffer out;
+ * BinaryWriter w(out);
+ * w.reserve(4 + BinaryWriter::stringSize(name));
+ * w.write<uint32_t>(id);
+ * w.writeString(name);
+ * @endcode
+ *
+ * @note 非线程安全；写入期间不要通过其它途径修改目标 ByteBuffer。
+ */
+class BinaryWriter {
+ public:
+  using Byte = ByteBuffer::Byte;
+
+  /**
+   * @brief 构造
+   * @param out   目标缓冲区，须比本对象存活更久
+   * @param order 定长数值的字节序
+   */
+  explicit BinaryWriter(ByteBuffer& out, utils::Endian order = utils::Endian::Big)
+      : out_(out), order_(order), start_(out.size()) {}
+
+  /** @brief 为后续写入预留 bytes 字节（在当前内容之后） */
+  void reserve(size_t bytes) { out_.reserve(out_.size() + bytes); }
+
+  /**
+   * @brief 写入定长数值
+   * @tparam T 整数或浮点类型（不含 bool）
+   */
+  template <typename T>
+  void write(T value) {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "T must be a non-bool arithmetic type");
+    value = utils::convert_endian(value, utils::system_endian(), order_);
+    std::memcpy(out_.appendWritable(sizeof(T)), &value, sizeof(T));
+  }
+
+  /** @brief 写入无符号 varint */
+  void writeVarint(uint64_t value);
+
+  /** @brief 写入 zig-zag 编码的有符号 varint */
+  void writeSignedVarint(int64_t value) { writeVarint(encodeZigZag(value)); }
+
+  /** @brief 写入 varint 长度前缀 + 字符串内容 */
+  void writeString(std::string_view value);
+
+  /** @brief 写入 varint 长度前缀 + 字节内容 */
+  void writeBytes(const Byte* data, size_t size);
+
+  /** @brief 原样写入字节（无长度前缀） */
+  void writeRaw(const Byte* data, size_t size) { out_.append(data, data + size); }
+
+  /** @brief 原样写入字符串内容（无长度前缀） */
+  void writeRaw(std::string_view value) { out_.append(value); }
+
+  /** @brief 自构造以来写入的字节数 */
+  [[nodiscard]] size_t bytesWritten() const { return out_.size() - start_; }
+
+  /** @brief 定长数值的字节序 */
+  [[nodiscard]] utils::Endian order() const { return order_; }
+
+  /** @brief writeString()/writeBytes() 写入 size 字节内容时的总编码长度 */
+  static constexpr size_t bytesSize(size_t size) noexcept { return varintSize(size) + size; }
+
+  /** @brief writeString() 写入 value 时的总编码长度 */
+  static constexpr size_t stringSize(std::string_view value) noexcept { return bytesSize(value.size()); }
+
+ private:
+  ByteBuffer& out_;
+  utils::Endian order_;
+  size_t start_;  ///<  构造时目标缓冲区的长度
+};
+
+}  // namespace buffer
+}  // namespace pickup
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string_view>
+#include <vector>
+
+#include "pickup/buffer/ByteBuffer.h"
+#include "pickup/buffer/ByteSlice.h"
+
+#if !defined(_WIN32)
+#include <sys/uio.h>
+#endif
+
+namespace pickup {
+namespace buffer {
+
+#if defined(_WIN32)
+/** @brief 与 POSIX iovec 布局一致的分散/聚集描述符 */
+struct IoVec {
+  void* iov_base;
+  size_t iov_len;
+};
+#else
+using IoVec = ::iovec;  ///<  可直接传给 writev/readv
+#endif
+
+/**
+ * @brief 由多个 ByteSlice 段组成的分散/聚集缓冲链
+ *
+ * 追加/前插只登记段的引用，不拷贝数据；cut()/drain() 在段边界处以 O(1) 切分段。
+ * 组装 "头 + 体 + 尾" 的消息时，各部分保持在原处，再通过 toIovec() 一次 writev
+ * 发出。读取侧可用 prepareRead()/commitRead() 配合 readv 直接读入新段。
+ *
+ * @code
+ * BufferChain msg;
+ * msg.append(ByteSlice(std::move(header)));
+ * msg.append(body);                         // body 为 ByteSlice，只增加引用计数
+ * std::vector<IoVec> iov = msg.toIovec();
+ * ::writev(fd, iov.data(), static_cast<int>(iov.size()));
+ * @endcode
+ *
+ * @note 非线程安全。
+ */
+class BufferChain {
+ public:
+  using Byte = ByteBuffer::Byte;
+  using const_iterator = std::deque<ByteSlice>::const_iterator;
+
+  BufferChain() = default;
+
+  /** @brief 以引用方式在尾部追加一段（空段忽略） */
+  void append(ByteSlice slice);
+
+  /** @brief 接管 ByteBuffer 并作为一段追加（零拷贝） */
+  void append(ByteBuffer&& buffer) { append(ByteSlice(std::move(buffer))); }
+
+  /** @brief 拷贝一段数据追加（适合小块，如分隔符、长度前缀） */
+  void append(std::string_view bytes) { append(ByteSlice::copyOf(bytes)); }
+
+  /** @brief 将另一条链的所有段移到本链尾部 */
+  void append(BufferChain&& other);
+
+  /** @brief 以引用方式在头部插入一段（空段忽略） */
+  void prepend(ByteSlice slice);
+
+  /** @brief 接管 ByteBuffer 并作为一段插入头部（零拷贝） */
+  void prepend(ByteBuffer&& buffer) { prepend(ByteSlice(std::move(buffer))); }
+
+  /**
+   * @brief 从头部切下 n 字节组成新链返回，本链随之前移
+   * @param n 字节数，超出总长时切下全部
+   * @note 跨段时仅拆分边界所在的那一段，不拷贝数据
+   */
+  BufferChain cut(size_t n);
+
+  /** @brief 丢弃头部 n 字节（超出总长时清空） */
+  void drain(size_t n);
+
+  /** @brief 清空所有段 */
+  void clear();
+
+  /** @brief 返回总字节数 */
+  [[nodiscard]] size_t size() const { return size_; }
+
+  /** @brief 检查是否为空 */
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+  /** @brief 返回段数 */
+  [[nodiscard]] size_t segmentCount() const { return segments_.size(); }
+
+  /** @brief 段迭代（每个元素为一个 ByteSlice） */
+  [[nodiscard]] const_iterator begin() const { return segments_.begin(); }
+  [[nodiscard]] const_iterator end() const { return segments_.end(); }
+
+  /**
+   * @brief 将各段导出为 iovec 数组，用于 writev
+   * @param iov      输出数组
+   * @param maxCount 数组容量（如 IOV_MAX）
+   * @return 实际填充的项数；段数超过 maxCount 时只导出前 maxCount 段
+   */
+  size_t toIovec(IoVec* iov, size_t maxCount) const;
+
+  /** @brief 将全部段导出为 iovec 数组 */
+  [[nodiscard]] std::vector<IoVec> toIovec() const;
+
+  /**
+   * @brief 为 readv 预留可写空间
+   * @param bytes     期望读取的最大字节数
+   * @param blockSize 每块的大小
+   * @return 覆盖预留空间的 iovec 数组；须随后调用 commitRead()
+   */
+  [[nodiscard]] std::vector<IoVec> prepareRead(size_t bytes, size_t blockSize = 16 * 1024);
+
+  /**
+   * @brief 提交 readv 实际读取的字节数，将已填充部分作为新段追加
+   * @param bytes readv 返回值（不超过 prepareRead 预留的总量）
+   */
+  void commitRead(size_t bytes);
+
+  /** @brief 拷贝全部内容为一个连续的 ByteBuffer */
+  [[nodiscard]] ByteBuffer flatten() const;
+
+ private:
+  std::deque<ByteSlice> segments_;
+  size_t size_{0};
+  std::vector<ByteBuffer> pendingReads_;  ///<  prepareRead 预留、尚未提交的块
+};
+
+}  // namespace buffer
+}  // namespace pickup
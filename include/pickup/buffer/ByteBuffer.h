@@ -8,17 +8,35 @@
 #include <string_view>
 #include <vector>
 
+#include "pickup/buffer/ByteBufferAllocator.h"
+
 namespace pickup {
 namespace buffer {
 
 /**
  * @brief 简单的字节缓冲区，std::vector<uint8_t> 的轻量级替代品
+ *
+ * 内部维护一个读偏移：shift() 只前移偏移量而不搬移数据，已消费的前缀在后续追加
+ * 需要空间时才被回收（仅当前缀不小于剩余数据时才 memmove 压缩，否则随扩容一并
+ * 丢弃），因此从缓冲区头部逐帧解析的总开销与数据量成线性关系。
+ *
+ * 需要多处共享只读数据时，可移交给 ByteSlice（零拷贝、引用计数）。
+ *
+ * 默认使用 malloc/free；也可在构造时指定 ByteBufferAllocator（如 ByteBufferPool、
+ * ByteBufferArena），分配器随移动一起转移，拷贝构造时沿用源对象的分配器。
  */
 class ByteBuffer {
  public:
   using Byte = uint8_t;  ///<  字节类型
 
   ByteBuffer();
+
+  /**
+   * @brief 构造使用指定分配器的空缓冲区
+   * @param allocator 分配器，nullptr 表示 malloc/free；须比本对象存活更久
+   */
+  explicit ByteBuffer(ByteBufferAllocator* allocator);
+
   ByteBuffer(ByteBuffer&& other) noexcept;
   ByteBuffer(const ByteBuffer& other);
   explicit ByteBuffer(const std::string& stringBufferToCopy);
@@ -36,7 +54,7 @@ class ByteBuffer {
   void clear();
 
   /** @brief 返回指向底层数据的指针 */
-  [[nodiscard]] Byte* data() const { return data_; }
+  [[nodiscard]] Byte* data() const { return data_ + offset_; }
 
   /** @brief 返回当前存储的字节数 */
   [[nodiscard]] size_t size() const { return size_; }
@@ -44,8 +62,11 @@ class ByteBuffer {
   /** @brief 检查缓冲区是否为空 */
   [[nodiscard]] bool empty() const { return size_ == 0; }
 
-  /** @brief 返回当前分配的容量 */
-  [[nodiscard]] size_t capacity() const { return capacity_; }
+  /** @brief 返回自当前数据起始位置起的可用容量（不含已 shift 掉的前缀） */
+  [[nodiscard]] size_t capacity() const { return capacity_ - offset_; }
+
+  /** @brief 返回所用的分配器（nullptr 表示 malloc/free） */
+  [[nodiscard]] ByteBufferAllocator* allocator() const { return allocator_; }
 
   /** @brief 返回指向第一个字节的指针 */
   [[nodiscard]] Byte* begin() const { return data(); }
@@ -57,7 +78,7 @@ class ByteBuffer {
   void reserve(size_t capacity);
 
   /** @brief 返回第 i 个字节的引用 */
-  Byte& operator[](size_t i) const { return data_[i]; }
+  Byte& operator[](size_t i) const { return data()[i]; }
 
   /**
    * @brief 追加 N 个字节并返回指向新增区域起始位置的可写指针
@@ -114,6 +135,7 @@ class ByteBuffer {
   /**
    * @brief 从缓冲区开头移除 N 个字节
    * @param size 要移除的字节数
+   * @note O(1)：仅前移读偏移，不搬移剩余数据
    */
   void shift(size_t size);
 
@@ -139,12 +161,24 @@ class ByteBuffer {
   [[nodiscard]] std::string_view toStringView() const;
 
  private:
-  /** @brief 重新分配内存到指定容量 */
+  /** @brief 重新分配内存到指定容量（仅保留有效数据，读偏移归零） */
   void reallocate(size_t capacity);
 
-  size_t size_{0};       ///<  当前存储的字节数
-  size_t capacity_{0};   ///<  分配的容量
-  Byte* data_{nullptr};  ///<  指向数据的指针
+  /** @brief 确保自当前起始位置起可容纳 needed 字节，必要时压缩前缀或扩容 */
+  void ensureRoom(size_t needed);
+
+  /** @brief 将有效数据移到分配区起始处，回收已 shift 的前缀 */
+  void compact();
+
+  /** @brief 通过分配器申请/归还分配区 */
+  [[nodiscard]] Byte* allocateBuffer(size_t size) const;
+  void deallocateBuffer(Byte* buffer, size_t size) const;
+
+  size_t size_{0};                           ///<  当前存储的字节数
+  size_t capacity_{0};                       ///<  分配的容量
+  size_t offset_{0};                         ///<  已 shift 掉的前缀长度（读偏移）
+  Byte* data_{nullptr};                      ///<  指向分配区起始的指针
+  ByteBufferAllocator* allocator_{nullptr};  ///<  分配器，nullptr 表示 malloc/free
 };
 
 }  // namespace buffer
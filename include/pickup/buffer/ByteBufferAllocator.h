@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+
+namespace pickup {
+namespace buffer {
+
+/**
+ * @brief ByteBuffer 的内存分配器接口
+ *
+ * ByteBuffer 扩容/收缩/析构时通过该接口申请与归还内存；未指定分配器时使用
+ * malloc/free。实现需保证分配器的生命周期长于由它分配的所有 ByteBuffer
+ * （包括由这些 ByteBuffer 移交出去的 ByteSlice）。
+ */
+class ByteBufferAllocator {
+ public:
+  virtual ~ByteBufferAllocator() = default;
+
+  /**
+   * @brief 分配 size 字节
+   * @param size 字节数（调用方保证已经过 goodSize() 调整，且大于 0）
+   * @return 内存起始地址，失败时返回 nullptr
+   */
+  virtual void* allocate(size_t size) = 0;
+
+  /**
+   * @brief 归还由 allocate() 分配的内存
+   * @param ptr  allocate() 返回的地址
+   * @param size 分配时传入的字节数
+   */
+  virtual void deallocate(void* ptr, size_t size) = 0;
+
+  /**
+   * @brief 将请求的大小调整为分配器实际会提供的大小
+   *
+   * ByteBuffer 以返回值作为容量，使按尺寸分级的分配器多给出的空间不被浪费。
+   */
+  [[nodiscard]] virtual size_t goodSize(size_t size) const { return size; }
+};
+
+}  // namespace buffer
+}  // namespace pickup
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "pickup/buffer/ByteBuffer.h"
+#include "pickup/buffer/ByteBufferAllocator.h"
+
+namespace pickup {
+namespace buffer {
+
+/**
+ * @brief 面向请求作用域的 bump 分配器
+ *
+ * 从成块申请的内存中顺序切分，deallocate() 不回收（仅当归还的恰好是最近一次分配
+ * 时回退指针），整体在 reset() 或析构时一次性释放。适合处理一个请求期间创建大量
+ * 短命 ByteBuffer 的场景：分配只是指针加法，结束时无需逐个释放。
+ *
+ * @code
+ * ByteBufferArena arena;
+ * ByteBuffer header = arena.acquire(64);
+ * ByteBuffer body = arena.acquire(4096);
+ * // ... 请求处理完毕，header/body 析构后
+ * arena.reset();
+ * @endcode
+ *
+ * @note 非线程安全；arena 须比由它分配的所有 ByteBuffer 存活更久，reset() 前这些
+ *       ByteBuffer 须已析构。
+ */
+class ByteBufferArena : public ByteBufferAllocator {
+ public:
+  static constexpr size_t kDefaultChunkSize = 64 * 1024;
+  static constexpr size_t kAlignment = alignof(std::max_align_t);
+
+  /**
+   * @brief 构造
+   * @param chunkSize 每次向系统申请的块大小；超过块大小一半的请求单独成块
+   */
+  explicit ByteBufferArena(size_t chunkSize = kDefaultChunkSize);
+
+  ~ByteBufferArena() override;
+
+  ByteBufferArena(const ByteBufferArena&) = delete;
+  ByteBufferArena& operator=(const ByteBufferArena&) = delete;
+
+  /**
+   * @brief 取得一个使用本 arena 分配的空 ByteBuffer
+   * @param capacity 预留容量，0 表示不预留
+   */
+  [[nodiscard]] ByteBuffer acquire(size_t capacity = 0);
+
+  void* allocate(size_t size) override;
+  void deallocate(void* ptr, size_t size) override;
+  [[nodiscard]] size_t goodSize(size_t size) const override;
+
+  /** @brief 释放全部分配，保留第一个常规块供下一轮复用 */
+  void reset();
+
+  /** @brief 当前已切分出去的字节数 */
+  [[nodiscard]] size_t bytesUsed() const { return used_; }
+
+  /** @brief 当前向系统申请的字节总数 */
+  [[nodiscard]] size_t bytesReserved() const { return reserved_; }
+
+ private:
+  struct Chunk {
+    char* data;
+    size_t size;
+  };
+
+  /** @brief 申请新的常规块并设为当前块 */
+  void newChunk();
+
+  size_t chunkSize_;
+  std::vector<Chunk> chunks_;  ///<  常规块，最后一个为当前块
+  std::vector<Chunk> large_;   ///<  单独成块的大分配
+  char* cursor_{nullptr};      ///<  当前块中下一次分配的位置
+  char* limit_{nullptr};       ///<  当前块末尾
+  size_t used_{0};
+  size_t reserved_{0};
+};
+
+}  // namespace buffer
+}  // namespace pickup
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "pickup/buffer/ByteBuffer.h"
+#include "pickup/buffer/ByteBufferAllocator.h"
+
+namespace pickup {
+namespace buffer {
+
+namespace detail {
+struct PoolStatsShards;  // 各线程的计数分片，定义在 ByteBufferPool.cpp
+}  // namespace detail
+
+/**
+ * @brief ByteBufferPool 配置
+ */
+struct ByteBufferPoolOptions {
+  size_t minBlockSize = 64;           ///< 最小尺寸级别（向上取 2 的幂）
+  size_t maxBlockSize = 1024 * 1024;  ///< 最大尺寸级别，更大的请求直接走 malloc/free
+  size_t maxCachedPerClass = 64;      ///< 每个线程每个尺寸级别最多缓存的块数
+};
+
+/**
+ * @brief ByteBufferPool 命中统计快照，由 ByteBufferPool::stats() 返回
+ */
+struct ByteBufferPoolStats {
+  uint64_t hits = 0;      ///< 分配时从线程缓存取得块的次数
+  uint64_t misses = 0;    ///< 分配时缓存为空（或超过最大级别）而调用 malloc 的次数
+  uint64_t recycled = 0;  ///< 归还时放回线程缓存的次数
+  uint64_t released = 0;  ///< 归还时缓存已满（或超过最大级别）而调用 free 的次数
+
+  /** @brief 命中率（0–1）；无分配时为 0 */
+  [[nodiscard]] double hitRate() const noexcept {
+    const uint64_t total = hits + misses;
+    return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+  }
+};
+
+/**
+ * @brief 按尺寸分级、线程本地缓存的 ByteBuffer 分配器
+ *
+ * 请求大小向上取到 2 的幂级别，归还的块按级别放入当前线程的空闲链表，同一线程
+ * 下次分配同级别时直接复用，不经过全局分配器、不加锁。块可在任意线程归还（进入
+ * 归还线程的缓存）；线程退出时其缓存的块被释放。
+ *
+ * @code
+ * ByteBufferPool& pool = ByteBufferPool::global();
+ * ByteBuffer buf = pool.acquire(512);   // 析构时块自动回到当前线程的缓存
+ * @endcode
+ *
+ * @note 池须比由它分配的所有 ByteBuffer 存活更久；其它线程中缓存的块在这些线程
+ *       退出时释放，因此短生命周期的池只宜在单线程内使用。
+ */
+class ByteBufferPool : public ByteBufferAllocator {
+ public:
+  ByteBufferPool();
+
+  /**
+   * @brief 构造
+   * @throw std::invalid_argument minBlockSize 为 0 或大于 maxBlockSize
+   */
+  explicit ByteBufferPool(const ByteBufferPoolOptions& options);
+
+  ~ByteBufferPool() override;
+
+  ByteBufferPool(const ByteBufferPool&) = delete;
+  ByteBufferPool& operator=(const ByteBufferPool&) = delete;
+
+  /** @brief 进程级默认池（不会析构） */
+  static ByteBufferPool& global();
+
+  /**
+   * @brief 取得一个使用本池分配的空 ByteBuffer
+   * @param capacity 预留容量，0 表示不预留
+   */
+  [[nodiscard]] ByteBuffer acquire(size_t capacity = 0);
+
+  void* allocate(size_t size) override;
+  void deallocate(void* ptr, size_t size) override;
+  [[nodiscard]] size_t goodSize(size_t size) const override;
+
+  /** @brief 释放当前线程为本池缓存的全部块 */
+  void trimThreadCache();
+
+  /**
+   * @brief 命中统计快照
+   *
+   * 计数按线程分片累加，快路径不与其它线程争用同一缓存行；这里汇总所有分片，
+   * 其它线程正在进行的分配/归还可能尚未计入。
+   */
+  [[nodiscard]] ByteBufferPoolStats stats() const;
+
+  /** @brief 清零命中统计（记录当前汇总值作为基线） */
+  void resetStats();
+
+  /** @brief 尺寸级别数 */
+  [[nodiscard]] size_t classCount() const { return classCount_; }
+
+ private:
+  /** @brief 块大小对应的级别下标；超过最大级别时返回 classCount_ */
+  [[nodiscard]] size_t classOf(size_t size) const;
+
+  const uint64_t id_;  ///<  全局唯一标识，作为线程缓存的键
+  size_t minShift_;    ///<  最小级别的 log2
+  size_t classCount_;  ///<  级别数
+  size_t maxCachedPerClass_;
+
+  std::shared_ptr<detail::PoolStatsShards> shards_;  ///<  线程缓存也持有，线程退出时把分片还回来
+};
+
+}  // namespace buffer
+}  // namespace pickup
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "pickup/buffer/ByteBuffer.h"
+
+namespace pickup {
+namespace buffer {
+
+/**
+ * @brief 引用计数的只读字节视图
+ *
+ * 由 ByteBuffer 移交构造（接管其内存，不拷贝数据），多个 ByteSlice 共享同一块底层
+ * 存储，最后一个引用释放时存储随之释放。slice()/popFront() 等切片操作为 O(1)，只
+ * 调整指针与长度。适合把解析出的帧/字段交给其它模块或线程而无需拷贝。
+ *
+ * @code
+ * ByteSlice whole(std::move(buffer));      // 零拷贝接管
+ * ByteSlice header = whole.popFront(16);   // 前 16 字节，whole 随之前移
+ * ByteSlice body = whole.slice(0, len);    // 共享同一存储
+ * @endcode
+ *
+ * @note 底层数据不可变，引用计数线程安全；单个 ByteSlice 对象本身非线程安全。
+ */
+class ByteSlice {
+ public:
+  using Byte = ByteBuffer::Byte;
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  /** @brief 构造空视图 */
+  ByteSlice() = default;
+
+  /**
+   * @brief 接管 ByteBuffer 的数据（零拷贝）
+   * @param buffer 源缓冲区，调用后为空
+   */
+  explicit ByteSlice(ByteBuffer&& buffer);
+
+  /**
+   * @brief 拷贝一段数据构造视图
+   * @param bytes 要拷贝的数据
+   */
+  static ByteSlice copyOf(std::string_view bytes);
+
+  /** @brief 返回指向首字节的指针 */
+  [[nodiscard]] const Byte* data() const { return data_; }
+
+  /** @brief 返回视图长度 */
+  [[nodiscard]] size_t size() const { return size_; }
+
+  /** @brief 检查视图是否为空 */
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+  /** @brief 返回指向第一个字节的指针 */
+  [[nodiscard]] const Byte* begin() const { return data_; }
+
+  /** @brief 返回指向最后一个字节之后的指针 */
+  [[nodiscard]] const Byte* end() const { return data_ + size_; }
+
+  /** @brief 返回第 i 个字节 */
+  const Byte& operator[](size_t i) const { return data_[i]; }
+
+  /**
+   * @brief 取子视图（O(1)，共享存储）
+   * @param offset 起始偏移，超出长度时返回空视图
+   * @param length 长度，超出剩余部分时截断到末尾
+   */
+  [[nodiscard]] ByteSlice slice(size_t offset, size_t length = npos) const;
+
+  /**
+   * @brief 切下前 n 个字节作为新视图返回，本视图前移 n 字节
+   * @param n 字节数，超出长度时取全部
+   */
+  ByteSlice popFront(size_t n);
+
+  /** @brief 从开头移除 n 个字节（超出长度时变为空） */
+  void removePrefix(size_t n);
+
+  /** @brief 从末尾移除 n 个字节（超出长度时变为空） */
+  void removeSuffix(size_t n);
+
+  /** @brief 返回内容的字符串视图（零拷贝） */
+  [[nodiscard]] std::string_view toStringView() const {
+    return std::string_view(reinterpret_cast<const char*>(data_), size_);
+  }
+
+  /** @brief 拷贝出一个独立的 ByteBuffer */
+  [[nodiscard]] ByteBuffer toByteBuffer() const { return ByteBuffer(data_, data_ + size_); }
+
+  /** @brief 共享同一存储的 ByteSlice 数量（空视图返回 0） */
+  [[nodiscard]] long useCount() const { return owner_.use_count(); }
+
+  bool operator==(const ByteSlice& other) const { return toStringView() == other.toStringView(); }
+  bool operator!=(const ByteSlice& other) const { return !(*this == other); }
+
+ private:
+  ByteSlice(std::shared_ptr<const ByteBuffer> owner, const Byte* data, size_t size)
+      : owner_(std::move(owner)), data_(data), size_(size) {}
+
+  std::shared_ptr<const ByteBuffer> owner_;  ///<  底层存储
+  const Byte* data_{nullptr};                ///<  视图起始
+  size_t size_{0};                           ///<  视图长度
+};
+
+}  // namespace buffer
+}  // namespace pickup
@@ -2,6 +2,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <span>
+
+#include "pickup/buffer/MirroredMemory.h"
 
 namespace pickup {
 namespace buffer {
@@ -11,7 +14,21 @@ namespace buffer {
  *
  * 最多可存储比分配空间少 1 字节的数据，因为缓冲区满时
  * 起始和结束标记必须相隔 1 字节，否则无法区分满/空状态。
- * 本类非线程安全。
+ * 空间不足时 write() 拒绝写入；需要新数据覆盖旧数据（轨迹/飞行记录）请用 TraceBuffer。
+ * 本类非线程安全；单生产者单消费者跨线程使用请改用 SPSCByteRing。
+ *
+ * 在 Linux 上可用 allocateMirrored() 分配双重映射的存储（见 MirroredMemory）：
+ * 此时读写都是一次 memcpy，peek()/prepareWrite() 总能返回全部可读/可写区域，
+ * 便于原地解析跨越回绕点的消息，或一次 recv() 直接收进缓冲区：
+ * @code
+ * CircularBuffer ring;
+ * ring.allocateMirrored(64 * 1024);
+ * auto room = ring.prepareWrite();
+ * ssize_t n = ::recv(fd, room.data(), room.size(), 0);
+ * if (n > 0) ring.commitWrite(n);
+ * auto bytes = ring.peek();              // 可能跨越回绕点，但地址连续
+ * ring.consume(parser.parse(bytes));
+ * @endcode
  */
 class CircularBuffer {
  public:
@@ -32,6 +49,13 @@ class CircularBuffer {
    */
   bool allocate(size_t buffer_size);
 
+  /**
+   * @brief 分配双重映射的环形缓冲区，不支持时回退为 allocate()
+   * @param buffer_size 要分配的字节数（双重映射时向上取整到页大小）
+   * @return 分配失败返回 false；是否实际使用了双重映射见 mirrored()
+   */
+  bool allocateMirrored(size_t buffer_size);
+
   /**
    * @brief 释放环形缓冲区（仅在需要重新分配时才须显式调用）
    */
@@ -49,6 +73,12 @@ class CircularBuffer {
    */
   [[nodiscard]] size_t used() const;
 
+  /** @brief 返回分配的字节数 */
+  [[nodiscard]] size_t size() const { return size_; }
+
+  /** @brief 是否使用双重映射存储 */
+  [[nodiscard]] bool mirrored() const { return mirror_.data() != nullptr; }
+
   /**
    * @brief 将数据写入环形缓冲区
    * @param buf     源数据指针
@@ -65,11 +95,43 @@ class CircularBuffer {
    */
   size_t read(uint8_t* buf, size_t max_buf_len);
 
+  /**
+   * @brief 查看可读数据而不取出
+   * @return 从读位置开始的连续只读区域：双重映射时为全部可读数据，否则只到回绕点为止
+   */
+  [[nodiscard]] std::span<const uint8_t> peek() const;
+
+  /**
+   * @brief 释放前 n 字节可读数据
+   * @param n 字节数，超过 used() 时按 used() 处理
+   */
+  void consume(size_t n);
+
+  /**
+   * @brief 取得可写区域
+   * @return 从写位置开始的连续可写区域：双重映射时为全部剩余空间，否则只到回绕点为止
+   * @note 写入后须调用 commitWrite() 使数据可读
+   */
+  [[nodiscard]] std::span<uint8_t> prepareWrite();
+
+  /**
+   * @brief 提交 prepareWrite() 区域中已写入的前 n 字节
+   * @param n 字节数，不得超过 prepareWrite() 返回的长度
+   */
+  void commitWrite(size_t n);
+
  private:
+  /** @brief 位置前移 n 字节并回绕 */
+  [[nodiscard]] size_t advance(size_t pos, size_t n) const {
+    pos += n;
+    return pos >= size_ ? pos - size_ : pos;
+  }
+
   size_t size_{0};
   uint8_t* buffer_{nullptr};
   size_t start_{0};
   size_t end_{0};
+  MirroredMemory mirror_;  ///<  双重映射存储，未使用时为空
 };
 
 }  // namespace buffer
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "pickup/buffer/ByteBuffer.h"
+
+namespace pickup {
+namespace buffer {
+
+/**
+ * @brief 内存映射文件
+ *
+ * 两种打开方式：
+ *   - openRead()：只读映射整个文件，以 string_view / 字节 span 直接访问文件内容，
+ *     省去 ifstream 读入再拷贝到 ByteBuffer/std::string 的两次拷贝；
+ *   - openAppend()：可写映射，append() 在映射区末尾追加，空间不足时按倍数扩展
+ *     文件并重新映射；close() 时把文件截断到实际写入的长度。
+ *
+ * @code
+ * MappedFile file;
+ * if (file.openRead(path)) {
+ *   file.advise(MappedFile::Advice::Sequential);
+ *   BinaryReader reader(file.view());
+ * }
+ * @endcode
+ *
+ * 非 POSIX 平台上 openRead() 退化为把文件读入内部 ByteBuffer，openAppend() 不可用。
+ *
+ * @note 非线程安全。append() 可能重新映射，之前取得的指针/视图随之失效。只读映射
+ *       期间若文件被其它进程截断，访问越过新文件末尾的页会触发 SIGBUS。
+ */
+class MappedFile {
+ public:
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  /** @brief madvise 访问模式提示 */
+  enum class Advice {
+    Normal,      ///< 默认预读
+    Sequential,  ///< 顺序访问：加大预读、读过的页可尽早回收
+    Random,      ///< 随机访问：关闭预读
+    WillNeed,    ///< 即将访问：异步预读入页缓存
+    DontNeed,    ///< 暂不访问：允许回收
+  };
+
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+   * @brief 只读映射文件
+   * @param path 文件路径
+   * @return 成功返回 true；文件不存在或映射失败返回 false
+   */
+  bool openRead(const std::string& path);
+
+  /**
+   * @brief 以追加方式打开（不存在则创建）并映射文件
+   * @param path            文件路径
+   * @param initialCapacity 初始映射容量（不小于现有文件长度）
+   * @return 成功返回 true
+   */
+  bool openAppend(const std::string& path, size_t initialCapacity = 64 * 1024);
+
+  /** @brief 解除映射并关闭文件；追加模式下先把文件截断到实际长度 */
+  void close();
+
+  /** @brief 是否已打开 */
+  [[nodiscard]] bool isOpen() const { return open_; }
+
+  /** @brief 是否为追加模式 */
+  [[nodiscard]] bool writable() const { return writable_; }
+
+  /** @brief 文件内容起始地址（空文件为 nullptr） */
+  [[nodiscard]] const uint8_t* data() const { return data_; }
+
+  /** @brief 文件内容长度（追加模式下为已写入的长度） */
+  [[nodiscard]] size_t size() const { return size_; }
+
+  /** @brief 检查内容是否为空 */
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+  /** @brief 当前映射容量（追加模式下可能大于 size()） */
+  [[nodiscard]] size_t capacity() const { return capacity_; }
+
+  /** @brief 以字符串视图访问内容（零拷贝） */
+  [[nodiscard]] std::string_view view() const {
+    return std::string_view(reinterpret_cast<const char*>(data_), size_);
+  }
+
+  /** @brief 以字节 span 访问内容（零拷贝） */
+  [[nodiscard]] std::span<const uint8_t> bytes() const { return {data_, size_}; }
+
+  /** @brief 拷贝内容为 ByteBuffer */
+  [[nodiscard]] ByteBuffer toByteBuffer() const { return ByteBuffer(data_, data_ + size_); }
+
+  /**
+   * @brief 对映射区（或其中一段）给出访问模式提示
+   * @param advice 提示类型
+   * @param offset 起始偏移（向下对齐到页）
+   * @param length 长度，npos 表示到末尾
+   * @return 成功返回 true；未映射或平台不支持返回 false
+   */
+  bool advise(Advice advice, size_t offset = 0, size_t length = npos);
+
+  /**
+   * @brief 追加数据（仅追加模式）
+   * @return 成功返回 true；非追加模式或扩展文件失败返回 false
+   */
+  bool append(const void* data, size_t len);
+
+  /** @brief 追加字符串（仅追加模式） */
+  bool append(std::string_view text) { return append(text.data(), text.size()); }
+
+  /**
+   * @brief 将已写入的内容刷到磁盘（仅追加模式）
+   * @param async true 时只发起写回不等待完成
+   */
+  bool sync(bool async = false);
+
+ private:
+  /** @brief 将文件扩展到至少 needed 字节并重新映射 */
+  bool grow(size_t needed);
+
+  /** @brief 解除映射并复位状态，不关闭文件 */
+  void unmap();
+
+  int fd_{-1};  ///<  仅追加模式保持打开；只读映射建立后即关闭
+  uint8_t* data_{nullptr};
+  size_t size_{0};
+  size_t capacity_{0};
+  bool open_{false};
+  bool writable_{false};
+  ByteBuffer fallback_;  ///<  不支持 mmap 时持有文件内容
+};
+
+}  // namespace buffer
+}  // namespace pickup
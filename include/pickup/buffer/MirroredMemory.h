@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pickup {
+namespace buffer {
+
+/**
+ * @brief 同一块物理内存在虚拟地址空间中连续映射两次的区域（"magic ring"）
+ *
+ * data()[i] 与 data()[i + size()] 是同一个字节，因此从任意偏移开始、长度不超过
+ * size() 的区域在地址上总是连续的，环形缓冲区无需在回绕处拆分拷贝。
+ *
+ * 仅在 Linux 上通过 memfd_create + 两次 MAP_FIXED 映射实现；其它平台或内核不支持
+ * memfd_create 时 allocate() 返回 false，调用方应回退到普通内存。
+ */
+class MirroredMemory {
+ public:
+  MirroredMemory() = default;
+  ~MirroredMemory();
+
+  MirroredMemory(const MirroredMemory&) = delete;
+  MirroredMemory& operator=(const MirroredMemory&) = delete;
+
+  /**
+   * @brief 分配并建立双重映射
+   * @param size 单份映射的字节数，向上取整到页大小
+   * @return 成功返回 true；不支持或系统调用失败返回 false
+   */
+  bool allocate(size_t size);
+
+  /** @brief 解除映射 */
+  void release();
+
+  /** @brief 映射起始地址（长度为 2 * size()） */
+  [[nodiscard]] uint8_t* data() const { return data_; }
+
+  /** @brief 单份映射的字节数 */
+  [[nodiscard]] size_t size() const { return size_; }
+
+  /** @brief 当前平台是否可能支持双重映射 */
+  [[nodiscard]] static bool supported();
+
+  /** @brief 系统页大小 */
+  [[nodiscard]] static size_t pageSize();
+
+ private:
+  uint8_t* data_{nullptr};
+  size_t size_{0};
+};
+
+}  // namespace buffer
+}  // namespace pickup
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace pickup {
+namespace buffer {
+
+/**
+ * @brief 无锁单生产者单消费者（SPSC）字节环形缓冲区
+ *
+ * CircularBuffer 的线程安全变体：恰好一个线程写入（如串口/套接字收包线程），
+ * 恰好一个线程读取（如协议解析线程）。读写位置为自由递增的计数器，分别由各自
+ * 一方写入并放在不同缓存行上；容量向上取 2 的幂，以掩码代替回绕分支，并且全部
+ * 容量可用（不像 CircularBuffer 需要空出 1 字节区分满/空）。
+ *
+ * 除拷贝式的 write()/read() 外，消费者可用 peek() 取得至多两段连续的只读区域直接
+ * 解析，再用 consume() 释放；生产者可用 prepareWrite() 取得可写区域（如交给 readv），
+ * 再用 commitWrite() 发布。
+ *
+ * @code
+ * SPSCByteRing ring(64 * 1024);
+ *
+ * // 生产者线程
+ * ring.write(packet, len);
+ *
+ * // 消费者线程
+ * auto spans = ring.peek();
+ * size_t n = parser.feed(spans.first) + parser.feed(spans.second);
+ * ring.consume(n);
+ * @endcode
+ *
+ * 线程安全：
+ *   - 仅有唯一线程可调用 write / prepareWrite / commitWrite（生产者）
+ *   - 仅有唯一线程可调用 read / peek / consume（消费者）
+ *   - used() / available() / capacity() 可从任意线程调用（结果为近似值）
+ */
+class SPSCByteRing {
+ public:
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  /** @brief 至多两段连续的只读区域，按先后顺序排列 */
+  struct ReadSpans {
+    std::span<const uint8_t> first;
+    std::span<const uint8_t> second;
+
+    [[nodiscard]] size_t size() const { return first.size() + second.size(); }
+    [[nodiscard]] bool empty() const { return first.empty(); }
+  };
+
+  /** @brief 至多两段连续的可写区域，按先后顺序排列 */
+  struct WriteSpans {
+    std::span<uint8_t> first;
+    std::span<uint8_t> second;
+
+    [[nodiscard]] size_t size() const { return first.size() + second.size(); }
+    [[nodiscard]] bool empty() const { return first.empty(); }
+  };
+
+  /**
+   * @brief 构造
+   * @param capacity 容量（至少为 1，会向上对齐到 2 的幂）
+   */
+  explicit SPSCByteRing(size_t capacity);
+
+  ~SPSCByteRing();
+
+  SPSCByteRing(const SPSCByteRing&) = delete;
+  SPSCByteRing& operator=(const SPSCByteRing&) = delete;
+
+  /** @brief 返回容量 */
+  [[nodiscard]] size_t capacity() const { return capacity_; }
+
+  /** @brief 返回已写入未读取的字节数（近似值） */
+  [[nodiscard]] size_t used() const;
+
+  /** @brief 返回可写入的字节数（近似值） */
+  [[nodiscard]] size_t available() const { return capacity_ - used(); }
+
+  /** @brief 检查是否为空（近似值） */
+  [[nodiscard]] bool empty() const { return used() == 0; }
+
+  /**
+   * @brief 写入数据（全部写入或不写）
+   * @param buf     源数据指针
+   * @param buf_len 要写入的字节数
+   * @return 空间足够并成功写入返回 true，否则返回 false
+   * @note 仅生产者线程调用
+   */
+  bool write(const uint8_t* buf, size_t buf_len);
+
+  /**
+   * @brief 取得可写区域
+   * @param max_len 最多需要的字节数
+   * @return 至多两段可写区域，总长不超过 max_len 与剩余空间
+   * @note 仅生产者线程调用；写入后须调用 commitWrite() 发布
+   */
+  [[nodiscard]] WriteSpans prepareWrite(size_t max_len = npos);
+
+  /**
+   * @brief 发布 prepareWrite() 区域中已写入的前 n 字节
+   * @note 仅生产者线程调用；n 不得超过 prepareWrite() 返回的总长
+   */
+  void commitWrite(size_t n);
+
+  /**
+   * @brief 读取数据
+   * @param buf         目标缓冲区指针
+   * @param max_buf_len 最多读取的字节数
+   * @return 实际读取的字节数，缓冲区为空时返回 0
+   * @note 仅消费者线程调用
+   */
+  size_t read(uint8_t* buf, size_t max_buf_len);
+
+  /**
+   * @brief 查看可读数据而不取出
+   * @param max_len 最多查看的字节数
+   * @return 至多两段只读区域；调用 consume() 前内容保持有效
+   * @note 仅消费者线程调用
+   */
+  [[nodiscard]] ReadSpans peek(size_t max_len = npos);
+
+  /**
+   * @brief 释放前 n 字节可读数据
+   * @note 仅消费者线程调用；n 不得超过当前可读字节数
+   */
+  void consume(size_t n);
+
+ private:
+  /** @brief 生产者视角的剩余空间，必要时刷新缓存的读位置 */
+  size_t writableFrom(size_t head, size_t needed);
+
+  /** @brief 消费者视角的可读数据量，必要时刷新缓存的写位置 */
+  size_t readableFrom(size_t tail, size_t needed);
+
+  size_t index(size_t pos) const { return pos & mask_; }
+
+  const size_t capacity_;
+  const size_t mask_;
+  uint8_t* const buffer_;
+
+  // head 与 tail 分离到不同缓存行，避免 false sharing
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};  ///< 写位置，由生产者写入
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};  ///< 读位置，由消费者写入
+
+  // 缓存的对方位置，减少原子加载
+  alignas(CACHE_LINE_SIZE) size_t cachedTail_{0};  ///< 由生产者缓存
+  alignas(CACHE_LINE_SIZE) size_t cachedHead_{0};  ///< 由消费者缓存
+};
+
+}  // namespace buffer
+}  // namespace pickup
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "pickup/buffer/ByteBuffer.h"
+#include "pickup/buffer/ByteSlice.h"
+
+namespace pickup {
+namespace buffer {
+
+/**
+ * @brief 新数据覆盖旧数据的环形缓冲区，用作常开的内存轨迹/飞行记录器
+ *
+ * 与 CircularBuffer 在空间不足时拒绝写入相反，本类总是接受新数据并丢弃最旧的内容：
+ *   - Mode::Bytes   按字节覆盖，只保留最近 capacity() 字节；
+ *   - Mode::Records 以长度前缀保存记录，空间不足时整条淘汰最旧的记录，读出时
+ *                   不会得到被截断的半条记录。
+ *
+ * 写入方只有一个线程；snapshot()/snapshotRecords() 可由任意线程随时调用，无需让写入
+ * 方停下：读方先拷贝整个区域，再根据写入方预先公布的覆盖范围剔除拷贝期间可能被
+ * 改写的部分（与 seqlock 相同的校验思路），因此快照总是自洽的，只是可能比调用
+ * 时刻略少。
+ *
+ * @code
+ * TraceBuffer trace(1 << 20, TraceBuffer::Mode::Records);
+ * trace.writeRecord(line.data(), line.size());   // 热路径：一次 memcpy
+ *
+ * for (const ByteSlice& rec : trace.snapshotRecords()) {   // 任意线程
+ *   std::cerr << rec.toStringView() << '\n';
+ * }
+ * @endcode
+ *
+ * @note 写入接口仅允许单一线程调用。
+ */
+class TraceBuffer {
+ public:
+  /** @brief 覆盖方式 */
+  enum class Mode {
+    Bytes,    ///< 按字节覆盖最旧数据
+    Records,  ///< 按整条记录淘汰最旧数据
+  };
+
+  /** @brief Records 模式下每条记录的长度前缀字节数 */
+  static constexpr size_t kRecordHeaderSize = sizeof(uint32_t);
+
+  /**
+   * @brief 构造
+   * @param capacity 容量（至少为 16，会向上对齐到 2 的幂）
+   * @param mode     覆盖方式
+   */
+  explicit TraceBuffer(size_t capacity, Mode mode = Mode::Bytes);
+
+  ~TraceBuffer();
+
+  TraceBuffer(const TraceBuffer&) = delete;
+  TraceBuffer& operator=(const TraceBuffer&) = delete;
+
+  /** @brief 返回容量 */
+  [[nodiscard]] size_t capacity() const { return capacity_; }
+
+  /** @brief 返回覆盖方式 */
+  [[nodiscard]] Mode mode() const { return mode_; }
+
+  /**
+   * @brief 追加字节（Mode::Bytes）
+   * @param data 数据
+   * @param len  长度；超过容量时只保留最后 capacity() 字节
+   * @note 仅写入线程调用；Records 模式下调用会触发断言，release 构建中不写入
+   */
+  void write(const uint8_t* data, size_t len);
+
+  /**
+   * @brief 追加一条记录（Mode::Records）
+   * @param data 记录内容
+   * @param len  记录长度
+   * @return 记录加上长度前缀超过容量时返回 false（不写入），否则返回 true
+   * @note 仅写入线程调用；Bytes 模式下调用会触发断言，release 构建中返回 false
+   */
+  bool writeRecord(const void* data, size_t len);
+
+  /**
+   * @brief 当前内容的快照，从旧到新排列
+   *
+   * Bytes 模式下为最近写入的字节；Records 模式下为各条记录按
+   * "长度前缀 + 内容" 依次排列的原始格式。
+   */
+  [[nodiscard]] ByteBuffer snapshot() const;
+
+  /**
+   * @brief 当前记录的快照，从旧到新排列（Mode::Records）
+   * @return 每条记录一个 ByteSlice，共享同一块快照存储
+   */
+  [[nodiscard]] std::vector<ByteSlice> snapshotRecords() const;
+
+  /** @brief 累计写入的字节数（Records 模式含长度前缀） */
+  [[nodiscard]] uint64_t totalWritten() const { return committed_.load(std::memory_order_acquire); }
+
+  /** @brief 累计被覆盖丢弃的字节数（Records 模式含长度前缀） */
+  [[nodiscard]] uint64_t droppedBytes() const { return oldest_.load(std::memory_order_relaxed); }
+
+  /** @brief 累计被淘汰的记录数（Mode::Records） */
+  [[nodiscard]] uint64_t droppedRecords() const { return droppedRecords_.load(std::memory_order_relaxed); }
+
+ private:
+  /** @brief 将 [data, data+len) 拷贝到逻辑位置 pos 处（可能跨越回绕点） */
+  void copyIn(uint64_t pos, const void* data, size_t len);
+
+  /** @brief 从逻辑位置 pos 处拷贝 len 字节到 out（可能跨越回绕点） */
+  void copyOut(uint64_t pos, void* out, size_t len) const;
+
+  /** @brief 先推进最旧有效位置，再写入 [committed, end) 的数据，最后推进 committed_ */
+  void publish(uint64_t end, uint64_t oldest, const void* header, size_t headerLen, const void* data, size_t len);
+
+  /** @brief 拷贝 [最旧有效位置, 已写完位置) 的一致快照 */
+  [[nodiscard]] ByteBuffer copyConsistent() const;
+
+  const size_t capacity_;
+  const size_t mask_;
+  const Mode mode_;
+  uint8_t* const buffer_;
+
+  std::atomic<uint64_t> committed_{0};  ///<  已写完的逻辑结束位置
+  std::atomic<uint64_t> oldest_{0};     ///<  最旧有效数据的逻辑位置（Records 模式为记录边界）
+  std::atomic<uint64_t> droppedRecords_{0};
+};
+
+}  // namespace buffer
+}  // namespace pickup
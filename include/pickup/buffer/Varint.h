@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pickup {
+namespace buffer {
+
+/** @brief 64 位 varint 编码的最大字节数 */
+constexpr size_t kMaxVarintBytes = 10;
+
+/**
+ * @brief zig-zag 编码：将有符号数映射为无符号数，使绝对值小的负数也只占少量 varint 字节
+ *
+ * 0 → 0，-1 → 1，1 → 2，-2 → 3，…
+ */
+constexpr uint64_t encodeZigZag(int64_t value) noexcept {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+/** @brief zig-zag 解码，encodeZigZag 的逆运算 */
+constexpr int64_t decodeZigZag(uint64_t value) noexcept {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/** @brief 返回 value 的 varint 编码字节数（1–10） */
+constexpr size_t varintSize(uint64_t value) noexcept {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++size;
+  }
+  return size;
+}
+
+/**
+ * @brief 将 value 按 LEB128 varint 编码写入 out
+ * @param out 输出位置，须至少有 kMaxVarintBytes 字节可写
+ * @return 写入的字节数
+ */
+inline size_t encodeVarint(uint64_t value, uint8_t* out) noexcept {
+  size_t n = 0;
+  while (value >= 0x80) {
+    out[n++] = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  out[n++] = static_cast<uint8_t>(value);
+  return n;
+}
+
+}  // namespace buffer
+}  // namespace pickup
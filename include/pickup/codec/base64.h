@@ -1,11 +1,83 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 
+/**
+ * Base64 编解码
+ *
+ * 运行时按 utils::simdLevel() 选择 AVX-512 VBMI / AVX2 / SSSE3 向量实现，
+ * 其余情况及尾部不足一个向量块的数据由查表的标量实现处理，各路径输出完全一致。
+ */
 namespace pickup {
+namespace buffer {
+class ByteBuffer;
+}  // namespace buffer
+
 namespace codec {
 namespace base64 {
 
+/**
+ * @brief Base64 变体（RFC 4648）
+ */
+enum class Variant : uint8_t {
+  Standard,       ///< 标准字母表（+ /），以 '=' 填充
+  StandardNoPad,  ///< 标准字母表，不填充
+  UrlSafe,        ///< URL 安全字母表（- _），以 '=' 填充
+  UrlSafeNoPad,   ///< URL 安全字母表，不填充（JWT 等使用）
+};
+
+/**
+ * @brief 编码 len 字节所需的输出长度（含 '=' 填充）
+ */
+[[nodiscard]] constexpr size_t encodedLength(size_t len) { return (len + 2) / 3 * 4; }
+
+/**
+ * @brief 按指定变体编码 len 字节所需的输出长度
+ */
+[[nodiscard]] constexpr size_t encodedLength(size_t len, Variant variant) {
+  if (variant == Variant::Standard || variant == Variant::UrlSafe) {
+    return encodedLength(len);
+  }
+  return len / 3 * 4 + (len % 3 == 0 ? 0 : len % 3 + 1);
+}
+
+/**
+ * @brief 解码 len 个字符最多产生的字节数，可用于预分配输出缓冲区
+ */
+[[nodiscard]] constexpr size_t maxDecodedLength(size_t len) { return (len + 3) / 4 * 3; }
+
+/**
+ * @brief 编码到调用方提供的缓冲区
+ * @param input 输入数据指针
+ * @param len   输入数据的字节长度
+ * @param out   输出缓冲区，至少 encodedLength(len) 字节；不写入结尾 '\0'
+ * @return 写入的字符数，恒等于 encodedLength(len)
+ */
+size_t encode(const uint8_t* input, size_t len, char* out);
+
+/**
+ * @brief 按指定变体编码到调用方提供的缓冲区
+ * @param input   输入数据指针
+ * @param len     输入数据的字节长度
+ * @param out     输出缓冲区，至少 encodedLength(len, variant) 字节
+ * @param variant 字母表与填充方式
+ * @return 写入的字符数
+ */
+size_t encode(const uint8_t* input, size_t len, char* out, Variant variant);
+
+/**
+ * @brief 按指定变体编码，单次遍历直接输出目标字母表，无中间字符串
+ * @param input   输入数据
+ * @param variant 字母表与填充方式
+ * @return Base64 编码字符串
+ */
+[[nodiscard]] std::string encode(std::string_view input, Variant variant);
+
 /**
  * @brief 将原始字节串编码为 Base64 字符串
  * @param input 输入数据指针
@@ -30,10 +102,63 @@ namespace base64 {
  */
 [[nodiscard]] std::string decode(std::string const& input);
 
+/**
+ * @brief 解码到调用方提供的缓冲区
+ *
+ * 与 decode(std::string) 语义一致：遇到 '=' 或第一个非法字符即停止，末尾不足
+ * 4 个字符的组按已有字符解出尽可能多的字节。
+ * @param input Base64 字符指针
+ * @param len   字符数
+ * @param out   输出缓冲区，至少 maxDecodedLength(len) 字节
+ * @return 写入的字节数
+ */
+size_t decode(const char* input, size_t len, uint8_t* out);
+
+/**
+ * @brief 按指定变体的字母表宽松解码（语义同 decode(std::string)，'=' 可有可无）
+ * @param input   Base64 字符串
+ * @param variant 字母表
+ * @return 解码后的原始字节串
+ */
+[[nodiscard]] std::string decode(std::string_view input, Variant variant);
+
+/**
+ * @brief 严格解码的结果
+ */
+struct DecodeStatus {
+  bool ok;             ///< 输入是否完全合法
+  size_t written;      ///< 写入的字节数（失败时为出错位置之前的完整组解出的字节数）
+  size_t errorOffset;  ///< 第一个非法字符的偏移；输入被截断时为输入长度；成功时等于输入长度
+};
+
+/**
+ * @brief 严格解码到调用方提供的缓冲区
+ *
+ * 除字母表外的字符（含空白）、位置不对的 '='、带填充变体缺少填充、不填充变体出现
+ * '=' 或末组只有 1 个字符，均视为错误。
+ * @param input   Base64 字符指针
+ * @param len     字符数
+ * @param out     输出缓冲区，至少 maxDecodedLength(len) 字节
+ * @param variant 字母表与填充方式
+ * @return 解码结果，包含写入字节数及出错偏移
+ */
+[[nodiscard]] DecodeStatus decodeStrict(const char* input, size_t len, uint8_t* out, Variant variant);
+
+/**
+ * @brief 严格解码
+ * @param input       Base64 字符串
+ * @param variant     字母表与填充方式
+ * @param errorOffset 非空时写入第一个非法字符的偏移（成功时为输入长度）
+ * @return 解码后的原始字节串，输入不合法时返回 std::nullopt
+ */
+[[nodiscard]] std::optional<std::string> decodeStrict(std::string_view input, Variant variant = Variant::Standard,
+                                                      size_t* errorOffset = nullptr);
+
 /**
  * @brief 将 URL 安全 Base64 字符串转换为标准 Base64 字符串
  * @param input URL 安全 Base64 编码字符串（使用 - 和 _ 代替 + 和 /）
  * @return 标准 Base64 编码字符串
+ * @note 若最终目的是解码，直接使用 decode(input, Variant::UrlSafe) 可省去转换
  */
 [[nodiscard]] std::string fromUrlSafe(const std::string& input);
 
@@ -41,9 +166,128 @@ namespace base64 {
  * @brief 将标准 Base64 字符串转换为 URL 安全 Base64 字符串
  * @param input 标准 Base64 编码字符串
  * @return URL 安全 Base64 编码字符串（使用 - 和 _ 代替 + 和 /）
+ * @note 从原始数据编码时，直接使用 encode(input, Variant::UrlSafeNoPad) 可省去转换
  */
 [[nodiscard]] std::string toUrlSafe(const std::string& input);
 
+/**
+ * @brief 流式 Base64 编码器
+ *
+ * 输入可按任意大小分块送入，不足 3 字节的尾部留在内部待下一块补齐，
+ * 因此内存占用与总长无关。所有块送完后调用 finish() 输出最后一组及填充。
+ * 逐块输出拼接后与一次性 encode() 的结果完全相同。
+ *
+ * @code
+ * base64::Encoder enc;
+ * ByteBuffer out;
+ * while (auto chunk = socket.read()) {
+ *   enc.update(chunk, out);
+ * }
+ * enc.finish(out);
+ * @endcode
+ */
+class Encoder {
+ public:
+  /** @param variant 字母表与填充方式 */
+  explicit Encoder(Variant variant = Variant::Standard) : variant_(variant) {}
+
+  /** @brief update() 处理 len 字节时最多写出的字符数 */
+  [[nodiscard]] static constexpr size_t maxOutputLength(size_t len) { return (len + 2) / 3 * 4; }
+
+  /** @brief finish() 最多写出的字符数 */
+  static constexpr size_t kMaxFinishLength = 4;
+
+  /**
+   * @brief 编码一块输入
+   * @param input 输入数据
+   * @param out   输出区，至少 maxOutputLength(input.size()) 字节，否则抛出 std::length_error
+   * @return 写入的字符数
+   */
+  size_t update(std::span<const uint8_t> input, std::span<char> out);
+
+  /** @brief 编码一块输入，结果追加到 out */
+  void update(std::span<const uint8_t> input, buffer::ByteBuffer& out);
+
+  /**
+   * @brief 输出剩余的不足 3 字节（及变体要求的 '=' 填充），并复位以便编码下一段数据
+   * @param out 输出区，至少 kMaxFinishLength 字节，否则抛出 std::length_error
+   * @return 写入的字符数
+   */
+  size_t finish(std::span<char> out);
+
+  /** @brief 输出剩余部分并追加到 out，随后复位 */
+  void finish(buffer::ByteBuffer& out);
+
+  /** @brief 丢弃内部暂存的数据 */
+  void reset() { pendingSize_ = 0; }
+
+  /** @brief 暂存、尚未输出的字节数（0~2） */
+  [[nodiscard]] size_t pending() const { return pendingSize_; }
+
+ private:
+  Variant variant_;
+  uint8_t pending_[2]{};  ///<  上一块末尾不足一组的字节
+  size_t pendingSize_{0};
+};
+
+/**
+ * @brief 流式 Base64 解码器
+ *
+ * 输入可按任意大小分块送入，不足 4 个字符的尾部留在内部待下一块补齐。
+ * 与 decode() 语义一致：遇到 '=' 或非法字符即停止，之后的输入全部忽略
+ * （stopped() 返回 true）；finish() 输出最后不完整的一组。
+ */
+class Decoder {
+ public:
+  /** @param variant 字母表（填充方式不影响解码） */
+  explicit Decoder(Variant variant = Variant::Standard) : variant_(variant) {}
+
+  /** @brief update() 处理 len 个字符时最多写出的字节数 */
+  [[nodiscard]] static constexpr size_t maxOutputLength(size_t len) { return (len + 3) / 4 * 3; }
+
+  /** @brief finish() 最多写出的字节数 */
+  static constexpr size_t kMaxFinishLength = 2;
+
+  /**
+   * @brief 解码一块输入
+   * @param input Base64 字符
+   * @param out   输出区，至少 maxOutputLength(input.size()) 字节，否则抛出 std::length_error
+   * @return 写入的字节数
+   */
+  size_t update(std::span<const char> input, std::span<uint8_t> out);
+
+  /** @brief 解码一块输入，结果追加到 out */
+  void update(std::span<const char> input, buffer::ByteBuffer& out);
+
+  /**
+   * @brief 输出最后不完整的一组，并复位以便解码下一段数据
+   * @param out 输出区，至少 kMaxFinishLength 字节，否则抛出 std::length_error
+   * @return 写入的字节数
+   */
+  size_t finish(std::span<uint8_t> out);
+
+  /** @brief 输出最后不完整的一组并追加到 out，随后复位 */
+  void finish(buffer::ByteBuffer& out);
+
+  /** @brief 丢弃暂存数据并清除停止状态 */
+  void reset() {
+    pendingSize_ = 0;
+    stopped_ = false;
+  }
+
+  /** @brief 是否已遇到 '=' 或非法字符 */
+  [[nodiscard]] bool stopped() const { return stopped_; }
+
+  /** @brief 暂存、尚未输出的有效字符数（0~3） */
+  [[nodiscard]] size_t pending() const { return pendingSize_; }
+
+ private:
+  Variant variant_;
+  uint8_t pending_[3]{};  ///<  上一块末尾不足一组的字符对应的 6 位值
+  size_t pendingSize_{0};
+  bool stopped_{false};
+};
+
 }  // namespace base64
 }  // namespace codec
 }  // namespace pickup
@@ -2,13 +2,27 @@
 
 #include <cstdint>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
+/**
+ * 十六进制编解码
+ *
+ * 运行时按 utils::simdLevel() 选择 AVX2 / SSSE3 向量实现，其余情况及尾部数据由
+ * 查表的标量实现处理。
+ */
 namespace pickup {
 namespace codec {
 namespace hex {
 
+/** @brief 编码 len 字节所需的字符数 */
+[[nodiscard]] constexpr size_t encodedLength(size_t len) { return len * 2; }
+
+/** @brief 解码 len 个字符最多产生的字节数 */
+[[nodiscard]] constexpr size_t maxDecodedLength(size_t len) { return len / 2; }
+
 /**
  * @brief 将二进制数据编码为十六进制字符串
  * @param data      要转换的二进制数据
@@ -28,6 +42,15 @@ namespace hex {
   return encode(data.data(), data.size(), uppercase);
 }
 
+/**
+ * @brief 编码到调用方提供的缓冲区
+ * @param data      要转换的二进制数据
+ * @param out       输出区，至少 encodedLength(data.size()) 字节，否则抛出 std::length_error
+ * @param uppercase 是否使用大写字母（A-F），默认为 true
+ * @return 写入的字符数
+ */
+size_t encode(std::span<const uint8_t> data, std::span<char> out, bool uppercase = true);
+
 /**
  * @brief 将整数编码为定宽十六进制字符串
  * @param value     要转换的值
@@ -69,6 +92,14 @@ namespace hex {
  */
 [[nodiscard]] std::optional<std::vector<uint8_t>> decode(const std::string& input);
 
+/**
+ * @brief 解码到调用方提供的缓冲区，不分配内存
+ * @param input 要解码的十六进制字符串（大小写均可）
+ * @param out   输出区，至少 maxDecodedLength(input.size()) 字节，否则抛出 std::length_error
+ * @return 写入的字节数，输入无效时返回 std::nullopt（out 内容未定义）
+ */
+[[nodiscard]] std::optional<size_t> decode(std::string_view input, std::span<uint8_t> out);
+
 /**
  * @brief 将带分隔符的十六进制字符串解码为二进制数据
  * @param input     要解码的十六进制字符串
@@ -78,6 +109,19 @@ namespace hex {
 [[nodiscard]] std::optional<std::vector<uint8_t>> decodeWithSeparator(const std::string& input,
                                                                        char separator = ' ');
 
+/**
+ * @brief 将带分隔符的十六进制字符串解码到调用方提供的缓冲区，不分配内存
+ *
+ * 规整的 "HH<sep>HH<sep>..." 格式按固定步长直接解码；分隔符出现在其他位置时
+ * 逐字符跳过，结果与先删除全部分隔符再解码相同。
+ * @param input     要解码的十六进制字符串
+ * @param out       输出区，至少 maxDecodedLength(input.size()) 字节，否则抛出 std::length_error
+ * @param separator 字节间分隔符，默认为空格
+ * @return 写入的字节数，输入无效时返回 std::nullopt
+ */
+[[nodiscard]] std::optional<size_t> decodeWithSeparator(std::string_view input, std::span<uint8_t> out,
+                                                        char separator = ' ');
+
 }  // namespace hex
 }  // namespace codec
 }  // namespace pickup
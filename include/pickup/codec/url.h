@@ -1,25 +1,196 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 
+/**
+ * URL 百分号编解码（RFC 3986）
+ *
+ * 字符分类全部查表完成，与 locale 无关；无需转义的连续字符段由 SSSE3/AVX2 批量
+ * 扫描后整段拷贝。
+ */
 namespace pickup {
 namespace codec {
 namespace url {
 
+/**
+ * @brief 编码时要保留的字符集合（按 URL 组成部分区分）
+ */
+enum class Component : uint8_t {
+  Unreserved,  ///< 只保留 unreserved（ALPHA DIGIT - . _ ~），其余全部转义
+  Path,        ///< 路径：另外保留 sub-delims 以及 ':' '@' '/'
+  Query,       ///< 查询串的键或值：另外保留 sub-delims（'&' '=' '+' 除外）以及 ':' '@' '/' '?'
+  Form,        ///< application/x-www-form-urlencoded：同 Unreserved，但空格编码为 '+'，解码时 '+' 还原为空格
+};
+
+/**
+ * @brief 解码结果
+ */
+struct DecodeStatus {
+  bool ok;             ///< 是否全部为合法转义
+  size_t written;      ///< 写入的字节数（失败时为出错位置之前解出的字节数）
+  size_t errorOffset;  ///< 第一个非法转义序列 '%' 的偏移；成功时等于输入长度
+};
+
 /**
  * @brief 将字符串进行 URL 编码
  * @param input 输入字符串
  * @return URL 编码后的字符串
+ * @note 等价于 encode(input, Component::Form)
  */
 [[nodiscard]] std::string encode(const std::string& input);
 
+/**
+ * @brief 按组成部分的字符集合编码
+ * @param input     输入字符串
+ * @param component 保留字符集合
+ * @return URL 编码后的字符串（按精确长度一次分配）
+ */
+[[nodiscard]] std::string encode(std::string_view input, Component component);
+
+/**
+ * @brief 编码到调用方提供的缓冲区
+ * @param input     输入字符串
+ * @param out       输出区，至少 encodedLength(input, component) 字节，否则抛出 std::length_error
+ * @param component 保留字符集合
+ * @return 写入的字节数
+ */
+size_t encode(std::string_view input, std::span<char> out, Component component);
+
+/**
+ * @brief 计算编码后的精确长度
+ */
+[[nodiscard]] size_t encodedLength(std::string_view input, Component component);
+
 /**
  * @brief 将 URL 编码的字符串解码
  * @param input URL 编码的输入字符串
  * @return 解码后的字符串
+ * @note 容错解码：非法的十六进制字符按 0 处理，不完整的转义序列输出 '?' 并结束。
+ *       需要发现错误时使用 decodeStrict()。
  */
 [[nodiscard]] std::string decode(const std::string& input);
 
+/**
+ * @brief 解码到调用方提供的缓冲区
+ *
+ * out 可以与 input 指向同一块内存（原地解码）：写入位置永远不会超过读取位置。
+ * @param input     URL 编码的输入
+ * @param out       输出区，至少 input.size() 字节，否则抛出 std::length_error
+ * @param component 为 Component::Form 时 '+' 解码为空格，否则原样保留
+ * @return 解码结果；遇到非法或不完整的转义序列时停止并报告其偏移
+ */
+[[nodiscard]] DecodeStatus decode(std::string_view input, std::span<char> out, Component component);
+
+/**
+ * @brief 严格解码
+ * @param input       URL 编码的输入
+ * @param component   为 Component::Form 时 '+' 解码为空格
+ * @param errorOffset 非空时写入第一个非法转义序列的偏移（成功时为输入长度）
+ * @return 解码后的字符串，存在非法转义时返回 std::nullopt
+ */
+[[nodiscard]] std::optional<std::string> decodeStrict(std::string_view input, Component component = Component::Form,
+                                                      size_t* errorOffset = nullptr);
+
+/**
+ * @brief 原地解码，不分配内存
+ * @param inout       输入，成功时替换为解码结果；失败时内容未定义
+ * @param component   为 Component::Form 时 '+' 解码为空格
+ * @param errorOffset 非空时写入第一个非法转义序列的偏移
+ * @return 是否全部为合法转义
+ */
+bool decodeInPlace(std::string& inout, Component component = Component::Form, size_t* errorOffset = nullptr);
+
+/**
+ * @brief 查询串中的一个键值对，均指向原始输入且保持编码状态
+ */
+struct QueryParam {
+  std::string_view key;    ///< 键（未解码）
+  std::string_view value;  ///< 值（未解码）；没有 '=' 时为空
+};
+
+/**
+ * @brief 零分配的查询串解析器
+ *
+ * 按 '&' 切分、按第一个 '=' 区分键值，迭代时直接产出指向原始输入的 string_view，
+ * 不拷贝也不解码；空段（如 "a=1&&b=2" 中间）被跳过。需要解码时对单个键或值调用
+ * decodeStrict(..., Component::Form)。
+ *
+ * @code
+ * for (const auto& [key, value] : url::QueryString("?a=1&b=x%20y")) {
+ *   ...
+ * }
+ * @endcode
+ *
+ * @note 只保存输入的视图，原始字符串须比解析器及其迭代器存活更久。
+ */
+class QueryString {
+ public:
+  /** @brief 键值对的前向迭代器 */
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = QueryParam;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const QueryParam*;
+    using reference = const QueryParam&;
+
+    Iterator() = default;
+
+    reference operator*() const { return current_; }
+    pointer operator->() const { return &current_; }
+
+    Iterator& operator++() {
+      advance();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator old = *this;
+      advance();
+      return old;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return atEnd_ == other.atEnd_ && (atEnd_ || current_.key.data() == other.current_.key.data());
+    }
+
+   private:
+    friend class QueryString;
+
+    explicit Iterator(std::string_view rest) : rest_(rest), atEnd_(false) { advance(); }
+
+    /** @brief 取出下一个非空段 */
+    void advance();
+
+    std::string_view rest_;  ///<  尚未解析的部分
+    QueryParam current_;
+    bool atEnd_{true};
+  };
+
+  /**
+   * @param query 查询串，可带开头的 '?'；'#' 之后的片段被忽略
+   */
+  explicit QueryString(std::string_view query);
+
+  [[nodiscard]] Iterator begin() const { return Iterator(query_); }
+  [[nodiscard]] Iterator end() const { return Iterator(); }
+
+  /**
+   * @brief 查找第一个键（按原始编码形式比较）等于 key 的参数
+   * @return 未解码的值，不存在时返回 std::nullopt
+   */
+  [[nodiscard]] std::optional<std::string_view> find(std::string_view key) const;
+
+ private:
+  std::string_view query_;
+};
+
 }  // namespace url
 }  // namespace codec
 }  // namespace pickup
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "pickup/config/INIReader.h"
+#include "pickup/thread/Thread.h"
+#include "pickup/utils/Observer.h"
+
+namespace pickup {
+namespace config {
+
+/**
+ * @brief 监视单个文件的变化，在后台线程回调
+ *
+ * Linux 上监视文件所在目录的 inotify 事件（编辑器/部署工具常以"写临时文件再 rename"
+ * 的方式替换文件，直接监视文件的 inode 会丢失后续变化）；收到与文件名匹配的事件后，
+ * 等待 settle 时间内不再有新事件再回调一次，合并同一次保存产生的多个事件。
+ * 其它平台退化为按 settle 间隔轮询文件修改时间。
+ *
+ * 监视目录被删除或移走、poll 出错时监视线程自行退出，running() 随之变为 false；
+ * 可再次调用 start() 重新建立监视。
+ *
+ * @note 回调在监视线程中执行；stop() 会等待正在执行的回调返回。
+ */
+class FileWatcher {
+ public:
+  using Callback = std::function<void()>;
+
+  FileWatcher() = default;
+  ~FileWatcher();
+
+  FileWatcher(const FileWatcher&) = delete;
+  FileWatcher& operator=(const FileWatcher&) = delete;
+
+  /**
+   * @brief 开始监视
+   * @param path     被监视的文件路径（文件可以暂不存在，但所在目录必须存在）
+   * @param onChange 文件变化时的回调
+   * @param settle   事件合并的静默时间
+   * @return 成功返回 true；已在运行或无法建立监视返回 false。监视线程已自行退出时
+   *         先回收该线程再重新开始
+   */
+  bool start(const std::string& path, Callback onChange,
+             std::chrono::milliseconds settle = std::chrono::milliseconds(50));
+
+  /** @brief 停止监视并等待监视线程退出 */
+  void stop();
+
+  /** @brief 是否正在监视；监视线程因监视失效而退出后返回 false */
+  [[nodiscard]] bool running() const noexcept { return active_.load(std::memory_order_acquire); }
+
+ private:
+  void run();
+
+  std::string path_;
+  Callback onChange_;
+  std::chrono::milliseconds settle_{50};
+  std::atomic<bool> stopping_{false};
+  std::atomic<bool> active_{false};  ///< 监视线程运行中，线程退出前清除
+  int notifyFd_ = -1;  ///< inotify 描述符
+  int wakeFd_ = -1;    ///< 用于 stop() 唤醒监视线程的 eventfd
+  std::mutex mutex_;   ///< 轮询模式下配合 wakeup_ 实现可中断的等待
+  std::condition_variable wakeup_;
+  thread::Thread thread_;
+};
+
+/**
+ * @brief 配置热加载：文件变化时在后台线程重新解析，并发布不可变快照
+ *
+ * 每次成功加载得到一份新的 `std::shared_ptr<const Config>`，通过原子 shared_ptr 整体
+ * 替换；读者拿到的始终是某一次完整加载的结果，旧快照在最后一个持有者释放后销毁
+ * （RCU 式替换）。加载失败时保留旧快照，只累加 failedReloads()。
+ *
+ * 热路径上建议每个线程持有一个 Reader：它缓存快照并记住代数，每次访问只做一次
+ * generation() 原子读取，代数未变时不触碰 shared_ptr 引用计数、不加锁。
+ *
+ * 成功加载后以 ChangeArg 通知已注册的 utils::Observer（在监视线程或调用 reload()
+ * 的线程中执行）。
+ *
+ * @tparam Config 配置类型。默认加载器对 INIReader 直接按路径构造并检查 error()，
+ *         对其它类型（如 ProtoBufConfig 派生类）默认构造后调用 loadFromFile(path)。
+ *
+ * @code
+ * ConfigWatcher<> watcher("/etc/app/server.ini");
+ * watcher.start();
+ *
+ * thread_local ConfigWatcher<>::Reader config(watcher);
+ * int port = config->get<int>("server", "port", 8080);
+ * @endcode
+ */
+template <typename Config = INIReader>
+class ConfigWatcher : public utils::Observable {
+ public:
+  using Snapshot = std::shared_ptr<const Config>;
+  /** @brief 加载函数：失败返回 nullptr */
+  using Loader = std::function<Snapshot(const std::string& path)>;
+
+  /** @brief 通知参数 */
+  struct ChangeArg : utils::ObserverArg {
+    Snapshot config;      ///< 新快照
+    uint64_t generation;  ///< 新快照的代数
+  };
+
+  class Reader;
+
+  explicit ConfigWatcher(std::string path, Loader loader = &ConfigWatcher::loadDefault)
+      : path_(std::move(path)), loader_(std::move(loader)) {}
+
+  ~ConfigWatcher() override { stop(); }
+
+  ConfigWatcher(const ConfigWatcher&) = delete;
+  ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+  /**
+   * @brief 开始监视文件，然后同步加载一次
+   *
+   * 先建立监视再加载，加载期间发生的修改也会触发 reload()，不会遗漏。
+   *
+   * @return 监视已建立且初次加载成功返回 true。失败时可用 watching() 与 snapshot()
+   *         区分原因：初次加载失败时仍在监视，文件修复后自动加载；无法建立监视时
+   *         仍会尝试加载一次
+   */
+  bool start(std::chrono::milliseconds settle = std::chrono::milliseconds(50)) {
+    const bool watching = watcher_.start(path_, [this] { reload(); }, settle);
+    const bool loaded = reload();
+    return watching && loaded;
+  }
+
+  /** @brief 停止监视；已发布的快照继续有效 */
+  void stop() { watcher_.stop(); }
+
+  /**
+   * @brief 立即重新加载
+   * @return 成功（并已发布、通知）返回 true
+   */
+  bool reload() {
+    std::lock_guard<std::mutex> lock(reloadMutex_);
+    Snapshot next = loader_(path_);
+    if (!next) {
+      failedReloads_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    snapshot_.store(next, std::memory_order_release);
+    ChangeArg arg;
+    arg.config = std::move(next);
+    arg.generation = generation_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    setChanged();
+    notifyObservers(&arg);
+    return true;
+  }
+
+  /** @brief 当前快照；尚未成功加载过时为 nullptr */
+  [[nodiscard]] Snapshot snapshot() const noexcept { return snapshot_.load(std::memory_order_acquire); }
+
+  /** @brief 成功加载的次数，每次发布新快照后递增 */
+  [[nodiscard]] uint64_t generation() const noexcept { return generation_.load(std::memory_order_acquire); }
+
+  /** @brief 加载失败的次数 */
+  [[nodiscard]] uint64_t failedReloads() const noexcept {
+    return failedReloads_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] const std::string& path() const noexcept { return path_; }
+
+  /** @brief 是否正在监视；监视目录被删除或移走后返回 false，可重新 start() */
+  [[nodiscard]] bool watching() const noexcept { return watcher_.running(); }
+
+  /** @brief 默认加载器 */
+  static Snapshot loadDefault(const std::string& path) {
+    if constexpr (std::is_same_v<Config, INIReader>) {
+      auto reader = std::make_shared<INIReader>(path);
+      if (reader->error()) return nullptr;
+      return reader;
+    } else {
+      auto config = std::make_shared<Config>();
+      if (!config->loadFromFile(path)) return nullptr;
+      return config;
+    }
+  }
+
+ private:
+  std::string path_;
+  Loader loader_;
+  std::atomic<Snapshot> snapshot_;
+  std::atomic<uint64_t> generation_{0};
+  std::atomic<uint64_t> failedReloads_{0};
+  std::mutex reloadMutex_;  ///< 串行化 reload()，保证代数与快照一一对应
+  FileWatcher watcher_;
+};
+
+/**
+ * @brief 线程局部的快照缓存
+ *
+ * 访问时比较 watcher 的代数，变化时才重新取快照。单个 Reader 非线程安全，
+ * 应每个线程一个；生命周期不得超过所引用的 ConfigWatcher。
+ */
+template <typename Config>
+class ConfigWatcher<Config>::Reader {
+ public:
+  explicit Reader(const ConfigWatcher& watcher) : watcher_(&watcher) {}
+
+  /** @brief 最新快照；尚未成功加载过时返回 nullptr */
+  const Config* get() {
+    const uint64_t generation = watcher_->generation();
+    if (generation != generation_ || !snapshot_) {
+      snapshot_ = watcher_->snapshot();
+      generation_ = generation;
+    }
+    return snapshot_.get();
+  }
+
+  const Config* operator->() { return get(); }
+  const Config& operator*() { return *get(); }
+
+  /** @brief 持有当前快照，可跨线程传递 */
+  [[nodiscard]] Snapshot snapshot() {
+    get();
+    return snapshot_;
+  }
+
+ private:
+  const ConfigWatcher* watcher_;
+  Snapshot snapshot_;
+  uint64_t generation_ = 0;
+};
+
+}  // namespace config
+}  // namespace pickup
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace pickup {
+namespace config {
+
+/**
+ * @brief 单遍、SAX 风格的 INI 解析器
+ *
+ * 直接在调用方给出的缓冲区上用指针扫描，每行只做视图切分，不分配内存；
+ * 解析到的 section、键值对通过 Handler 回调逐个交出，调用方可以边解析边消费，
+ * 无需先建立完整的表。语法与 INIReader 相同（INIReader 即基于本解析器实现）：
+ *   - `[section]` 开始新的 section，文件开头的键属于名为 "" 的 section；
+ *   - `name = value` 或 `name : value`，两端空白被去掉；
+ *   - 以 `;` 或 `#` 开头的行是注释，值中"空白 + ;"之后为行内注释；
+ *   - 以空白开头的行是上一个键的续行；
+ *   - 支持 UTF-8 BOM 与 CRLF 行尾。
+ *
+ * 回调中的视图指向输入缓冲区，仅在缓冲区存活期间有效。
+ *
+ * @code
+ * struct Counter : INIParser::Handler {
+ *   size_t routes = 0;
+ *   bool onValue(std::string_view section, std::string_view, std::string_view, int) override {
+ *     routes += section == "routes";
+ *     return true;
+ *   }
+ * } counter;
+ * auto error = INIParser::parseFile("routes.ini", counter);
+ * @endcode
+ */
+class INIParser {
+ public:
+  struct ParseError {
+    enum class Kind { FileOpen, Syntax };
+    Kind kind;
+    int line = 0;
+  };
+
+  /**
+   * @brief 解析事件的接收者
+   *
+   * 各回调返回 false 时立即停止解析。line 从 1 开始。
+   */
+  class Handler {
+   public:
+    virtual ~Handler() = default;
+
+    /** @brief 遇到 section 头 */
+    virtual bool onSection(std::string_view /*section*/, int /*line*/) { return true; }
+
+    /** @brief 遇到键值对；同一个键重复出现时每次都会回调 */
+    virtual bool onValue(std::string_view section, std::string_view name, std::string_view value, int line) = 0;
+
+    /** @brief 遇到续行，name 为其所属的键 */
+    virtual bool onContinuation(std::string_view /*section*/, std::string_view /*name*/,
+                                std::string_view /*value*/, int /*line*/) {
+      return true;
+    }
+
+    /** @brief 遇到无法识别的行；默认跳过并继续 */
+    virtual bool onError(int /*line*/) { return true; }
+  };
+
+  /** @brief 只关心键值对时使用的回调，返回 false 停止解析 */
+  using ValueCallback = std::function<bool(std::string_view section, std::string_view name, std::string_view value)>;
+
+  /**
+   * @brief 解析内存中的文本
+   * @return 第一个语法错误；无错误返回 std::nullopt
+   */
+  static std::optional<ParseError> parse(std::string_view text, Handler& handler);
+
+  /** @brief 同上，续行被忽略 */
+  static std::optional<ParseError> parse(std::string_view text, const ValueCallback& onValue);
+
+  /**
+   * @brief 内存映射文件后解析
+   *
+   * @note 映射只在本次调用期间存在；解析期间文件被截断可能触发 SIGBUS，
+   *       需要长期持有解析结果时请使用 INIReader（它持有文件内容的副本）。
+   */
+  static std::optional<ParseError> parseFile(const std::string& path, Handler& handler);
+};
+
+}  // namespace config
+}  // namespace pickup
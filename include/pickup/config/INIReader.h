@@ -1,20 +1,47 @@
 #pragma once
 
-#include <map>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iosfwd>
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "pickup/config/INIParser.h"
+#include "pickup/time/Timespan.h"
+#include "pickup/utils/LexicalCast.hpp"
 
 namespace pickup {
 namespace config {
 
+/**
+ * @brief INI 文件读取器
+ *
+ * 解析时把整个文件读入一份自有文本，条目以 string_view 指向该文本；每个 section
+ * 一张大小写不敏感的哈希表。查找接口接受 std::string_view，不构造临时 key、
+ * 不分配内存。解析结果不可变，拷贝 INIReader 只共享同一份数据。
+ *
+ * 条目只保存原始文本，首次按类型读取时才转换；每个条目缓存第一次转换的结果，
+ * 对同一键反复调用同一种 getInteger()、get<T>() 等不再重复解析字符串。
+ * 缓存可被多个线程并发填充与读取。
+ *
+ * @code
+ * INIReader reader("server.ini");
+ * int port = reader.get<int>("server", "port", 8080);
+ * auto timeout = reader.get<time::Timespan>("server", "timeout");   // "250ms"
+ * auto hosts = reader.getList<std::string_view>("server", "hosts");  // "a, b, c"
+ * @endcode
+ */
 class INIReader {
  public:
-  struct ParseError {
-    enum class Kind { FileOpen, Syntax };
-    Kind kind;
-    int line = 0;
-  };
+  using ParseError = INIParser::ParseError;
 
   INIReader() = default;
   explicit INIReader(const std::string& filename);
@@ -26,34 +53,205 @@ class INIReader {
 
   bool hasSection(const std::string& section) const { return sections_.count(section) > 0; }
 
-  bool hasValue(const std::string& section, const std::string& name) const;
+  bool hasValue(std::string_view section, std::string_view name) const noexcept;
+
+  /**
+   * @brief 查找原始值，不分配内存
+   * @return 返回的视图在本对象（及其拷贝）存活期间有效；不存在返回 std::nullopt
+   */
+  [[nodiscard]] std::optional<std::string_view> find(std::string_view section,
+                                                     std::string_view name) const noexcept;
+
+  /** @brief 同 find()，不存在时返回 default_value */
+  [[nodiscard]] std::string_view getView(std::string_view section, std::string_view name,
+                                         std::string_view default_value) const noexcept;
+
+  std::string get(std::string_view section, std::string_view name,
+                  std::string_view default_value) const;
+
+  long getInteger(std::string_view section, std::string_view name, long default_value) const;
 
-  std::string get(const std::string& section, const std::string& name,
-                  const std::string& default_value) const;
+  double getReal(std::string_view section, std::string_view name, double default_value) const;
 
-  long getInteger(const std::string& section, const std::string& name,
-                  long default_value) const;
+  float getFloat(std::string_view section, std::string_view name, float default_value) const;
 
-  double getReal(const std::string& section, const std::string& name,
-                 double default_value) const;
+  bool getBoolean(std::string_view section, std::string_view name, bool default_value) const;
 
-  float getFloat(const std::string& section, const std::string& name,
-                 float default_value) const;
+  /**
+   * @brief 依次访问所有键值对，顺序不确定
+   *
+   * section 与 name 为文件中首次出现时的写法；重复键与续行已拼接。
+   */
+  void forEach(const std::function<void(std::string_view section, std::string_view name, std::string_view value)>&
+                   visitor) const;
 
-  bool getBoolean(const std::string& section, const std::string& name,
-                  bool default_value) const;
+  /**
+   * @brief 按类型读取值
+   *
+   * 支持 bool、整数、float、double、std::string、std::string_view 与 time::Timespan。
+   * 整数与浮点按 utils::lexicalCast 的规则要求整串匹配（不接受 getInteger() 的
+   * 0x 前缀与尾随字符）；bool 接受 true/yes/on/1 与 false/no/off/0；
+   * Timespan 见 parseDuration()。
+   *
+   * @return 不存在、格式错误或超出 T 的范围时返回 std::nullopt
+   */
+  template <typename T>
+  [[nodiscard]] std::optional<T> get(std::string_view section, std::string_view name) const;
+
+  /** @brief 同 get<T>(section, name)，失败时返回 default_value */
+  template <typename T>
+  [[nodiscard]] T get(std::string_view section, std::string_view name,
+                      const std::type_identity_t<T>& default_value) const {
+    return get<T>(section, name).value_or(default_value);
+  }
+
+  /**
+   * @brief 按列表读取值
+   *
+   * 以逗号或换行（续行）分隔，元素两端空白被去掉，空元素被跳过；元素类型同 get<T>()。
+   *
+   * @return 不存在或任一元素转换失败时返回 std::nullopt
+   */
+  template <typename T>
+  [[nodiscard]] std::optional<std::vector<T>> getList(std::string_view section, std::string_view name) const;
+
+  /** @brief 解析布尔值：true/yes/on/1、false/no/off/0（大小写不敏感） */
+  static std::optional<bool> parseBoolean(std::string_view text) noexcept;
+
+  /**
+   * @brief 解析时长，如 "100ms"、"1.5s"、"1h30m"
+   *
+   * 由一个或多个"数值+单位"组成，可带前导负号，数值与单位之间可有空白。
+   * 单位：ns、us、ms、s、m/min、h、d。单独的 "0" 表示零时长，其余数值必须带单位。
+   */
+  static std::optional<time::Timespan> parseDuration(std::string_view text) noexcept;
 
  private:
+  /**
+   * @brief 条目的原始文本与一个类型转换结果的缓存槽
+   *
+   * 槽只由第一次类型读取填充（state 从 Empty 经 Busy 变为该类型的标记），之后
+   * 其他类型的读取照常解析但不再缓存；state 以 acquire/release 发布 ok 与 bits。
+   */
+  struct Value {
+    enum class Kind : uint8_t {
+      IntegerPrefix,  ///< getInteger()：前缀匹配，0x/0 自动进制
+      RealPrefix,     ///< getReal()：前缀匹配
+      FloatPrefix,    ///< getFloat()：前缀匹配
+      Boolean,        ///< parseBoolean()
+      Integer,        ///< get<整数>()：lexicalCast<int64_t> 整串匹配
+      Real,           ///< get<double>()
+      Float,          ///< get<float>()
+      Duration,       ///< parseDuration()
+    };
+
+    std::string_view text;
+    mutable std::atomic<uint8_t> state{0};  ///< 0 空，1 正在写，2 + Kind 已缓存
+    mutable bool ok = false;                ///< 转换是否成功
+    mutable uint64_t bits = 0;              ///< 转换结果的对象表示
+  };
+
+  struct Data;
+
   std::optional<ParseError> error_;
-  std::map<std::string, std::string> values_;
   std::set<std::string> sections_;
+  std::shared_ptr<const Data> data_;  ///< 解析结果，解析完成后只读
 
-  static std::string makeKey(const std::string& section, const std::string& name);
-  static std::string trimRight(const std::string& s);
-  static std::string trimLeft(const std::string& s);
-  static size_t findCharsOrComment(const std::string& s, const std::string& chars);
-  void parse(std::istream& stream);
+  const Value* lookup(std::string_view section, std::string_view name) const noexcept;
+  template <typename T>
+  static std::optional<T> convert(std::string_view text);
+  template <typename T>
+  static std::optional<T> convert(const Value& value);
+  template <typename T>
+  static std::optional<T> cached(const Value& value, Value::Kind kind, std::optional<T> (*parse)(std::string_view));
+
+  static std::string_view trimRight(std::string_view s);
+  static std::string_view trimLeft(std::string_view s);
+  void parse(std::string text);
 };
 
+template <typename T>
+std::optional<T> INIReader::convert(std::string_view text) {
+  if constexpr (std::is_same_v<T, std::string_view>) {
+    return text;
+  } else if constexpr (std::is_same_v<T, bool>) {
+    return parseBoolean(text);
+  } else if constexpr (std::is_same_v<T, time::Timespan>) {
+    return parseDuration(text);
+  } else {
+    return utils::lexicalCast<T>(text);
+  }
+}
+
+template <typename T>
+std::optional<T> INIReader::cached(const Value& value, Value::Kind kind,
+                                   std::optional<T> (*parse)(std::string_view)) {
+  static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(uint64_t));
+  constexpr uint8_t kEmpty = 0;
+  constexpr uint8_t kBusy = 1;
+  const auto tag = static_cast<uint8_t>(2 + static_cast<uint8_t>(kind));
+
+  uint8_t state = value.state.load(std::memory_order_acquire);
+  if (state == tag) {
+    if (!value.ok) return std::nullopt;
+    T result{};
+    std::memcpy(&result, &value.bits, sizeof(T));
+    return result;
+  }
+  std::optional<T> result = parse(value.text);
+  if (state == kEmpty && value.state.compare_exchange_strong(state, kBusy, std::memory_order_relaxed)) {
+    value.ok = result.has_value();
+    if (result) std::memcpy(&value.bits, &*result, sizeof(T));
+    value.state.store(tag, std::memory_order_release);
+  }
+  return result;
+}
+
+template <typename T>
+std::optional<T> INIReader::convert(const Value& value) {
+  if constexpr (std::is_same_v<T, bool>) {
+    return cached<bool>(value, Value::Kind::Boolean, &parseBoolean);
+  } else if constexpr (std::is_integral_v<T>) {
+    // 超出 int64 的无符号值不走缓存
+    if constexpr (std::is_unsigned_v<T> && sizeof(T) >= sizeof(int64_t)) return convert<T>(value.text);
+    auto integer = cached<int64_t>(value, Value::Kind::Integer, &convert<int64_t>);
+    if (!integer || !std::in_range<T>(*integer)) return std::nullopt;
+    return static_cast<T>(*integer);
+  } else if constexpr (std::is_same_v<T, double>) {
+    return cached<double>(value, Value::Kind::Real, &convert<double>);
+  } else if constexpr (std::is_same_v<T, float>) {
+    return cached<float>(value, Value::Kind::Float, &convert<float>);
+  } else if constexpr (std::is_same_v<T, time::Timespan>) {
+    return cached<time::Timespan>(value, Value::Kind::Duration, &parseDuration);
+  } else {
+    return convert<T>(value.text);
+  }
+}
+
+template <typename T>
+std::optional<T> INIReader::get(std::string_view section, std::string_view name) const {
+  const Value* value = lookup(section, name);
+  if (!value) return std::nullopt;
+  return convert<T>(*value);
+}
+
+template <typename T>
+std::optional<std::vector<T>> INIReader::getList(std::string_view section, std::string_view name) const {
+  const Value* value = lookup(section, name);
+  if (!value) return std::nullopt;
+  std::vector<T> items;
+  std::string_view rest = value->text;
+  while (!rest.empty()) {
+    const size_t sep = rest.find_first_of(",\n");
+    std::string_view item = trimLeft(trimRight(rest.substr(0, sep)));
+    rest = sep == std::string_view::npos ? std::string_view() : rest.substr(sep + 1);
+    if (item.empty()) continue;
+    auto converted = convert<T>(item);
+    if (!converted) return std::nullopt;
+    items.push_back(std::move(*converted));
+  }
+  return items;
+}
+
 }  // namespace config
 }  // namespace pickup
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+#include "pickup/config/INIReader.h"
+#include "pickup/time/Timespan.h"
+
+namespace pickup {
+namespace config {
+
+/**
+ * @brief 分层合并的配置
+ *
+ * 按添加顺序叠加多个来源，后添加的层优先级更高，典型顺序为：
+ * 默认配置文件 → 主机配置文件 → 环境变量 → 命令行覆盖。build() 把各层合并为
+ * 一张扁平表，所有字符串驻留在内部字符串池中（相同的值只存一份），不依赖
+ * 各来源对象的生命周期；每个值都记录它来自哪一层。
+ *
+ * 热路径上的读取应预先注册类型化的键：registerKey() 返回的 Key<T> 只是一个
+ * 整数槽位，get(key) 直接按下标读取 build() 时已转换好的值，不做字符串查找。
+ *
+ * 环境变量层把 (section, name) 映射为 `prefix + SECTION + "_" + NAME`（大写，
+ * 非字母数字字符替换为 '_'，section 为空时省略 "SECTION_"），只覆盖在它之前的层中
+ * 出现过的键以及已注册的键。
+ *
+ * @code
+ * LayeredConfig config;
+ * config.addFile("defaults", "/etc/app/defaults.ini");
+ * config.addFile("host", "/etc/app/" + hostname + ".ini");
+ * config.addEnvironment("env", "APP_");
+ * config.addOverrides("cli", {"server.port=9090"});
+ * auto port = config.registerKey<int>("server", "port", 8080);
+ * config.build();
+ *
+ * int p = config.get(port);               // 数组下标读取
+ * auto from = config.sourceOf(port);      // "cli"
+ * @endcode
+ *
+ * @note build() 之后只读访问是线程安全的；build()、add*()、registerKey() 不可与读取并发。
+ */
+class LayeredConfig {
+ public:
+  /** @brief 覆盖层中的一项 */
+  struct Override {
+    std::string section;
+    std::string name;
+    std::string value;
+  };
+
+  /** @brief 类型化键，T 为 bool、整数、float、double、std::string_view 或 time::Timespan */
+  template <typename T>
+  class Key {
+   public:
+    /** @brief 槽位下标 */
+    [[nodiscard]] size_t slot() const noexcept { return slot_; }
+
+   private:
+    friend class LayeredConfig;
+    explicit Key(size_t slot) noexcept : slot_(slot) {}
+    size_t slot_;
+  };
+
+  using Visitor = std::function<void(std::string_view section, std::string_view name, std::string_view value,
+                                     std::string_view layer)>;
+
+  LayeredConfig() = default;
+  LayeredConfig(LayeredConfig&&) noexcept = default;
+  LayeredConfig& operator=(LayeredConfig&&) noexcept = default;
+  LayeredConfig(const LayeredConfig&) = delete;
+  LayeredConfig& operator=(const LayeredConfig&) = delete;
+
+  /**
+   * @brief 添加 INI 文件层
+   * @return 解析错误；文件无法打开时不添加该层
+   */
+  std::optional<INIReader::ParseError> addFile(std::string layer, const std::string& path);
+
+  /** @brief 添加已解析的 INIReader 层（共享其数据，不拷贝） */
+  void addReader(std::string layer, INIReader reader);
+
+  /** @brief 添加环境变量层 */
+  void addEnvironment(std::string layer, std::string prefix);
+
+  /** @brief 添加覆盖层 */
+  void addOverrides(std::string layer, std::vector<Override> overrides);
+
+  /**
+   * @brief 添加覆盖层，每项形如 "section.name=value"
+   *
+   * section 与 name 以最后一个 '.' 分隔，没有 '.' 时 section 为空；不含 '=' 的项被忽略。
+   */
+  void addOverrides(std::string layer, const std::vector<std::string>& assignments);
+
+  /**
+   * @brief 注册类型化键
+   *
+   * 可在 build() 之前或之后注册；之后注册时立即从已合并的表中取值。
+   * 值缺失或无法转换为 T（包括超出 T 的范围）时使用 default_value。
+   */
+  template <typename T>
+  Key<T> registerKey(std::string_view section, std::string_view name, T default_value);
+
+  /**
+   * @brief 合并所有层并为已注册的键取值，可重复调用（例如文件更新后）
+   *
+   * 每次重建字符串池，旧池随之释放；此前从 find()、get() 等取得的 string_view 失效。
+   *
+   * @return 所有已注册的键都转换成功时返回 true，否则见 invalidKeys()
+   */
+  bool build();
+
+  /** @brief 读取已注册键的值 */
+  template <typename T>
+  [[nodiscard]] T get(Key<T> key) const noexcept;
+
+  /** @brief 已注册键的值来自哪一层；使用默认值时返回 std::nullopt */
+  template <typename T>
+  [[nodiscard]] std::optional<std::string_view> sourceOf(Key<T> key) const noexcept {
+    return layerName(slots_[key.slot()].layer);
+  }
+
+  /** @brief 按名称查找合并后的原始值（大小写不敏感） */
+  [[nodiscard]] std::optional<std::string_view> find(std::string_view section, std::string_view name) const noexcept;
+
+  /** @brief 按名称查找的值来自哪一层；不存在时返回 std::nullopt */
+  [[nodiscard]] std::optional<std::string_view> sourceOf(std::string_view section,
+                                                         std::string_view name) const noexcept;
+
+  /** @brief 依次访问合并后的所有键值对及其来源层，按首次出现的顺序 */
+  void forEach(const Visitor& visitor) const;
+
+  /** @brief 合并后的键数 */
+  [[nodiscard]] size_t size() const noexcept { return entries_.size(); }
+
+  /** @brief 层数 */
+  [[nodiscard]] size_t layerCount() const noexcept { return layers_.size(); }
+
+  /** @brief 最近一次 build() 中值无法转换的已注册键，形如 "section.name" */
+  [[nodiscard]] const std::vector<std::string>& invalidKeys() const noexcept { return invalid_; }
+
+ private:
+  static constexpr int kDefaultLayer = -1;
+
+  using Value = std::variant<bool, int64_t, double, std::string_view, time::Timespan>;
+
+  /** @brief T 在槽位中的存储类型 */
+  template <typename T>
+  using StorageOf = std::conditional_t<
+      std::is_same_v<T, bool>, bool,
+      std::conditional_t<std::is_integral_v<T>, int64_t, std::conditional_t<std::is_floating_point_v<T>, double, T>>>;
+
+  struct Layer {
+    enum class Kind { Reader, Environment, Overrides };
+    std::string name;
+    Kind kind;
+    INIReader reader;
+    std::string prefix;
+    std::vector<Override> overrides;
+  };
+
+  struct Entry {
+    std::string_view section;
+    std::string_view name;
+    std::string_view value;
+    int layer;
+  };
+
+  struct Slot {
+    std::string_view section;
+    std::string_view name;
+    Value defaultValue;
+    Value value;
+    int64_t min;     ///< 整数键的取值范围
+    int64_t max;
+    double realMax;  ///< 浮点键有限值的绝对值上限
+    int layer;
+  };
+
+  struct KeyRef {
+    std::string_view section;
+    std::string_view name;
+  };
+  struct KeyHash {
+    size_t operator()(const KeyRef& key) const noexcept;
+  };
+  struct KeyEqual {
+    bool operator()(const KeyRef& a, const KeyRef& b) const noexcept;
+  };
+
+  std::string_view intern(std::string_view s);
+  void set(std::string_view section, std::string_view name, std::string_view value, int layer);
+  const Entry* findEntry(std::string_view section, std::string_view name) const noexcept;
+  bool resolve(Slot& slot);
+  size_t addSlot(std::string_view section, std::string_view name, Value default_value, int64_t min, int64_t max,
+                 double realMax);
+  std::optional<std::string_view> layerName(int layer) const noexcept;
+
+  std::vector<Layer> layers_;
+  std::deque<std::string> pool_;                     ///< 字符串池，deque 保证元素地址稳定
+  std::unordered_set<std::string_view> interned_;    ///< 池中字符串的索引
+  std::vector<Entry> entries_;                       ///< 合并后的扁平表
+  std::unordered_map<KeyRef, uint32_t, KeyHash, KeyEqual> index_;  ///< (section, name) -> entries_ 下标
+  std::vector<Slot> slots_;
+  std::vector<std::string> invalid_;
+};
+
+template <typename T>
+LayeredConfig::Key<T> LayeredConfig::registerKey(std::string_view section, std::string_view name, T default_value) {
+  using S = StorageOf<T>;
+  static_assert(std::is_same_v<S, bool> || std::is_same_v<S, int64_t> || std::is_same_v<S, double> ||
+                    std::is_same_v<S, std::string_view> || std::is_same_v<S, time::Timespan>,
+                "Unsupported LayeredConfig key type");
+  int64_t min = std::numeric_limits<int64_t>::min();
+  int64_t max = std::numeric_limits<int64_t>::max();
+  double realMax = std::numeric_limits<double>::max();
+  if constexpr (std::is_same_v<S, int64_t>) {
+    min = static_cast<int64_t>(std::numeric_limits<T>::min());
+    if constexpr (sizeof(T) < sizeof(int64_t) || std::is_signed_v<T>) {
+      max = static_cast<int64_t>(std::numeric_limits<T>::max());
+    }
+  } else if constexpr (std::is_floating_point_v<T>) {
+    realMax = static_cast<double>(std::numeric_limits<T>::max());
+  }
+  Value value;
+  if constexpr (std::is_same_v<S, std::string_view>) {
+    value = intern(default_value);
+  } else {
+    value = static_cast<S>(default_value);
+  }
+  return Key<T>(addSlot(section, name, value, min, max, realMax));
+}
+
+template <typename T>
+T LayeredConfig::get(Key<T> key) const noexcept {
+  return static_cast<T>(*std::get_if<StorageOf<T>>(&slots_[key.slot()].value));
+}
+
+}  // namespace config
+}  // namespace pickup
@@ -1,18 +1,61 @@
 #pragma once
 
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
-#include <iterator>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
 
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <google/protobuf/text_format.h>
 
+#include "pickup/buffer/MappedFile.h"
+
 namespace pickup {
 namespace config {
 
+namespace detail {
+
+/** @brief 编译缓存文件头，其后紧跟二进制 wire format 负载 */
+struct ProtoBufCacheHeader {
+  char magic[4];           ///< "PKCF"
+  uint32_t version;        ///< 缓存格式版本
+  uint64_t typeHash;       ///< 消息类型全名的哈希，防止不同类型误用同一缓存
+  uint64_t sourceSize;     ///< 源文件长度
+  int64_t sourceMtime;     ///< 源文件修改时间（file_clock 计数）
+  uint64_t sourceHash;     ///< 源文件内容的哈希
+  uint64_t payloadSize;    ///< 负载长度
+  uint64_t payloadHash;    ///< 负载的哈希，检出截断或损坏的缓存
+};
+
+inline constexpr char kProtoBufCacheMagic[4] = {'P', 'K', 'C', 'F'};
+inline constexpr uint32_t kProtoBufCacheVersion = 1;
+
+/** @brief FNV-1a 64 位哈希 */
+inline uint64_t fnv1a64(std::string_view data) noexcept {
+  uint64_t h = 14695981039346656037ULL;
+  for (char c : data) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+}  // namespace detail
+
 /**
  * @brief 基于 protobuf 文本格式的配置基类模板
  *
+ * 文本格式便于手写，但解析代价远高于二进制 wire format。大配置可以使用
+ * loadFromFileCached()：首次成功解析后在旁边写一份二进制缓存，以源文件的长度、
+ * 修改时间与内容哈希为键；之后源文件未变时直接 ParseFromArray 读取缓存。
+ *
  * @tparam ConfigType protobuf 消息类型
  */
 template <typename ConfigType>
@@ -28,11 +71,26 @@ class ProtoBufConfig {
 
   /**
    * @brief 从文件加载配置（文本格式）
+   *
+   * 文件被内存映射后直接交给解析器，不再整体读入 std::string。
+   *
    * @param conf_file 配置文件路径
    * @return 成功返回 true，文件打开失败或解析失败返回 false
    */
   bool loadFromFile(const std::string& conf_file);
 
+  /**
+   * @brief 从文件加载配置（文本格式），并使用二进制编译缓存
+   *
+   * 缓存新鲜（长度、修改时间、内容哈希与消息类型都一致）时从缓存加载；否则解析
+   * 文本并重写缓存。缓存写入失败不影响加载结果。
+   *
+   * @param conf_file  配置文件路径
+   * @param cache_file 缓存文件路径，为空时使用 conf_file + ".cache"
+   * @return 成功返回 true，文件打开失败或解析失败返回 false
+   */
+  bool loadFromFileCached(const std::string& conf_file, const std::string& cache_file = {});
+
   /**
    * @brief 从字符串加载配置（文本格式）
    * @param content 文本格式的配置内容
@@ -40,6 +98,13 @@ class ProtoBufConfig {
    */
   bool loadFromString(const std::string& content);
 
+  /**
+   * @brief 从二进制 wire format 文件加载配置（内存映射 + ParseFromArray）
+   * @param path 文件路径
+   * @return 成功返回 true，文件打开失败或解析失败返回 false
+   */
+  bool loadFromBinaryFile(const std::string& path);
+
   /**
    * @brief 将当前配置写入文件（文本格式）
    * @param dump_file 目标文件路径
@@ -47,8 +112,24 @@ class ProtoBufConfig {
    */
   bool dumpToFile(const std::string& dump_file) const;
 
+  /**
+   * @brief 将当前配置写入文件（二进制 wire format）
+   * @param dump_file 目标文件路径
+   * @return 成功返回 true，写入失败返回 false
+   */
+  bool dumpToBinaryFile(const std::string& dump_file) const;
+
+  /** @brief 最近一次 loadFromFileCached() 是否命中缓存 */
+  bool loadedFromCache() const { return loaded_from_cache_; }
+
  private:
+  bool parseText(std::string_view text);
+  bool loadCache(const std::string& cache_file, const detail::ProtoBufCacheHeader& expected);
+  bool writeCache(const std::string& cache_file, detail::ProtoBufCacheHeader header) const;
+  static detail::ProtoBufCacheHeader makeCacheHeader(const std::string& conf_file, std::string_view content);
+
   ConfigType config_;
+  bool loaded_from_cache_ = false;
 };
 
 template <typename ConfigType>
@@ -58,18 +139,47 @@ const ConfigType& ProtoBufConfig<ConfigType>::config() const {
 
 template <typename ConfigType>
 bool ProtoBufConfig<ConfigType>::loadFromFile(const std::string& path) {
-  std::ifstream file(path, std::ios::in);
-  if (!file.is_open()) {
+  buffer::MappedFile file;
+  if (!file.openRead(path)) {
     return false;
   }
-  std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-  return loadFromString(content);
+  file.advise(buffer::MappedFile::Advice::Sequential);
+  return parseText(file.view());
+}
+
+template <typename ConfigType>
+bool ProtoBufConfig<ConfigType>::loadFromFileCached(const std::string& path, const std::string& cache_file) {
+  loaded_from_cache_ = false;
+  buffer::MappedFile file;
+  if (!file.openRead(path)) {
+    return false;
+  }
+  const std::string cache_path = cache_file.empty() ? path + ".cache" : cache_file;
+  const auto header = makeCacheHeader(path, file.view());
+  if (loadCache(cache_path, header)) {
+    loaded_from_cache_ = true;
+    return true;
+  }
+  if (!parseText(file.view())) {
+    return false;
+  }
+  writeCache(cache_path, header);
+  return true;
 }
 
 template <typename ConfigType>
 bool ProtoBufConfig<ConfigType>::loadFromString(const std::string& content) {
+  return parseText(content);
+}
+
+template <typename ConfigType>
+bool ProtoBufConfig<ConfigType>::loadFromBinaryFile(const std::string& path) {
+  buffer::MappedFile file;
+  if (!file.openRead(path) || file.size() > static_cast<size_t>(INT_MAX)) {
+    return false;
+  }
   ConfigType tmp;
-  if (!google::protobuf::TextFormat::ParseFromString(content, &tmp)) {
+  if (!tmp.ParseFromArray(file.data(), static_cast<int>(file.size()))) {
     return false;
   }
   config_ = std::move(tmp);
@@ -91,5 +201,107 @@ bool ProtoBufConfig<ConfigType>::dumpToFile(const std::string& path) const {
   return file.good();
 }
 
+template <typename ConfigType>
+bool ProtoBufConfig<ConfigType>::dumpToBinaryFile(const std::string& path) const {
+  std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+  return config_.SerializeToOstream(&file) && file.good();
+}
+
+template <typename ConfigType>
+bool ProtoBufConfig<ConfigType>::parseText(std::string_view text) {
+  if (text.size() > static_cast<size_t>(INT_MAX)) {
+    return false;
+  }
+  // 直接在原缓冲区上解析，避免拷贝成 std::string
+  google::protobuf::io::ArrayInputStream input(text.data(), static_cast<int>(text.size()));
+  ConfigType tmp;
+  if (!google::protobuf::TextFormat::Parse(&input, &tmp)) {
+    return false;
+  }
+  config_ = std::move(tmp);
+  return true;
+}
+
+template <typename ConfigType>
+detail::ProtoBufCacheHeader ProtoBufConfig<ConfigType>::makeCacheHeader(const std::string& path,
+                                                                        std::string_view content) {
+  detail::ProtoBufCacheHeader header{};
+  std::memcpy(header.magic, detail::kProtoBufCacheMagic, sizeof(header.magic));
+  header.version = detail::kProtoBufCacheVersion;
+  header.typeHash = detail::fnv1a64(ConfigType::descriptor()->full_name());
+  header.sourceSize = content.size();
+  std::error_code ec;
+  header.sourceMtime = static_cast<int64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::filesystem::last_write_time(path, ec).time_since_epoch())
+          .count());
+  header.sourceHash = detail::fnv1a64(content);
+  return header;
+}
+
+template <typename ConfigType>
+bool ProtoBufConfig<ConfigType>::loadCache(const std::string& cache_file,
+                                           const detail::ProtoBufCacheHeader& expected) {
+  buffer::MappedFile cache;
+  if (!cache.openRead(cache_file) || cache.size() < sizeof(detail::ProtoBufCacheHeader)) {
+    return false;
+  }
+  detail::ProtoBufCacheHeader header;
+  std::memcpy(&header, cache.data(), sizeof(header));
+  const size_t payload_size = cache.size() - sizeof(header);
+  if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != expected.version ||
+      header.typeHash != expected.typeHash || header.sourceSize != expected.sourceSize ||
+      header.sourceMtime != expected.sourceMtime || header.sourceHash != expected.sourceHash ||
+      header.payloadSize != payload_size || payload_size > static_cast<size_t>(INT_MAX)) {
+    return false;
+  }
+  const auto* payload = reinterpret_cast<const char*>(cache.data()) + sizeof(header);
+  if (detail::fnv1a64(std::string_view(payload, payload_size)) != header.payloadHash) {
+    return false;
+  }
+  ConfigType tmp;
+  if (!tmp.ParseFromArray(payload, static_cast<int>(payload_size))) {
+    return false;
+  }
+  config_ = std::move(tmp);
+  return true;
+}
+
+template <typename ConfigType>
+bool ProtoBufConfig<ConfigType>::writeCache(const std::string& cache_file, detail::ProtoBufCacheHeader header) const {
+  std::string payload;
+  if (!config_.SerializeToString(&payload)) {
+    return false;
+  }
+  header.payloadSize = payload.size();
+  header.payloadHash = detail::fnv1a64(payload);
+
+  // 先写临时文件再 rename，并发启动的进程不会读到半个缓存
+  const std::string tmp_file = cache_file + ".tmp";
+  {
+    std::ofstream file(tmp_file, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    if (!file.good()) {
+      file.close();
+      std::remove(tmp_file.c_str());
+      return false;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp_file, cache_file, ec);
+  if (ec) {
+    std::remove(tmp_file.c_str());
+    return false;
+  }
+  return true;
+}
+
 }  // namespace config
 }  // namespace pickup
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "pickup/time/Timespan.h"
+#include "pickup/time/Timestamp.h"
+#include "pickup/time/Timezone.h"
+
+namespace pickup {
+namespace timer {
+
+/**
+ * @brief 日历对齐的调度规则（cron 表达式），预编译为位集合以快速求下次触发时刻
+ *
+ * 表达式支持 5 段 "分 时 日 月 周" 或 6 段 "秒 分 时 日 月 周"（5 段时秒固定为 0）。
+ * 每段可为 `*`、`n`、`a-b`、`*\/s`、`a-b/s`、`a/s` 及其逗号列表；月份可写 JAN–DEC，
+ * 星期可写 SUN–SAT（0 与 7 均为周日）。另支持 @yearly/@annually、@monthly、@weekly、
+ * @daily/@midnight、@hourly。日与周均受限时按 cron 惯例取"或"。
+ *
+ * 挂钟时间可按系统本地时区（含夏令时，经 LocalTime / mktime 换算）或按固定
+ * Timezone 解释。夏令时跳过的时刻顺延至跳变后的等价时刻，重复的时刻只触发一次。
+ *
+ * @code
+ * auto s = CronSchedule::daily(2, 30);                // 每天本地 02:30
+ * auto next = s.next(pickup::time::UtcTimestamp());   // 下次触发的 UTC 时刻
+ * @endcode
+ *
+ * @note 对象构造后不可变，可在多线程间共享。
+ */
+class CronSchedule {
+ public:
+  /**
+   * @brief 解析 cron 表达式，按系统本地时区解释
+   * @throws std::invalid_argument 表达式语法错误或字段越界
+   */
+  static CronSchedule parse(const std::string& expression);
+
+  /**
+   * @brief 解析 cron 表达式，按固定时区（timezone.total() 偏移）解释
+   * @throws std::invalid_argument 表达式语法错误或字段越界
+   */
+  static CronSchedule parse(const std::string& expression, const time::Timezone& timezone);
+
+  /** @brief 每分钟整点（:00 秒）触发 */
+  static CronSchedule everyMinute();
+
+  /** @brief 每小时的第 minute 分触发（本地时区） */
+  static CronSchedule hourly(int minute = 0);
+
+  /** @brief 每天本地 hour:minute 触发 */
+  static CronSchedule daily(int hour, int minute = 0);
+
+  /**
+   * @brief 求严格晚于 after 的下一个触发时刻
+   * @param after 参考时刻（UTC 纳秒）
+   * @return 下次触发时刻；规则在可表示范围内不再命中（如 "0 0 30 2 *"）时返回 std::nullopt
+   */
+  [[nodiscard]] std::optional<time::UtcTimestamp> next(const time::Timestamp& after) const;
+
+  /** @brief 原始表达式 */
+  [[nodiscard]] const std::string& expression() const noexcept { return expression_; }
+
+ private:
+  CronSchedule() = default;
+
+  static CronSchedule compile(const std::string& expression, std::optional<time::Timespan> offset);
+
+  bool matchesDay(int year, int month, int day) const noexcept;
+
+  std::string expression_;
+  uint64_t seconds_{0};   ///< bit 0–59
+  uint64_t minutes_{0};   ///< bit 0–59
+  uint32_t hours_{0};     ///< bit 0–23
+  uint32_t days_{0};      ///< bit 1–31
+  uint16_t months_{0};    ///< bit 1–12
+  uint8_t weekdays_{0};   ///< bit 0–6（0 = 周日）
+  bool anyDay_{true};     ///< 日字段为 *
+  bool anyWeekday_{true}; ///< 周字段为 *
+  std::optional<time::Timespan> offset_;  ///< 固定时区偏移；为空表示系统本地时区
+};
+
+}  // namespace timer
+}  // namespace pickup
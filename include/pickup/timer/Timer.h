@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <exception>
@@ -12,6 +13,8 @@
 #include <stdexcept>
 #include <thread>
 
+#include "pickup/timer/CronSchedule.h"
+#include "pickup/timer/TimerStats.h"
 #include "pickup/timer/TimerTask.h"
 
 namespace pickup {
@@ -29,6 +32,21 @@ class TimerTaskAdapter final : public TimerTask {
   std::function<void()> func_;
 };
 
+/**
+ * @brief Timer 构造选项
+ */
+struct TimerOptions {
+  /**
+   * 高精度模式：先休眠至截止前 spinWindow（Linux 下经 timerfd 按绝对时刻休眠，其余
+   * 平台用条件变量），再在 steady_clock 上自旋至截止时刻。可将触发抖动从条件变量
+   * 的数十微秒降至数微秒，代价是每次触发约 spinWindow 的 CPU 占用。
+   */
+  bool highResolution = false;
+
+  /** 高精度模式下截止前的自旋时长；应不小于所在平台休眠唤醒的典型超调 */
+  std::chrono::nanoseconds spinWindow = std::chrono::microseconds(100);
+};
+
 /**
  * @brief 定时器，支持一次性 / 重复执行的任务调度
  *
@@ -46,6 +64,7 @@ class TimerTaskAdapter final : public TimerTask {
 class Timer {
  public:
   Timer();
+  explicit Timer(const TimerOptions& options);
   ~Timer();
 
   Timer(const Timer&) = delete;
@@ -156,6 +175,31 @@ class Timer {
     return task;
   }
 
+  /**
+   * @brief 按日历规则重复执行任务（如每分钟 :00、每天本地 02:30、cron 表达式）
+   * @param task     要重复执行的任务
+   * @param schedule 日历规则，见 CronSchedule
+   * @note 每次执行后按【挂钟时间】重新求下次触发时刻，故不受执行耗时与夏令时切换
+   *       影响而漂移。系统挂起恢复或挂钟跳变会在 kCalendarResyncInterval 内被察觉并
+   *       重新对齐；挂起期间错过的多次触发只补一次。
+   * @throws std::invalid_argument 定时器已销毁、任务已调度，或规则已无后续触发时刻
+   */
+  void scheduleAt(const TimerTaskPtr& task, const CronSchedule& schedule);
+
+  /**
+   * @brief 按日历规则重复执行一个函数
+   * @return 内部创建的任务句柄，用于 cancel()
+   * @see scheduleAt(const TimerTaskPtr&, const CronSchedule&)
+   */
+  TimerTaskPtr scheduleAt(std::function<void()> func, const CronSchedule& schedule) {
+    auto task = std::make_shared<TimerTaskAdapter>(std::move(func));
+    scheduleAt(task, schedule);
+    return task;
+  }
+
+  /** @brief 存在日历任务时，工作线程检查挂钟与单调时钟偏差的最长间隔 */
+  static constexpr std::chrono::seconds kCalendarResyncInterval{1};
+
   /**
    * @brief 取消一个任务
    * @param task 要取消的任务
@@ -166,6 +210,20 @@ class Timer {
   /** @brief 检查任务是否已调度 */
   bool isScheduled(const TimerTaskPtr& task) const;
 
+  /**
+   * @brief 获取运行指标快照（触发滞后、执行耗时、待触发数、fixed-rate 落后次数）
+   * @note 指标由工作线程以 relaxed 原子累加，本调用仅短暂持锁读取待触发数，
+   *       可在任意线程频繁调用；各字段不保证取自同一时刻。
+   */
+  [[nodiscard]] TimerStats stats() const;
+
+  /**
+   * @brief 清零累计指标（pending 不受影响）
+   * @note 可在任意线程调用；与工作线程并发记录时，正在记录的那一次可能部分计入清零前、
+   *       部分计入清零后（例如 count 与直方图桶相差 1），但最大值不会被旧值覆盖回去。
+   */
+  void resetStats() noexcept;
+
  protected:
   /**
    * @brief 执行定时任务
@@ -190,8 +248,9 @@ class Timer {
     std::optional<std::chrono::nanoseconds> delay;
     TimerTaskPtr task;
     bool fixedRate = false;  ///< true=固定频率(基于计划时刻)，false=固定延迟(基于完成时刻)
+    bool calendar = false;   ///< true=日历任务，续排规则见 calendars_
 
-    // 排序仅依据 (scheduledTime, task)，delay/fixedRate 不参与比较——cancelNoSync
+    // 排序仅依据 (scheduledTime, task)，delay/fixedRate/calendar 不参与比较——cancelNoSync
     // 据此可用默认的 delay/fixedRate 重建键来定位并删除条目。
     bool operator<(const Token& other) const {
       if (scheduledTime < other.scheduledTime) return true;
@@ -207,13 +266,41 @@ class Timer {
                std::optional<std::chrono::nanoseconds> repeat, bool reschedule, bool fixedRate);
   void runLoop();
   bool cancelNoSync(const TimerTaskPtr& task) noexcept;
+  // 挂钟相对单调时钟的偏差变化（挂起恢复、手动调时）超出容差时，按各日历任务的
+  // 挂钟目标重算其单调时钟排期
+  void resyncCalendarNoSync(std::chrono::steady_clock::time_point now);
+  // 唤醒工作线程（条件变量；高精度模式下还需唤醒 poll 中的 timerfd 等待）
+  void notifyWorker();
+  // 高精度等待：休眠至 deadline - spinWindow，再自旋至 deadline。被 notifyWorker()
+  // 提前唤醒时直接返回，由调用方重新评估队首
+  void waitPrecise(std::unique_lock<std::mutex>& lock, std::chrono::steady_clock::time_point deadline);
+
+  // 日历任务的规则与下次触发的挂钟时刻
+  struct CalendarEntry {
+    CronSchedule schedule;
+    std::chrono::system_clock::time_point wallTime;
+  };
 
   mutable std::mutex mutex_;
   std::condition_variable condition_;
   std::set<Token> tokens_;
   std::map<TimerTaskPtr, std::chrono::steady_clock::time_point> tasks_;
+  std::map<TimerTaskPtr, CalendarEntry> calendars_;
+  std::chrono::nanoseconds wallOffset_{0};  ///< 上次对齐时 system_clock 与 steady_clock 读数之差
   bool destroyed_{false};
   std::chrono::steady_clock::time_point wakeUpTime_;
+
+  const TimerOptions options_;
+  int timerFd_{-1};  ///< 高精度模式（Linux）下的 timerfd
+  int wakeFd_{-1};   ///< 高精度模式（Linux）下用于打断 poll 的 eventfd
+
+  // 运行指标：工作线程累加，resetStats() 可从任意线程清零
+  std::atomic<uint64_t> fired_{0};
+  std::atomic<uint64_t> exceptions_{0};
+  std::atomic<uint64_t> fixedRateOverruns_{0};
+  detail::HistogramRecorder lag_;
+  detail::HistogramRecorder execution_;
+
   std::thread worker_;
 };
 
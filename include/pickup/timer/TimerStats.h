@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace pickup {
+namespace timer {
+
+/**
+ * @brief 按 2 的幂分桶的耗时直方图（快照）
+ *
+ * buckets[i] 统计落在 [2^(i-1), 2^i) 纳秒内的样本数，buckets[0] 只统计 0ns。
+ * 分桶粗粒度（相邻桶相差一倍），换来记录端仅需几次原子加法，适合常开。
+ */
+struct LatencyHistogram {
+  static constexpr size_t kBucketCount = 64;
+
+  std::array<uint64_t, kBucketCount> buckets{};  ///< 各桶样本数
+  uint64_t count = 0;                            ///< 样本总数
+  std::chrono::nanoseconds total{0};             ///< 样本总和
+  std::chrono::nanoseconds max{0};               ///< 最大样本
+
+  /** @brief 平均值；无样本时为 0 */
+  [[nodiscard]] std::chrono::nanoseconds mean() const noexcept;
+
+  /**
+   * @brief 近似分位数
+   * @param p 分位（0–1），如 0.99
+   * @return 第 p 分位样本所在桶的上界（不超过 max）；无样本时为 0
+   */
+  [[nodiscard]] std::chrono::nanoseconds percentile(double p) const noexcept;
+
+  /** @brief 样本值对应的桶下标 */
+  static size_t bucketOf(std::chrono::nanoseconds value) noexcept;
+};
+
+/**
+ * @brief Timer 运行指标快照，由 Timer::stats() 返回
+ */
+struct TimerStats {
+  size_t pending = 0;              ///< 当前待触发的任务数
+  uint64_t fired = 0;              ///< 累计执行次数（含重复任务的每一次）
+  uint64_t exceptions = 0;         ///< 执行时抛出异常的次数
+  uint64_t fixedRateOverruns = 0;  ///< fixed-rate 续排时下次计划时刻已过期（需补触发追赶）的次数
+  LatencyHistogram lag;            ///< 实际开始执行时刻相对计划时刻的滞后
+  LatencyHistogram execution;      ///< 单次执行耗时
+};
+
+namespace detail {
+
+/**
+ * @brief LatencyHistogram 的记录端
+ *
+ * record() 仅由单一线程（定时器工作线程）调用，reset() 可由任意线程调用，任意线程
+ * 可并发读取快照；全部使用 relaxed 原子，各字段间不保证同一时刻的一致性。
+ */
+class HistogramRecorder {
+ public:
+  void record(std::chrono::nanoseconds value) noexcept;
+  [[nodiscard]] LatencyHistogram snapshot() const noexcept;
+  void reset() noexcept;
+
+ private:
+  std::array<std::atomic<uint64_t>, LatencyHistogram::kBucketCount> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<int64_t> total_{0};
+  std::atomic<int64_t> max_{0};
+};
+
+}  // namespace detail
+
+}  // namespace timer
+}  // namespace pickup
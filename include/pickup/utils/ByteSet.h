@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "pickup/utils/CpuFeatures.h"
+
+namespace pickup {
+namespace utils {
+namespace detail {
+
+/**
+ * @brief 字节集合，StringUtils 与 codec::url 共用的扫描表（内部使用）
+ *
+ * 标量路径查 256 位成员表；SSSE3/AVX2 路径用 pshufb 查 nibble 位图，只覆盖 ASCII 成员；
+ * 含非 ASCII 成员且不超过 16 个时改用 SSE4.2 的 pcmpestri。
+ */
+struct ByteSet {
+  std::array<uint64_t, 4> bits{};  ///< 256 位成员表
+  std::array<uint8_t, 16> rows{};  ///< rows[c & 0xF] 的第 (c >> 4) 位表示 ASCII 字符 c 属于集合
+  std::array<char, 16> chars{};    ///< 前 16 个不同成员，供 pcmpestri 使用
+  size_t count = 0;                ///< 不同成员数
+  bool ascii = true;               ///< 是否只含 ASCII 成员
+
+  constexpr bool has(unsigned char c) const noexcept { return ((bits[c >> 6] >> (c & 63)) & 1) != 0; }
+
+  constexpr void add(unsigned char c) noexcept {
+    if (has(c)) return;
+    bits[c >> 6] |= uint64_t{1} << (c & 63);
+    if (count < chars.size()) chars[count] = static_cast<char>(c);
+    ++count;
+    if (c >= 0x80) {
+      ascii = false;
+    } else {
+      rows[c & 0x0F] = static_cast<uint8_t>(rows[c & 0x0F] | (1u << (c >> 4)));
+    }
+  }
+};
+
+/**
+ * @brief 另带 256 字节成员表的 ByteSet，用于编译期构造的常量集合
+ *
+ * 标量路径逐字节查字节表比查位表少几条指令；运行时逐次构造时清零成员表的代价
+ * 反而更高，因此按调用构造的集合仍用 ByteSet。
+ */
+struct ByteTable : ByteSet {
+  std::array<bool, 256> member{};
+
+  constexpr bool has(unsigned char c) const noexcept { return member[c]; }
+
+  constexpr void add(unsigned char c) noexcept {
+    ByteSet::add(c);
+    member[c] = true;
+  }
+};
+
+constexpr ByteSet makeByteSet(std::string_view chars) noexcept {
+  ByteSet set;
+  for (const char c : chars) set.add(static_cast<unsigned char>(c));
+  return set;
+}
+
+constexpr ByteTable makeByteTable(std::string_view chars) noexcept {
+  ByteTable table;
+  for (const char c : chars) table.add(static_cast<unsigned char>(c));
+  return table;
+}
+
+// 各实现：返回 s 中第一个"是否属于 set"等于 member 的字节下标，没有则返回 len。
+// SSSE3/AVX2 版本只支持 set.ascii 且要求 len >= 16，SSE4.2 版本只支持 set.count <= 16
+template <typename Set>
+inline size_t scanByteSetScalar(const char* s, size_t len, const Set& set, bool member) noexcept {
+  size_t i = 0;
+  while (i < len && set.has(static_cast<unsigned char>(s[i])) != member) {
+    ++i;
+  }
+  return i;
+}
+
+#if PICKUP_X86_SIMD
+PICKUP_TARGET("ssse3") size_t scanByteSetSSSE3(const char* s, size_t len, const ByteSet& set, bool member) noexcept;
+PICKUP_TARGET("sse4.2") size_t scanByteSetSSE42(const char* s, size_t len, const ByteSet& set, bool member) noexcept;
+PICKUP_TARGET("avx2") size_t scanByteSetAVX2(const char* s, size_t len, const ByteSet& set, bool member) noexcept;
+#endif
+
+/**
+ * @brief 返回 s 中第一个"是否属于 set"等于 member 的字节下标，没有则返回 len
+ *
+ * 按 simdLevel() 选择实现，分派内联在调用方；不足 16 字节直接走标量循环。
+ * Set 为 ByteSet 或 ByteTable。
+ */
+template <typename Set>
+inline size_t scanByteSet(const char* s, size_t len, const Set& set, bool member) noexcept {
+#if PICKUP_X86_SIMD
+  if (len < 16) return scanByteSetScalar(s, len, set, member);
+  const SimdLevel level = simdLevel();
+  if (set.ascii) {
+    if (level >= SimdLevel::AVX2) {
+      return scanByteSetAVX2(s, len, set, member);
+    }
+    if (level >= SimdLevel::SSSE3) {
+      return scanByteSetSSSE3(s, len, set, member);
+    }
+  } else if (set.count <= set.chars.size() && level >= SimdLevel::SSE42) {
+    return scanByteSetSSE42(s, len, set, member);
+  }
+#endif
+  return scanByteSetScalar(s, len, set, member);
+}
+
+}  // namespace detail
+}  // namespace utils
+}  // namespace pickup
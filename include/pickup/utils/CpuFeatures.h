@@ -0,0 +1,55 @@
+#pragma once
+
+#include "pickup/utils/platform.h"
+
+/**
+ * @brief x86 SIMD 代码路径的编译开关
+ *
+ * GCC/Clang 下各 SIMD 实现函数通过 PICKUP_TARGET 单独指定指令集，整个库无需
+ * -march 编译选项，运行时再按 simdLevel() 选择可用的最快实现。
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(PICKUP_GCC_COMPILER) || defined(PICKUP_CLANG_COMPILER))
+#define PICKUP_X86_SIMD 1
+#define PICKUP_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PICKUP_X86_SIMD 0
+#define PICKUP_TARGET(isa)
+#endif
+
+namespace pickup {
+namespace utils {
+
+/**
+ * @brief SIMD 指令集级别（后者包含前者）
+ */
+enum class SimdLevel : int {
+  None = 0,    ///< 仅标量实现
+  SSSE3,       ///< SSSE3（pshufb）
+  SSE42,       ///< SSE4.2（pcmpistri 等字符串指令）
+  AVX2,        ///< AVX2
+  AVX512BW,    ///< AVX-512 F/BW
+  AVX512VBMI,  ///< AVX-512 VBMI（字节级置换）
+};
+
+/** @brief 当前 CPU（及操作系统）支持的最高级别，首次调用时检测 */
+[[nodiscard]] SimdLevel detectedSimdLevel() noexcept;
+
+/** @brief 各 SIMD 实现实际使用的级别：detectedSimdLevel() 与 setSimdLevelLimit() 上限中的较小者 */
+[[nodiscard]] SimdLevel simdLevel() noexcept;
+
+/**
+ * @brief 限制 simdLevel() 的上限
+ *
+ * 主要用于测试与基准：逐级限制后可在同一台机器上覆盖并比较每条代码路径。
+ * @param limit 上限；SimdLevel::AVX512VBMI 表示不限制
+ */
+void setSimdLevelLimit(SimdLevel limit) noexcept;
+
+/** @brief 当前由 setSimdLevelLimit() 设置的上限，便于临时限制后恢复 */
+[[nodiscard]] SimdLevel simdLevelLimit() noexcept;
+
+/** @brief 级别名称，如 "avx2" */
+[[nodiscard]] const char* toString(SimdLevel level) noexcept;
+
+}  // namespace utils
+}  // namespace pickup
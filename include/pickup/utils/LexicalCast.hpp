@@ -1,9 +1,7 @@
 #pragma once
 
 #include <cctype>
-#include <cerrno>
 #include <charconv>
-#include <cstdlib>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -35,25 +33,23 @@ std::optional<T> parseInteger(std::string_view sv) {
   return value;
 }
 
-inline std::optional<float> parseFloat(std::string_view sv) {
-  char* end = nullptr;
-  errno = 0;
-  float v = std::strtof(sv.data(), &end);
-  if (errno != 0 || end != sv.data() + sv.size()) {
+// 用 std::from_chars 而非 strtod：不受 locale 影响，也不会越过 string_view 末尾读取。
+// 与 strtod 相比仍接受前导 '+'，但不再接受前导空白与十六进制浮点（"0x1p3"）
+template <typename T>
+std::optional<T> parseFloating(std::string_view sv) {
+  static_assert(std::is_floating_point_v<T>);
+  if (sv.size() > 1 && sv[0] == '+' && sv[1] != '-' && sv[1] != '+') sv.remove_prefix(1);
+  T value{};
+  auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), value);
+  if (ec != std::errc{} || ptr != sv.data() + sv.size()) {
     return std::nullopt;
   }
-  return v;
+  return value;
 }
 
-inline std::optional<double> parseDouble(std::string_view sv) {
-  char* end = nullptr;
-  errno = 0;
-  double v = std::strtod(sv.data(), &end);
-  if (errno != 0 || end != sv.data() + sv.size()) {
-    return std::nullopt;
-  }
-  return v;
-}
+inline std::optional<float> parseFloat(std::string_view sv) { return parseFloating<float>(sv); }
+
+inline std::optional<double> parseDouble(std::string_view sv) { return parseFloating<double>(sv); }
 
 inline std::optional<bool> parseBool(std::string_view sv) {
   if (iequals(sv, "true")) return true;
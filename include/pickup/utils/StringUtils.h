@@ -1,6 +1,13 @@
 #pragma once
 
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace pickup {
@@ -11,21 +18,33 @@ namespace utils {
  * @param str 输入字符串
  * @return 转换后的新字符串，原字符串不变
  */
-std::string toUpper(const std::string& str);
+std::string toUpper(std::string_view str);
 
 /**
  * @brief 将字符串转换为小写
  * @param str 输入字符串
  * @return 转换后的新字符串，原字符串不变
  */
-std::string toLower(const std::string& str);
+std::string toLower(std::string_view str);
+
+/**
+ * @brief 原地将字符串转换为大写，不分配内存
+ * @param str 要转换的字符串
+ */
+void toUpperInPlace(std::string& str);
+
+/**
+ * @brief 原地将字符串转换为小写，不分配内存
+ * @param str 要转换的字符串
+ */
+void toLowerInPlace(std::string& str);
 
 /**
  * @brief 检查字符串是否为空或全为空白字符（空格、\t、\n、\r 等）
  * @param str 要检查的字符串
  * @return 为空或全空白返回 true，否则返回 false
  */
-bool isBlank(const std::string& str);
+bool isBlank(std::string_view str);
 
 /**
  * @brief 检查字符串是否包含指定子串
@@ -33,7 +52,7 @@ bool isBlank(const std::string& str);
  * @param pattern 要查找的子串
  * @return 包含返回 true，否则返回 false
  */
-bool contains(const std::string& str, const std::string& pattern);
+bool contains(std::string_view str, std::string_view pattern);
 
 /**
  * @brief 检查字符串是否以指定字符开头
@@ -41,7 +60,7 @@ bool contains(const std::string& str, const std::string& pattern);
  * @param ch 要检查的字符
  * @return 匹配返回 true，否则返回 false
  */
-bool startsWith(const std::string& str, char ch);
+bool startsWith(std::string_view str, char ch);
 
 /**
  * @brief 检查字符串是否以指定前缀开头
@@ -49,7 +68,7 @@ bool startsWith(const std::string& str, char ch);
  * @param prefix 要检查的前缀
  * @return 匹配返回 true，否则返回 false
  */
-bool startsWith(const std::string& str, const std::string& prefix);
+bool startsWith(std::string_view str, std::string_view prefix);
 
 /**
  * @brief 检查字符串是否以指定字符结尾
@@ -57,7 +76,7 @@ bool startsWith(const std::string& str, const std::string& prefix);
  * @param ch 要检查的字符
  * @return 匹配返回 true，否则返回 false
  */
-bool endsWith(const std::string& str, char ch);
+bool endsWith(std::string_view str, char ch);
 
 /**
  * @brief 检查字符串是否以指定后缀结尾
@@ -65,7 +84,7 @@ bool endsWith(const std::string& str, char ch);
  * @param suffix 要检查的后缀
  * @return 匹配返回 true，否则返回 false
  */
-bool endsWith(const std::string& str, const std::string& suffix);
+bool endsWith(std::string_view str, std::string_view suffix);
 
 /**
  * @brief 比较两个字符是否相等（不区分大小写）
@@ -83,7 +102,7 @@ bool compareNoCase(char c1, char c2);
  * @return 相等返回 true，否则返回 false
  * @note 仅支持 ASCII 字符
  */
-bool compareNoCase(const std::string& str1, const std::string& str2);
+bool compareNoCase(std::string_view str1, std::string_view str2);
 
 /**
  * @brief 移除字符串左侧的指定字符
@@ -111,21 +130,45 @@ void trim(std::string& str, char c = ' ');
  * @param str 要处理的字符串（原地修改）
  * @param chars 要移除的字符集，如 " \t\n\r"
  */
-void trimLeft(std::string& str, const std::string& chars);
+void trimLeft(std::string& str, std::string_view chars);
 
 /**
  * @brief 移除字符串右侧属于指定字符集的字符
  * @param str 要处理的字符串（原地修改）
  * @param chars 要移除的字符集，如 " \t\n\r"
  */
-void trimRight(std::string& str, const std::string& chars);
+void trimRight(std::string& str, std::string_view chars);
 
 /**
  * @brief 移除字符串两侧属于指定字符集的字符
  * @param str 要处理的字符串（原地修改）
  * @param chars 要移除的字符集，如 " \t\n\r"
  */
-void trim(std::string& str, const std::string& chars);
+void trim(std::string& str, std::string_view chars);
+
+/**
+ * @brief 返回去掉左侧属于指定字符集的字符后的视图
+ * @param str   原始字符串
+ * @param chars 要移除的字符集，默认为空白字符
+ * @return 指向 str 内部的视图
+ */
+std::string_view trimLeftView(std::string_view str, std::string_view chars = " \t\n\r\f\v");
+
+/**
+ * @brief 返回去掉右侧属于指定字符集的字符后的视图
+ * @param str   原始字符串
+ * @param chars 要移除的字符集，默认为空白字符
+ * @return 指向 str 内部的视图
+ */
+std::string_view trimRightView(std::string_view str, std::string_view chars = " \t\n\r\f\v");
+
+/**
+ * @brief 返回去掉两侧属于指定字符集的字符后的视图
+ * @param str   原始字符串
+ * @param chars 要移除的字符集，默认为空白字符
+ * @return 指向 str 内部的视图
+ */
+std::string_view trimView(std::string_view str, std::string_view chars = " \t\n\r\f\v");
 
 /**
  * @brief 替换字符串中所有匹配的子串
@@ -134,7 +177,7 @@ void trim(std::string& str, const std::string& chars);
  * @param to 替换后的子串
  * @return 替换后的新字符串，原字符串不变
  */
-std::string replaceAll(const std::string& str, const std::string& from, const std::string& to);
+std::string replaceAll(std::string_view str, std::string_view from, std::string_view to);
 
 /**
  * @brief 若字符串以指定前缀开头则将其移除，否则原样返回
@@ -142,7 +185,7 @@ std::string replaceAll(const std::string& str, const std::string& from, const st
  * @param prefix 要移除的前缀
  * @return 移除前缀后的新字符串
  */
-std::string stripPrefix(const std::string& str, const std::string& prefix);
+std::string stripPrefix(std::string_view str, std::string_view prefix);
 
 /**
  * @brief 若字符串以指定后缀结尾则将其移除，否则原样返回
@@ -150,7 +193,23 @@ std::string stripPrefix(const std::string& str, const std::string& prefix);
  * @param suffix 要移除的后缀
  * @return 移除后缀后的新字符串
  */
-std::string stripSuffix(const std::string& str, const std::string& suffix);
+std::string stripSuffix(std::string_view str, std::string_view suffix);
+
+/**
+ * @brief 同 stripPrefix()，但返回指向 str 内部的视图
+ * @param str    原始字符串
+ * @param prefix 要移除的前缀
+ * @return 移除前缀后的视图
+ */
+std::string_view stripPrefixView(std::string_view str, std::string_view prefix);
+
+/**
+ * @brief 同 stripSuffix()，但返回指向 str 内部的视图
+ * @param str    原始字符串
+ * @param suffix 要移除的后缀
+ * @return 移除后缀后的视图
+ */
+std::string_view stripSuffixView(std::string_view str, std::string_view suffix);
 
 /**
  * @brief 在字符串左侧填充字符至指定宽度
@@ -159,7 +218,7 @@ std::string stripSuffix(const std::string& str, const std::string& suffix);
  * @param fill  填充字符，默认为空格
  * @return 填充后的新字符串
  */
-std::string padLeft(const std::string& str, size_t width, char fill = ' ');
+std::string padLeft(std::string_view str, size_t width, char fill = ' ');
 
 /**
  * @brief 在字符串右侧填充字符至指定宽度
@@ -168,7 +227,7 @@ std::string padLeft(const std::string& str, size_t width, char fill = ' ');
  * @param fill  填充字符，默认为空格
  * @return 填充后的新字符串
  */
-std::string padRight(const std::string& str, size_t width, char fill = ' ');
+std::string padRight(std::string_view str, size_t width, char fill = ' ');
 
 /**
  * @brief 将字符串重复 n 次
@@ -176,7 +235,7 @@ std::string padRight(const std::string& str, size_t width, char fill = ' ');
  * @param n   重复次数；为 0 时返回空字符串
  * @return 重复后的新字符串
  */
-std::string repeat(const std::string& str, size_t n);
+std::string repeat(std::string_view str, size_t n);
 
 /**
  * @brief 按完整字符串分隔符分割
@@ -187,7 +246,18 @@ std::string repeat(const std::string& str, size_t n);
  * split("a::b::c", "::") → ["a", "b", "c"]
  * @endcode
  */
-std::vector<std::string> split(const std::string& str, const std::string& delimiter);
+std::vector<std::string> split(std::string_view str, std::string_view delimiter);
+
+/**
+ * @brief 按单个字符分割
+ * @param str       要分割的字符串
+ * @param delimiter 分隔字符
+ * @return 分割后的子串向量
+ * @code
+ * split("a,b,,c", ',') → ["a", "b", "", "c"]
+ * @endcode
+ */
+std::vector<std::string> split(std::string_view str, char delimiter);
 
 /**
  * @brief 按字符集合分割字符串
@@ -198,7 +268,124 @@ std::vector<std::string> split(const std::string& str, const std::string& delimi
  * splitAnyOf("a,b;c", ",;") → ["a", "b", "c"]
  * @endcode
  */
-std::vector<std::string> splitAnyOf(const std::string& str, const std::string& delimiters);
+std::vector<std::string> splitAnyOf(std::string_view str, std::string_view delimiters);
+
+/**
+ * @brief 惰性分割的结果范围，逐个产生指向原字符串的 std::string_view
+ *
+ * 由 splitView() / splitAnyOfView() 创建，遍历时才查找下一个分隔符，不分配内存。
+ * 产生的片段与 split() / splitAnyOf() 返回的向量逐一对应（包括空片段）。
+ * 迭代器自身保存全部状态，不引用 SplitView 对象，但不能比原字符串存活得更久。
+ *
+ * @code
+ * for (std::string_view field : splitView(line, ' ')) {
+ *   ...
+ * }
+ * @endcode
+ */
+class SplitView : public std::ranges::view_interface<SplitView> {
+ public:
+  /** @brief 分隔符的解释方式 */
+  enum class Mode {
+    Char,    ///< 单个字符
+    String,  ///< 完整字符串；为空时逐字符分割
+    AnyOf,   ///< 字符集合中的任一字符
+  };
+
+  /**
+   * @brief 前向迭代器，解引用按值返回当前片段
+   *
+   * 片段保存在迭代器内部，按值返回才能让结果比迭代器存活得更久，因此传统
+   * iterator_category 只能是 input_iterator_tag，C++20 概念上则是 forward_iterator。
+   */
+  class iterator {
+   public:
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string_view*;
+    using reference = std::string_view;
+
+    iterator() = default;
+
+    reference operator*() const noexcept { return token_; }
+    pointer operator->() const noexcept { return &token_; }
+
+    iterator& operator++() {
+      advance();
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator old = *this;
+      advance();
+      return old;
+    }
+
+    friend bool operator==(const iterator& a, const iterator& b) noexcept {
+      return a.done_ == b.done_ && (a.done_ || a.pos_ == b.pos_);
+    }
+
+   private:
+    friend class SplitView;
+    iterator(std::string_view str, std::string_view delimiter, char ch, Mode mode);
+
+    void load();
+    void advance();
+
+    std::string_view str_;
+    std::string_view delimiter_;
+    char ch_ = 0;
+    Mode mode_ = Mode::Char;
+    std::string_view token_;  ///< 当前片段
+    size_t pos_ = 0;          ///< 当前片段的起点
+    size_t next_ = 0;         ///< 下一个片段的起点
+    bool last_ = true;        ///< 当前片段之后没有分隔符
+    bool done_ = true;
+    std::array<uint64_t, 4> set_{};  ///< AnyOf 模式下分隔符的 256 位成员表
+  };
+
+  SplitView() = default;
+  SplitView(std::string_view str, char delimiter) noexcept : str_(str), ch_(delimiter), mode_(Mode::Char) {}
+  SplitView(std::string_view str, std::string_view delimiter, Mode mode) noexcept
+      : str_(str), delimiter_(delimiter), mode_(mode) {}
+
+  [[nodiscard]] iterator begin() const { return iterator(str_, delimiter_, ch_, mode_); }
+  [[nodiscard]] iterator end() const noexcept { return iterator(); }
+
+ private:
+  std::string_view str_;
+  std::string_view delimiter_;
+  char ch_ = 0;
+  Mode mode_ = Mode::Char;
+};
+
+/**
+ * @brief 按单个字符惰性分割
+ * @param str       要分割的字符串
+ * @param delimiter 分隔字符
+ * @return 产生 std::string_view 的范围
+ * @note 调用方须保证 str 在遍历期间有效
+ */
+SplitView splitView(std::string_view str, char delimiter);
+
+/**
+ * @brief 按完整字符串分隔符惰性分割
+ * @param str       要分割的字符串
+ * @param delimiter 分隔字符串；为空时逐字符分割
+ * @return 产生 std::string_view 的范围
+ * @note 调用方须保证 str 与 delimiter 在遍历期间有效
+ */
+SplitView splitView(std::string_view str, std::string_view delimiter);
+
+/**
+ * @brief 按字符集合惰性分割
+ * @param str        要分割的字符串
+ * @param delimiters 分隔符字符集
+ * @return 产生 std::string_view 的范围
+ * @note 调用方须保证 str 与 delimiters 在遍历期间有效
+ */
+SplitView splitAnyOfView(std::string_view str, std::string_view delimiters);
 
 /**
  * @brief 使用字符分隔符连接字符串向量
@@ -214,7 +401,63 @@ std::string join(char glue, const std::vector<std::string>& pieces);
  * @param pieces 要连接的字符串向量
  * @return 连接后的字符串
  */
-std::string join(const std::string& glue, const std::vector<std::string>& pieces);
+std::string join(std::string_view glue, const std::vector<std::string>& pieces);
+
+namespace detail {
+
+// 先算出总长度一次性分配，再依次拷贝；pieces 会被遍历两次
+template <typename Range>
+std::string joinRange(std::string_view glue, const Range& pieces) {
+  std::string result;
+  size_t total = 0;
+  size_t count = 0;
+  for (const auto& piece : pieces) {
+    total += std::string_view(piece).size();
+    ++count;
+  }
+  if (count == 0) return result;
+  result.reserve(total + glue.size() * (count - 1));
+  bool first = true;
+  for (const auto& piece : pieces) {
+    if (!first) result.append(glue);
+    result.append(std::string_view(piece));
+    first = false;
+  }
+  return result;
+}
+
+template <typename Range>
+concept StringViewRange = std::ranges::forward_range<const Range> &&
+                          std::convertible_to<std::ranges::range_reference_t<const Range>, std::string_view>;
+
+}  // namespace detail
+
+/**
+ * @brief 使用字符分隔符连接任意字符串视图范围，如 std::vector<std::string_view> 或 splitView() 的结果
+ * @param glue   连接用的分隔字符
+ * @param pieces 元素可转换为 std::string_view 的前向范围
+ * @return 连接后的字符串
+ * @note 花括号列表无法推导 Range，join(',', {"a", "b"}) 仍只匹配 std::vector<std::string> 重载
+ */
+template <detail::StringViewRange Range>
+std::string join(char glue, const Range& pieces) {
+  return detail::joinRange(std::string_view(&glue, 1), pieces);
+}
+
+/**
+ * @brief 使用字符串分隔符连接任意字符串视图范围
+ * @param glue   连接用的分隔字符串
+ * @param pieces 元素可转换为 std::string_view 的前向范围
+ * @return 连接后的字符串
+ */
+template <detail::StringViewRange Range>
+std::string join(std::string_view glue, const Range& pieces) {
+  return detail::joinRange(glue, pieces);
+}
 
 }  // namespace utils
 }  // namespace pickup
+
+// 迭代器不引用 SplitView 对象，临时的 SplitView 也可安全地用于 std::ranges 算法
+template <>
+inline constexpr bool std::ranges::enable_borrowed_range<pickup::utils::SplitView> = true;
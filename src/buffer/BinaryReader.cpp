@@ -0,0 +1,92 @@
+#include "pickup/buffer/BinaryReader.h"
+
+#include <limits>
+
+namespace pickup {
+namespace buffer {
+
+bool BinaryReader::readVarint(uint64_t& value) {
+  if (failed_) {
+    return false;
+  }
+  uint64_t result = 0;
+  size_t i = 0;
+  for (int shift = 0; pos_ + i < size_; shift += 7) {
+    const Byte byte = data_[pos_ + i++];
+    // 第 10 字节只允许携带 1 个有效位，否则溢出 64 位
+    if (i == kMaxVarintBytes && byte > 1) {
+      break;
+    }
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      value = result;
+      pos_ += i;
+      return true;
+    }
+    if (i == kMaxVarintBytes) {
+      break;
+    }
+  }
+  failed_ = true;
+  return false;
+}
+
+bool BinaryReader::readVarint(uint32_t& value) {
+  const size_t start = pos_;
+  uint64_t wide = 0;
+  if (!readVarint(wide)) {
+    return false;
+  }
+  if (wide > std::numeric_limits<uint32_t>::max()) {
+    pos_ = start;
+    failed_ = true;
+    return false;
+  }
+  value = static_cast<uint32_t>(wide);
+  return true;
+}
+
+bool BinaryReader::readSignedVarint(int64_t& value) {
+  uint64_t raw = 0;
+  if (!readVarint(raw)) {
+    return false;
+  }
+  value = decodeZigZag(raw);
+  return true;
+}
+
+bool BinaryReader::readString(std::string_view& value) {
+  const size_t start = pos_;
+  uint64_t length = 0;
+  if (!readVarint(length)) {
+    return false;
+  }
+  if (length > remaining()) {
+    pos_ = start;
+    failed_ = true;
+    return false;
+  }
+  value = std::string_view(reinterpret_cast<const char*>(data_ + pos_), static_cast<size_t>(length));
+  pos_ += static_cast<size_t>(length);
+  return true;
+}
+
+bool BinaryReader::readRaw(std::string_view& value, size_t size) {
+  if (!require(size)) {
+    return false;
+  }
+  value = std::string_view(reinterpret_cast<const char*>(data_ + pos_), size);
+  pos_ += size;
+  return true;
+}
+
+bool BinaryReader::skip(size_t size) {
+  if (!require(size)) {
+    return false;
+  }
+  pos_ += size;
+  return true;
+}
+
+}  // namespace buffer
+}  // namespace pickup
@@ -0,0 +1,35 @@
+#include "pickup/buffer/BinaryWriter.h"
+
+namespace pickup {
+namespace buffer {
+
+void BinaryWriter::writeVarint(uint64_t value) {
+  if (value < 0x80) {
+    out_.append(static_cast<Byte>(value));
+    return;
+  }
+  if (out_.capacity() - out_.size() >= kMaxVarintBytes) {
+    // 直接编码进尾部空闲区，再截去多余部分（缩小 size 不会触发重分配）
+    const size_t start = out_.size();
+    const size_t n = encodeVarint(value, out_.appendWritable(kMaxVarintBytes));
+    out_.resize(start + n);
+    return;
+  }
+  // 尾部空间不足 10 字节时先编码到栈上，避免按最大长度取可写区而触发多余的扩容
+  Byte scratch[kMaxVarintBytes];
+  const size_t n = encodeVarint(value, scratch);
+  out_.append(scratch, scratch + n);
+}
+
+void BinaryWriter::writeString(std::string_view value) {
+  writeVarint(value.size());
+  out_.append(value);
+}
+
+void BinaryWriter::writeBytes(const Byte* data, size_t size) {
+  writeVarint(size);
+  out_.append(data, data + size);
+}
+
+}  // namespace buffer
+}  // namespace pickup
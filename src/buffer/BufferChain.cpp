@@ -0,0 +1,140 @@
+#include "pickup/buffer/BufferChain.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace pickup {
+namespace buffer {
+
+void BufferChain::append(ByteSlice slice) {
+  if (slice.empty()) {
+    return;
+  }
+  size_ += slice.size();
+  segments_.push_back(std::move(slice));
+}
+
+void BufferChain::append(BufferChain&& other) {
+  if (&other == this) {
+    return;
+  }
+  for (auto& segment : other.segments_) {
+    size_ += segment.size();
+    segments_.push_back(std::move(segment));
+  }
+  other.segments_.clear();
+  other.size_ = 0;
+}
+
+void BufferChain::prepend(ByteSlice slice) {
+  if (slice.empty()) {
+    return;
+  }
+  size_ += slice.size();
+  segments_.push_front(std::move(slice));
+}
+
+BufferChain BufferChain::cut(size_t n) {
+  BufferChain head;
+  n = std::min(n, size_);
+  while (n > 0) {
+    ByteSlice& front = segments_.front();
+    if (front.size() <= n) {
+      n -= front.size();
+      size_ -= front.size();
+      head.append(std::move(front));
+      segments_.pop_front();
+    } else {
+      // 边界落在段内：拆出前 n 字节，两部分共享同一存储
+      head.append(front.popFront(n));
+      size_ -= n;
+      n = 0;
+    }
+  }
+  return head;
+}
+
+void BufferChain::drain(size_t n) {
+  n = std::min(n, size_);
+  while (n > 0) {
+    ByteSlice& front = segments_.front();
+    if (front.size() <= n) {
+      n -= front.size();
+      size_ -= front.size();
+      segments_.pop_front();
+    } else {
+      front.removePrefix(n);
+      size_ -= n;
+      n = 0;
+    }
+  }
+}
+
+void BufferChain::clear() {
+  segments_.clear();
+  size_ = 0;
+  pendingReads_.clear();
+}
+
+size_t BufferChain::toIovec(IoVec* iov, size_t maxCount) const {
+  size_t count = 0;
+  for (const auto& segment : segments_) {
+    if (count == maxCount) {
+      break;
+    }
+    // writev 只读不写，去掉 const 仅为匹配 iovec 的字段类型
+    iov[count].iov_base = const_cast<Byte*>(segment.data());
+    iov[count].iov_len = segment.size();
+    ++count;
+  }
+  return count;
+}
+
+std::vector<IoVec> BufferChain::toIovec() const {
+  std::vector<IoVec> iov(segments_.size());
+  iov.resize(toIovec(iov.data(), iov.size()));
+  return iov;
+}
+
+std::vector<IoVec> BufferChain::prepareRead(size_t bytes, size_t blockSize) {
+  pendingReads_.clear();
+  blockSize = std::max<size_t>(blockSize, 1);
+  std::vector<IoVec> iov;
+  iov.reserve((bytes + blockSize - 1) / blockSize);
+  while (bytes > 0) {
+    const size_t len = std::min(bytes, blockSize);
+    ByteBuffer block;
+    block.reserve(len);
+    auto* ptr = block.appendWritable(len);
+    iov.push_back(IoVec{ptr, len});
+    pendingReads_.push_back(std::move(block));
+    bytes -= len;
+  }
+  return iov;
+}
+
+void BufferChain::commitRead(size_t bytes) {
+  for (auto& block : pendingReads_) {
+    if (bytes == 0) {
+      break;
+    }
+    const size_t len = std::min(bytes, block.size());
+    block.resize(len);
+    append(std::move(block));
+    bytes -= len;
+  }
+  pendingReads_.clear();
+}
+
+ByteBuffer BufferChain::flatten() const {
+  ByteBuffer out;
+  out.reserve(size_);
+  for (const auto& segment : segments_) {
+    out.append(segment.begin(), segment.end());
+  }
+  return out;
+}
+
+}  // namespace buffer
+}  // namespace pickup
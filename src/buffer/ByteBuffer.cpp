@@ -5,19 +5,6 @@ namespace buffer {
 
 constexpr size_t kMinAllocationSize = sizeof(size_t);
 
-static void deallocateBuffer(ByteBuffer::Byte* buffer) {
-  free(buffer);  // NOLINT(cppcoreguidelines-no-malloc)
-}
-
-static ByteBuffer::Byte* allocateBuffer(size_t size) {
-  if (size == 0) {
-    return nullptr;
-  }
-
-  return reinterpret_cast<ByteBuffer::Byte*>(
-      malloc(sizeof(ByteBuffer::Byte) * size));  // NOLINT(cppcoreguidelines-no-malloc)
-}
-
 // 计算下一个 2 的幂
 static size_t nextPowerOfTwo(size_t v) {
   v--;
@@ -44,19 +31,49 @@ static size_t growCapacity(size_t needed) noexcept {
   return std::max(needed + needed / 2u, kMinAllocationSize);
 }
 
+ByteBuffer::Byte* ByteBuffer::allocateBuffer(size_t size) const {
+  if (size == 0) {
+    return nullptr;
+  }
+  if (allocator_ != nullptr) {
+    return static_cast<Byte*>(allocator_->allocate(size));
+  }
+
+  return reinterpret_cast<ByteBuffer::Byte*>(
+      malloc(sizeof(ByteBuffer::Byte) * size));  // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+void ByteBuffer::deallocateBuffer(Byte* buffer, size_t size) const {
+  if (buffer == nullptr) {
+    return;
+  }
+  if (allocator_ != nullptr) {
+    allocator_->deallocate(buffer, size);
+    return;
+  }
+  free(buffer);  // NOLINT(cppcoreguidelines-no-malloc)
+}
+
 ByteBuffer::ByteBuffer() = default;
 
+ByteBuffer::ByteBuffer(ByteBufferAllocator* allocator) : allocator_(allocator) {}
+
 ByteBuffer::ByteBuffer(ByteBuffer&& other) noexcept
-    : size_(other.size_), capacity_(other.capacity_), data_(other.data_) {
+    : size_(other.size_),
+      capacity_(other.capacity_),
+      offset_(other.offset_),
+      data_(other.data_),
+      allocator_(other.allocator_) {
   other.size_ = 0;
   other.capacity_ = 0;
+  other.offset_ = 0;
   other.data_ = nullptr;
 }
 
-ByteBuffer::ByteBuffer(const ByteBuffer& other) {
+ByteBuffer::ByteBuffer(const ByteBuffer& other) : allocator_(other.allocator_) {
   if (other.size() != 0) {
     reallocate(other.size());
-    std::memcpy(data_, other.data(), other.size());
+    std::memcpy(data(), other.data(), other.size());
     size_ = other.size();
   }
 }
@@ -71,18 +88,21 @@ ByteBuffer::ByteBuffer(const char* nullTerminatedString) : ByteBuffer(std::strin
 
 ByteBuffer::ByteBuffer(const Byte* begin, const Byte* end) { set(begin, end); }
 
-ByteBuffer::~ByteBuffer() { deallocateBuffer(data_); }
+ByteBuffer::~ByteBuffer() { deallocateBuffer(data_, capacity_); }
 
 ByteBuffer& ByteBuffer::operator=(ByteBuffer&& other) noexcept {
   if (&other != this) {
-    deallocateBuffer(data_);
+    deallocateBuffer(data_, capacity_);
 
     size_ = other.size_;
     capacity_ = other.capacity_;
+    offset_ = other.offset_;
     data_ = other.data_;
+    allocator_ = other.allocator_;
 
     other.size_ = 0;
     other.capacity_ = 0;
+    other.offset_ = 0;
     other.data_ = nullptr;
   }
   return *this;
@@ -90,15 +110,17 @@ ByteBuffer& ByteBuffer::operator=(ByteBuffer&& other) noexcept {
 
 ByteBuffer& ByteBuffer::operator=(const ByteBuffer& other) {
   if (&other != this) {
-    deallocateBuffer(data_);
+    // 拷贝赋值只复制内容，保留自身的分配器
+    deallocateBuffer(data_, capacity_);
 
     size_ = 0;
     capacity_ = 0;
+    offset_ = 0;
     data_ = nullptr;
 
     if (other.size() != 0) {
       reallocate(other.size());
-      std::memcpy(data_, other.data(), other.size());
+      std::memcpy(data(), other.data(), other.size());
       size_ = other.size();
     }
   }
@@ -113,30 +135,36 @@ bool ByteBuffer::operator==(const ByteBuffer& other) const {
   if (size_ == 0) {
     return true;
   }
-  return std::memcmp(data_, other.data_, size_) == 0;
+  return std::memcmp(data(), other.data(), size_) == 0;
 }
 
 bool ByteBuffer::operator!=(const ByteBuffer& other) const { return !(*this == other); }
 
-void ByteBuffer::clear() { size_ = 0; }
+void ByteBuffer::clear() {
+  size_ = 0;
+  offset_ = 0;
+}
 
 void ByteBuffer::reserve(size_t capacity) {
-  if (capacity > capacity_) {
-    reallocate(capacity);
+  if (capacity > capacity_ - offset_) {
+    // 已 shift 的前缀足以腾出空间且压缩代价不超过数据量时就地压缩，否则按需扩容
+    if (capacity <= capacity_ && offset_ >= size_) {
+      compact();
+    } else {
+      reallocate(capacity);
+    }
   }
 }
 
 ByteBuffer::Byte* ByteBuffer::appendWritable(size_t size) {
   if (size == 0) {
-    return data_ + size_;
+    return data() + size_;
   }
 
   auto nextSize = size_ + size;
-  if (nextSize > capacity_) {
-    reallocate(growCapacity(nextSize));
-  }
+  ensureRoom(nextSize);
 
-  auto* ptr = data_ + size_;
+  auto* ptr = data() + size_;
   size_ = nextSize;
   return ptr;
 }
@@ -171,51 +199,77 @@ void ByteBuffer::set(const Byte* begin, const Byte* end) {
     if (size > capacity_) {
       reallocate(size);
     }
-    std::memcpy(data_, begin, size);
+    std::memcpy(data(), begin, size);
     size_ = size;
   }
 }
 
 void ByteBuffer::resize(size_t size) {
   auto oldSize = size_;
-  if (size > capacity_) {
-    reallocate(size);
+  if (size > capacity()) {
+    reserve(size);
   }
   if (size > oldSize) {
-    std::memset(data_ + oldSize, 0, size - oldSize);
+    std::memset(data() + oldSize, 0, size - oldSize);
   }
   size_ = size;
 }
 
 void ByteBuffer::shift(size_t size) {
   if (size >= size_) {
+    // 全部消费：偏移归零，整块容量可直接复用
     size_ = 0;
+    offset_ = 0;
+    return;
+  }
+
+  offset_ += size;
+  size_ -= size;
+}
+
+void ByteBuffer::ensureRoom(size_t needed) {
+  if (offset_ + needed <= capacity_) {
     return;
   }
+  // 前缀不小于剩余数据时 memmove 的代价可由此前的消费摊销；否则扩容时只拷贝有效数据
+  if (needed <= capacity_ && offset_ >= size_) {
+    compact();
+  } else {
+    reallocate(growCapacity(needed));
+  }
+}
 
-  auto newSize = size_ - size;
-  std::memmove(data_, data_ + size, newSize);
-  size_ = newSize;
+void ByteBuffer::compact() {
+  if (offset_ == 0) {
+    return;
+  }
+  if (size_ > 0) {
+    std::memmove(data_, data_ + offset_, size_);
+  }
+  offset_ = 0;
 }
 
 void ByteBuffer::reallocate(size_t capacity) {
+  if (allocator_ != nullptr && capacity > 0) {
+    capacity = allocator_->goodSize(capacity);
+  }
   auto* newData = allocateBuffer(capacity);
 
-  if (newData != nullptr && data_ != nullptr) {
-    std::memcpy(newData, data_, std::min(capacity_, capacity));
+  if (size_ > capacity) {
+    size_ = capacity;
+  }
+  if (newData != nullptr && data_ != nullptr && size_ > 0) {
+    std::memcpy(newData, data_ + offset_, size_);
   }
 
-  deallocateBuffer(data_);
+  deallocateBuffer(data_, capacity_);
   capacity_ = capacity;
+  offset_ = 0;
   data_ = newData;
-
-  if (size_ > capacity_) {
-    size_ = capacity_;
-  }
 }
 
 void ByteBuffer::shrinkToFit() {
-  if (capacity_ != size_) {
+  if (capacity() != size_ || offset_ != 0) {
     reallocate(size_);
   }
 }
@@ -228,7 +282,7 @@ std::vector<uint8_t> ByteBuffer::toBytesVec() const {
 }
 
 std::string_view ByteBuffer::toStringView() const {
-  return std::string_view(reinterpret_cast<const char*>(data_), size_);
+  return std::string_view(reinterpret_cast<const char*>(data()), size_);
 }
 
 }  // namespace buffer
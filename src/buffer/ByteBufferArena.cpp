@@ -0,0 +1,111 @@
+#include "pickup/buffer/ByteBufferArena.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace pickup {
+namespace buffer {
+
+namespace {
+
+size_t alignUp(size_t size) {
+  return (size + ByteBufferArena::kAlignment - 1) & ~(ByteBufferArena::kAlignment - 1);
+}
+
+char* allocateChunk(size_t size) {
+  auto* data = static_cast<char*>(std::malloc(size));  // NOLINT(cppcoreguidelines-no-malloc)
+  if (data == nullptr) {
+    throw std::bad_alloc();
+  }
+  return data;
+}
+
+}  // namespace
+
+ByteBufferArena::ByteBufferArena(size_t chunkSize) : chunkSize_(alignUp(std::max(chunkSize, kAlignment))) {}
+
+ByteBufferArena::~ByteBufferArena() {
+  for (const auto& chunk : chunks_) {
+    std::free(chunk.data);  // NOLINT(cppcoreguidelines-no-malloc)
+  }
+  for (const auto& chunk : large_) {
+    std::free(chunk.data);  // NOLINT(cppcoreguidelines-no-malloc)
+  }
+}
+
+ByteBuffer ByteBufferArena::acquire(size_t capacity) {
+  ByteBuffer buffer(this);
+  if (capacity > 0) {
+    buffer.reserve(capacity);
+  }
+  return buffer;
+}
+
+size_t ByteBufferArena::goodSize(size_t size) const { return alignUp(size); }
+
+void ByteBufferArena::newChunk() {
+  chunks_.push_back(Chunk{allocateChunk(chunkSize_), chunkSize_});
+  reserved_ += chunkSize_;
+  cursor_ = chunks_.back().data;
+  limit_ = cursor_ + chunkSize_;
+}
+
+void* ByteBufferArena::allocate(size_t size) {
+  size = alignUp(size);
+  if (size > chunkSize_ / 2) {
+    // 大分配单独成块，避免浪费当前块的剩余空间
+    large_.push_back(Chunk{allocateChunk(size), size});
+    reserved_ += size;
+    used_ += size;
+    return large_.back().data;
+  }
+  if (static_cast<size_t>(limit_ - cursor_) < size) {
+    newChunk();
+  }
+  char* ptr = cursor_;
+  cursor_ += size;
+  used_ += size;
+  return ptr;
+}
+
+void ByteBufferArena::deallocate(void* ptr, size_t size) {
+  size = alignUp(size);
+  auto* bytes = static_cast<char*>(ptr);
+  if (size > chunkSize_ / 2) {
+    // 单独成块的大分配可立即归还系统
+    auto it = std::find_if(large_.begin(), large_.end(), [bytes](const Chunk& chunk) { return chunk.data == bytes; });
+    if (it != large_.end()) {
+      std::free(it->data);  // NOLINT(cppcoreguidelines-no-malloc)
+      reserved_ -= it->size;
+      used_ -= it->size;
+      large_.erase(it);
+    }
+    return;
+  }
+  if (bytes + size == cursor_) {
+    // 最近一次分配：回退指针
+    cursor_ = bytes;
+    used_ -= size;
+  }
+}
+
+void ByteBufferArena::reset() {
+  for (const auto& chunk : large_) {
+    std::free(chunk.data);  // NOLINT(cppcoreguidelines-no-malloc)
+  }
+  large_.clear();
+  for (size_t i = 1; i < chunks_.size(); ++i) {
+    std::free(chunks_[i].data);  // NOLINT(cppcoreguidelines-no-malloc)
+  }
+  if (chunks_.size() > 1) {
+    chunks_.resize(1);
+  }
+  reserved_ = chunks_.empty() ? 0 : chunkSize_;
+  used_ = 0;
+  cursor_ = chunks_.empty() ? nullptr : chunks_.front().data;
+  limit_ = chunks_.empty() ? nullptr : cursor_ + chunkSize_;
+}
+
+}  // namespace buffer
+}  // namespace pickup
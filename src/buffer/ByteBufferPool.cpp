@@ -0,0 +1,270 @@
+#include "pickup/buffer/ByteBufferPool.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace pickup {
+namespace buffer {
+
+namespace detail {
+
+enum Counter : size_t { kHits, kMisses, kRecycled, kReleased, kCounterCount };
+
+// 一个线程对一个池的计数；独占缓存行，只由持有它的线程写入
+struct alignas(64) PoolCounters {
+  std::array<std::atomic<uint64_t>, kCounterCount> values{};
+
+  void bump(Counter c) noexcept {
+    // 单一写者，无需原子读改写；并发的 stats() 只做 relaxed 读取
+    values[c].store(values[c].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+};
+
+// 池的全部计数分片。线程缓存与池共同持有，池先析构时线程仍可安全归还分片；
+// 退出线程归还的分片保留累计值并交给后来的线程继续使用，分片数不超过同时活跃的线程数
+struct PoolStatsShards {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<PoolCounters>> all;
+  std::vector<PoolCounters*> idle;
+  PoolCounters orphan;          // 线程缓存已析构时（线程退出过程中）使用，以原子加计数
+  ByteBufferPoolStats baseline;  // resetStats() 时的汇总值
+
+  PoolCounters* acquire() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!idle.empty()) {
+      PoolCounters* counters = idle.back();
+      idle.pop_back();
+      return counters;
+    }
+    all.push_back(std::make_unique<PoolCounters>());
+    return all.back().get();
+  }
+
+  void release(PoolCounters* counters) {
+    std::lock_guard<std::mutex> lock(mutex);
+    idle.push_back(counters);
+  }
+
+  // 调用方须持有 mutex
+  ByteBufferPoolStats sum() const {
+    std::array<uint64_t, kCounterCount> totals{};
+    for (size_t c = 0; c < kCounterCount; ++c) {
+      totals[c] = orphan.values[c].load(std::memory_order_relaxed);
+      for (const auto& counters : all) totals[c] += counters->values[c].load(std::memory_order_relaxed);
+    }
+    ByteBufferPoolStats stats;
+    stats.hits = totals[kHits];
+    stats.misses = totals[kMisses];
+    stats.recycled = totals[kRecycled];
+    stats.released = totals[kReleased];
+    return stats;
+  }
+};
+
+}  // namespace detail
+
+namespace {
+
+using detail::Counter;
+using detail::PoolCounters;
+using detail::PoolStatsShards;
+using FreeLists = std::vector<std::vector<void*>>;  // 按级别下标
+
+// 一个线程中某个池的缓存：各级别空闲链表与本线程的计数分片
+struct PoolCache {
+  FreeLists lists;
+  PoolCounters* counters = nullptr;
+  std::shared_ptr<PoolStatsShards> shards;
+
+  PoolCache() = default;
+  PoolCache(const PoolCache&) = delete;
+  PoolCache& operator=(const PoolCache&) = delete;
+
+  ~PoolCache() {
+    for (auto& list : lists) {
+      for (void* block : list) {
+        std::free(block);  // NOLINT(cppcoreguidelines-no-malloc)
+      }
+    }
+    if (counters != nullptr) {
+      shards->release(counters);
+    }
+  }
+};
+
+// 每个线程一份：池 id -> 该池在本线程的缓存
+struct ThreadCache {
+  std::unordered_map<uint64_t, PoolCache> pools;
+  uint64_t lastId = 0;              // 最近访问的池，省去大多数情况下的哈希查找
+  PoolCache* lastCache = nullptr;   // unordered_map 节点地址稳定
+
+  ~ThreadCache();
+
+  PoolCache& cacheFor(uint64_t id, size_t classCount, const std::shared_ptr<PoolStatsShards>& shards) {
+    if (lastCache != nullptr && lastId == id) {
+      return *lastCache;
+    }
+    PoolCache& cache = pools[id];
+    if (cache.counters == nullptr) {
+      cache.lists.resize(classCount);
+      cache.shards = shards;
+      cache.counters = shards->acquire();
+    }
+    lastId = id;
+    lastCache = &cache;
+    return cache;
+  }
+
+  void drop(uint64_t id) {
+    auto it = pools.find(id);
+    if (it == pools.end()) {
+      return;
+    }
+    if (lastCache == &it->second) {
+      lastCache = nullptr;
+    }
+    pools.erase(it);
+  }
+};
+
+// 平凡析构，线程退出过程中 ThreadCache 析构之后仍可安全读取
+thread_local bool tCacheAlive = false;
+thread_local ThreadCache tCache;
+
+// 各 PoolCache 随 pools 析构时释放缓存的块并归还计数分片
+ThreadCache::~ThreadCache() { tCacheAlive = false; }
+
+ThreadCache* threadCache() {
+  // 首次访问 tCache 时构造并登记析构；析构后 tCacheAlive 保持 false
+  static thread_local bool initialized = false;
+  if (!initialized) {
+    initialized = true;
+    tCacheAlive = true;
+    (void)tCache;
+  }
+  return tCacheAlive ? &tCache : nullptr;
+}
+
+// 线程缓存不可用时退回共享分片上的原子加，只在线程退出过程中发生
+void record(PoolCache* local, PoolStatsShards& shards, Counter c) {
+  if (local != nullptr) {
+    local->counters->bump(c);
+  } else {
+    shards.orphan.values[c].fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+std::atomic<uint64_t> gNextPoolId{1};
+
+}  // namespace
+
+ByteBufferPool::ByteBufferPool() : ByteBufferPool(ByteBufferPoolOptions{}) {}
+
+ByteBufferPool::ByteBufferPool(const ByteBufferPoolOptions& options)
+    : id_(gNextPoolId.fetch_add(1, std::memory_order_relaxed)),
+      maxCachedPerClass_(options.maxCachedPerClass),
+      shards_(std::make_shared<PoolStatsShards>()) {
+  if (options.minBlockSize == 0 || options.minBlockSize > options.maxBlockSize) {
+    throw std::invalid_argument("ByteBufferPool: invalid block size range");
+  }
+  minShift_ = static_cast<size_t>(std::bit_width(std::bit_ceil(options.minBlockSize)) - 1);
+  const auto maxShift = static_cast<size_t>(std::bit_width(std::bit_ceil(options.maxBlockSize)) - 1);
+  classCount_ = maxShift - minShift_ + 1;
+}
+
+ByteBufferPool::~ByteBufferPool() { trimThreadCache(); }
+
+ByteBufferPool& ByteBufferPool::global() {
+  // 故意泄漏：其它线程的缓存与静态对象中的 ByteBuffer 可能在进程退出时仍引用它
+  static auto* pool = new ByteBufferPool();
+  return *pool;
+}
+
+ByteBuffer ByteBufferPool::acquire(size_t capacity) {
+  ByteBuffer buffer(this);
+  if (capacity > 0) {
+    buffer.reserve(capacity);
+  }
+  return buffer;
+}
+
+size_t ByteBufferPool::classOf(size_t size) const {
+  if (size <= (size_t{1} << minShift_)) {
+    return 0;
+  }
+  const auto shift = static_cast<size_t>(std::bit_width(size - 1));
+  return std::min(shift - minShift_, classCount_);
+}
+
+size_t ByteBufferPool::goodSize(size_t size) const {
+  const size_t index = classOf(size);
+  return index < classCount_ ? size_t{1} << (minShift_ + index) : size;
+}
+
+void* ByteBufferPool::allocate(size_t size) {
+  const size_t index = classOf(size);
+  ThreadCache* cache = threadCache();
+  PoolCache* local = cache != nullptr ? &cache->cacheFor(id_, classCount_, shards_) : nullptr;
+  if (index < classCount_) {
+    if (local != nullptr) {
+      auto& list = local->lists[index];
+      if (!list.empty()) {
+        void* block = list.back();
+        list.pop_back();
+        local->counters->bump(detail::kHits);
+        return block;
+      }
+    }
+    // 按级别大小申请，保证归还后可被同级别的任何请求复用
+    size = size_t{1} << (minShift_ + index);
+  }
+  record(local, *shards_, detail::kMisses);
+  return std::malloc(size);  // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+void ByteBufferPool::deallocate(void* ptr, size_t size) {
+  const size_t index = classOf(size);
+  ThreadCache* cache = threadCache();
+  PoolCache* local = cache != nullptr ? &cache->cacheFor(id_, classCount_, shards_) : nullptr;
+  if (index < classCount_ && local != nullptr) {
+    auto& list = local->lists[index];
+    if (list.size() < maxCachedPerClass_) {
+      list.push_back(ptr);
+      local->counters->bump(detail::kRecycled);
+      return;
+    }
+  }
+  record(local, *shards_, detail::kReleased);
+  std::free(ptr);  // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+void ByteBufferPool::trimThreadCache() {
+  if (ThreadCache* cache = threadCache()) {
+    cache->drop(id_);
+  }
+}
+
+ByteBufferPoolStats ByteBufferPool::stats() const {
+  std::lock_guard<std::mutex> lock(shards_->mutex);
+  ByteBufferPoolStats stats = shards_->sum();
+  const ByteBufferPoolStats& base = shards_->baseline;
+  stats.hits -= base.hits;
+  stats.misses -= base.misses;
+  stats.recycled -= base.recycled;
+  stats.released -= base.released;
+  return stats;
+}
+
+void ByteBufferPool::resetStats() {
+  std::lock_guard<std::mutex> lock(shards_->mutex);
+  shards_->baseline = shards_->sum();
+}
+
+}  // namespace buffer
+}  // namespace pickup
@@ -0,0 +1,43 @@
+#include "pickup/buffer/ByteSlice.h"
+
+#include <algorithm>
+
+namespace pickup {
+namespace buffer {
+
+ByteSlice::ByteSlice(ByteBuffer&& buffer) {
+  if (buffer.empty()) {
+    return;
+  }
+  // 移动构造只转移指针，数据本身不拷贝
+  owner_ = std::make_shared<const ByteBuffer>(std::move(buffer));
+  data_ = owner_->data();
+  size_ = owner_->size();
+}
+
+ByteSlice ByteSlice::copyOf(std::string_view bytes) { return ByteSlice(ByteBuffer(bytes)); }
+
+ByteSlice ByteSlice::slice(size_t offset, size_t length) const {
+  if (offset >= size_) {
+    return {};
+  }
+  return {owner_, data_ + offset, std::min(length, size_ - offset)};
+}
+
+ByteSlice ByteSlice::popFront(size_t n) {
+  n = std::min(n, size_);
+  ByteSlice head(owner_, data_, n);
+  removePrefix(n);
+  return head;
+}
+
+void ByteSlice::removePrefix(size_t n) {
+  n = std::min(n, size_);
+  data_ += n;
+  size_ -= n;
+}
+
+void ByteSlice::removeSuffix(size_t n) { size_ -= std::min(n, size_); }
+
+}  // namespace buffer
+}  // namespace pickup
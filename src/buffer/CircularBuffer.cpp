@@ -17,12 +17,27 @@ bool CircularBuffer::allocate(size_t buffer_size) {
   return buffer_ != nullptr;
 }
 
+bool CircularBuffer::allocateMirrored(size_t buffer_size) {
+  assert(buffer_ == nullptr);
+
+  if (!mirror_.allocate(buffer_size)) {
+    return allocate(buffer_size);
+  }
+  size_ = mirror_.size();
+  buffer_ = mirror_.data();
+  return true;
+}
+
 void CircularBuffer::deallocate() {
-  if (buffer_ != nullptr) {
+  if (mirrored()) {
+    mirror_.release();
+  } else if (buffer_ != nullptr) {
     delete[] buffer_;
-    buffer_ = nullptr;
   }
+  buffer_ = nullptr;
   size_ = 0;
+  start_ = 0;
+  end_ = 0;
 }
 
 size_t CircularBuffer::available() const {
@@ -50,6 +65,16 @@ bool CircularBuffer::write(const uint8_t* buf, size_t buf_len) {
     return false;
   }
 
+  if (mirrored()) {
+    // 双重映射：end_ 之后 size_ 字节内地址连续，无需拆分
+    if (available() < buf_len) {
+      return false;
+    }
+    memcpy(&buffer_[end_], buf, buf_len);
+    end_ = advance(end_, buf_len);
+    return true;
+  }
+
   if (start_ > end_) {
     // 在 end_ 后添加数据直到 start_ 前，无回绕
     // 预留一个字节空间，避免 start_ 与 end_ 相等（空缓冲区判定）
@@ -99,6 +124,13 @@ size_t CircularBuffer::read(uint8_t* buf, size_t buf_max_len) {
     return 0;
   }
 
+  if (mirrored()) {
+    const size_t to_copy_len = std::min(used(), buf_max_len);
+    memcpy(buf, &buffer_[start_], to_copy_len);
+    start_ = advance(start_, to_copy_len);
+    return to_copy_len;
+  }
+
   if (start_ < end_) {
     // 无回绕情况
     size_t to_copy_len = std::min(end_ - start_, buf_max_len);
@@ -133,5 +165,27 @@ size_t CircularBuffer::read(uint8_t* buf, size_t buf_max_len) {
   }
 }
 
+std::span<const uint8_t> CircularBuffer::peek() const {
+  if (mirrored() || start_ <= end_) {
+    return {buffer_ + start_, used()};
+  }
+  return {buffer_ + start_, size_ - start_};
+}
+
+void CircularBuffer::consume(size_t n) { start_ = advance(start_, std::min(n, used())); }
+
+std::span<uint8_t> CircularBuffer::prepareWrite() {
+  if (buffer_ == nullptr) {
+    return {};
+  }
+  if (mirrored() || start_ > end_) {
+    return {buffer_ + end_, available()};
+  }
+  // 无回绕时可写到分配区末尾；读位置在起点时须为"满"预留最后 1 字节
+  return {buffer_ + end_, std::min(size_ - end_, available())};
+}
+
+void CircularBuffer::commitWrite(size_t n) { end_ = advance(end_, n); }
+
 }  // namespace buffer
 }  // namespace pickup
\ No newline at end of file
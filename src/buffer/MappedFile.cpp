@@ -0,0 +1,254 @@
+#include "pickup/buffer/MappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace pickup {
+namespace buffer {
+
+#if !defined(_WIN32)
+
+namespace {
+
+size_t pageSize() {
+  static const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  return page;
+}
+
+int toMadvise(MappedFile::Advice advice) {
+  switch (advice) {
+    case MappedFile::Advice::Sequential:
+      return MADV_SEQUENTIAL;
+    case MappedFile::Advice::Random:
+      return MADV_RANDOM;
+    case MappedFile::Advice::WillNeed:
+      return MADV_WILLNEED;
+    case MappedFile::Advice::DontNeed:
+      return MADV_DONTNEED;
+    case MappedFile::Advice::Normal:
+    default:
+      return MADV_NORMAL;
+  }
+}
+
+}  // namespace
+
+#endif
+
+MappedFile::~MappedFile() { close(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : fd_(std::exchange(other.fd_, -1)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      capacity_(std::exchange(other.capacity_, 0)),
+      open_(std::exchange(other.open_, false)),
+      writable_(std::exchange(other.writable_, false)),
+      fallback_(std::move(other.fallback_)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (&other != this) {
+    close();
+    fd_ = std::exchange(other.fd_, -1);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    capacity_ = std::exchange(other.capacity_, 0);
+    open_ = std::exchange(other.open_, false);
+    writable_ = std::exchange(other.writable_, false);
+    fallback_ = std::move(other.fallback_);
+  }
+  return *this;
+}
+
+bool MappedFile::openRead(const std::string& path) {
+  close();
+#if !defined(_WIN32)
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    return false;
+  }
+  const auto size = static_cast<size_t>(st.st_size);
+  if (size > 0) {
+    void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      ::close(fd);
+      return false;
+    }
+    data_ = static_cast<uint8_t*>(addr);
+  }
+  // 映射自身持有对文件的引用，描述符可以立即关闭
+  ::close(fd);
+  size_ = size;
+  capacity_ = size;
+#else
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  file.seekg(0, std::ios::end);
+  const auto size = static_cast<size_t>(file.tellg());
+  file.seekg(0, std::ios::beg);
+  fallback_.resize(size);
+  file.read(reinterpret_cast<char*>(fallback_.data()), static_cast<std::streamsize>(size));
+  data_ = fallback_.data();
+  size_ = size;
+  capacity_ = size;
+#endif
+  open_ = true;
+  return true;
+}
+
+bool MappedFile::openAppend(const std::string& path, size_t initialCapacity) {
+  close();
+#if !defined(_WIN32)
+  fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd_ < 0) {
+    return false;
+  }
+  struct stat st {};
+  if (::fstat(fd_, &st) != 0) {
+    ::close(fd_);
+    fd_ = -1;
+    return false;
+  }
+  open_ = true;
+  writable_ = true;
+  size_ = static_cast<size_t>(st.st_size);
+  if (!grow(std::max({initialCapacity, size_, size_t{1}}))) {
+    close();
+    return false;
+  }
+  return true;
+#else
+  (void)path;
+  (void)initialCapacity;
+  return false;
+#endif
+}
+
+bool MappedFile::grow(size_t needed) {
+#if !defined(_WIN32)
+  const size_t page = pageSize();
+  size_t capacity = std::max(needed, capacity_ * 2);
+  capacity = (capacity + page - 1) / page * page;
+
+  if (::ftruncate(fd_, static_cast<off_t>(capacity)) != 0) {
+    return false;
+  }
+  void* addr = MAP_FAILED;
+#if defined(__linux__)
+  if (data_ != nullptr) {
+    // 在原处扩展或由内核整体搬移映射，不经过用户态拷贝
+    addr = ::mremap(data_, capacity_, capacity, MREMAP_MAYMOVE);
+  } else {
+    addr = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  }
+#else
+  if (data_ != nullptr) {
+    ::munmap(data_, capacity_);
+    data_ = nullptr;
+  }
+  addr = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+#endif
+  if (addr == MAP_FAILED) {
+    return false;
+  }
+  data_ = static_cast<uint8_t*>(addr);
+  capacity_ = capacity;
+  return true;
+#else
+  (void)needed;
+  return false;
+#endif
+}
+
+bool MappedFile::append(const void* data, size_t len) {
+  if (!writable_) {
+    return false;
+  }
+  if (len == 0) {
+    return true;
+  }
+  if (size_ + len > capacity_ && !grow(size_ + len)) {
+    return false;
+  }
+  std::memcpy(data_ + size_, data, len);
+  size_ += len;
+  return true;
+}
+
+bool MappedFile::advise(Advice advice, size_t offset, size_t length) {
+#if !defined(_WIN32)
+  if (data_ == nullptr || offset >= capacity_) {
+    return false;
+  }
+  // madvise 要求起始地址页对齐
+  const size_t alignedOffset = offset / pageSize() * pageSize();
+  const size_t end = length == npos ? capacity_ : std::min(capacity_, offset + length);
+  return ::madvise(data_ + alignedOffset, end - alignedOffset, toMadvise(advice)) == 0;
+#else
+  (void)advice;
+  (void)offset;
+  (void)length;
+  return false;
+#endif
+}
+
+bool MappedFile::sync(bool async) {
+#if !defined(_WIN32)
+  if (!writable_ || data_ == nullptr) {
+    return false;
+  }
+  return ::msync(data_, capacity_, async ? MS_ASYNC : MS_SYNC) == 0;
+#else
+  (void)async;
+  return false;
+#endif
+}
+
+void MappedFile::unmap() {
+#if !defined(_WIN32)
+  if (data_ != nullptr && fallback_.empty()) {
+    ::munmap(data_, capacity_);
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  capacity_ = 0;
+}
+
+void MappedFile::close() {
+  const size_t size = size_;
+  unmap();
+#if !defined(_WIN32)
+  if (fd_ >= 0) {
+    // 去掉为扩容预留的尾部空间，文件长度与实际写入一致
+    if (writable_) {
+      (void)::ftruncate(fd_, static_cast<off_t>(size));
+    }
+    ::close(fd_);
+    fd_ = -1;
+  }
+#endif
+  fallback_.clear();
+  open_ = false;
+  writable_ = false;
+}
+
+}  // namespace buffer
+}  // namespace pickup
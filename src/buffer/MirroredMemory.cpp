@@ -0,0 +1,85 @@
+#include "pickup/buffer/MirroredMemory.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(SYS_memfd_create)
+#define PICKUP_HAS_MEMFD 1
+#else
+#define PICKUP_HAS_MEMFD 0
+#endif
+
+namespace pickup {
+namespace buffer {
+
+MirroredMemory::~MirroredMemory() { release(); }
+
+bool MirroredMemory::supported() { return PICKUP_HAS_MEMFD != 0; }
+
+size_t MirroredMemory::pageSize() {
+#if defined(__linux__)
+  static const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  return page;
+#else
+  return 4096;
+#endif
+}
+
+bool MirroredMemory::allocate(size_t size) {
+  release();
+#if PICKUP_HAS_MEMFD
+  if (size == 0) {
+    return false;
+  }
+  const size_t page = pageSize();
+  size = (size + page - 1) / page * page;
+
+  // 直接走系统调用，不依赖 glibc 2.27 才提供的 memfd_create 包装
+  const int fd = static_cast<int>(::syscall(SYS_memfd_create, "pickup-ring", 1u /* MFD_CLOEXEC */));
+  if (fd < 0) {
+    return false;
+  }
+  if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    ::close(fd);
+    return false;
+  }
+
+  // 先占住 2 * size 的连续地址，再把同一个 fd 覆盖映射到前后两半
+  void* base = ::mmap(nullptr, size * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED) {
+    ::close(fd);
+    return false;
+  }
+  auto* bytes = static_cast<uint8_t*>(base);
+  void* lower = ::mmap(bytes, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+  void* upper = ::mmap(bytes + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+  ::close(fd);  // 映射持有对 memfd 的引用
+  if (lower != bytes || upper != bytes + size) {
+    ::munmap(base, size * 2);
+    return false;
+  }
+
+  data_ = bytes;
+  size_ = size;
+  return true;
+#else
+  (void)size;
+  return false;
+#endif
+}
+
+void MirroredMemory::release() {
+#if PICKUP_HAS_MEMFD
+  if (data_ != nullptr) {
+    ::munmap(data_, size_ * 2);
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+}
+
+}  // namespace buffer
+}  // namespace pickup
@@ -0,0 +1,104 @@
+#include "pickup/buffer/SPSCByteRing.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace pickup {
+namespace buffer {
+
+SPSCByteRing::SPSCByteRing(size_t capacity)
+    : capacity_(std::bit_ceil(std::max<size_t>(capacity, 1))),
+      mask_(capacity_ - 1),
+      buffer_(new uint8_t[capacity_]) {}
+
+SPSCByteRing::~SPSCByteRing() { delete[] buffer_; }
+
+size_t SPSCByteRing::used() const {
+  // 先读 tail 再读 head，保证 head - tail 不会因并发推进而下溢
+  const size_t tail = tail_.load(std::memory_order_acquire);
+  const size_t head = head_.load(std::memory_order_acquire);
+  return head - tail;
+}
+
+size_t SPSCByteRing::writableFrom(size_t head, size_t needed) {
+  size_t space = capacity_ - (head - cachedTail_);
+  if (space < needed) {
+    cachedTail_ = tail_.load(std::memory_order_acquire);
+    space = capacity_ - (head - cachedTail_);
+  }
+  return space;
+}
+
+size_t SPSCByteRing::readableFrom(size_t tail, size_t needed) {
+  size_t ready = cachedHead_ - tail;
+  // 未经 peek() 直接 consume() 时缓存的写位置可能落后于读位置，差值回绕为极大值
+  if (ready < needed || ready > capacity_) {
+    cachedHead_ = head_.load(std::memory_order_acquire);
+    ready = cachedHead_ - tail;
+  }
+  return ready;
+}
+
+bool SPSCByteRing::write(const uint8_t* buf, size_t buf_len) {
+  if (buf == nullptr || buf_len == 0) {
+    return false;
+  }
+  const size_t head = head_.load(std::memory_order_relaxed);
+  if (writableFrom(head, buf_len) < buf_len) {
+    return false;
+  }
+
+  const size_t offset = index(head);
+  const size_t firstLen = std::min(buf_len, capacity_ - offset);
+  std::memcpy(buffer_ + offset, buf, firstLen);
+  std::memcpy(buffer_, buf + firstLen, buf_len - firstLen);
+
+  head_.store(head + buf_len, std::memory_order_release);
+  return true;
+}
+
+SPSCByteRing::WriteSpans SPSCByteRing::prepareWrite(size_t max_len) {
+  const size_t head = head_.load(std::memory_order_relaxed);
+  const size_t len = std::min(writableFrom(head, max_len), max_len);
+
+  const size_t offset = index(head);
+  const size_t firstLen = std::min(len, capacity_ - offset);
+  return {{buffer_ + offset, firstLen}, {buffer_, len - firstLen}};
+}
+
+void SPSCByteRing::commitWrite(size_t n) {
+  head_.store(head_.load(std::memory_order_relaxed) + n, std::memory_order_release);
+}
+
+size_t SPSCByteRing::read(uint8_t* buf, size_t max_buf_len) {
+  if (buf == nullptr) {
+    return 0;
+  }
+  const ReadSpans spans = peek(max_buf_len);
+  if (spans.empty()) {
+    return 0;
+  }
+  std::memcpy(buf, spans.first.data(), spans.first.size());
+  if (!spans.second.empty()) {
+    std::memcpy(buf + spans.first.size(), spans.second.data(), spans.second.size());
+  }
+  consume(spans.size());
+  return spans.size();
+}
+
+SPSCByteRing::ReadSpans SPSCByteRing::peek(size_t max_len) {
+  const size_t tail = tail_.load(std::memory_order_relaxed);
+  const size_t len = std::min(readableFrom(tail, max_len), max_len);
+
+  const size_t offset = index(tail);
+  const size_t firstLen = std::min(len, capacity_ - offset);
+  return {{buffer_ + offset, firstLen}, {buffer_, len - firstLen}};
+}
+
+void SPSCByteRing::consume(size_t n) {
+  tail_.store(tail_.load(std::memory_order_relaxed) + n, std::memory_order_release);
+}
+
+}  // namespace buffer
+}  // namespace pickup
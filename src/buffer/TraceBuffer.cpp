@@ -0,0 +1,131 @@
+#include "pickup/buffer/TraceBuffer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+namespace pickup {
+namespace buffer {
+
+TraceBuffer::TraceBuffer(size_t capacity, Mode mode)
+    : capacity_(std::bit_ceil(std::max<size_t>(capacity, 16))),
+      mask_(capacity_ - 1),
+      mode_(mode),
+      buffer_(new uint8_t[capacity_]) {}
+
+TraceBuffer::~TraceBuffer() { delete[] buffer_; }
+
+void TraceBuffer::copyIn(uint64_t pos, const void* data, size_t len) {
+  const auto offset = static_cast<size_t>(pos & mask_);
+  const size_t firstLen = std::min(len, capacity_ - offset);
+  std::memcpy(buffer_ + offset, data, firstLen);
+  std::memcpy(buffer_, static_cast<const uint8_t*>(data) + firstLen, len - firstLen);
+}
+
+void TraceBuffer::copyOut(uint64_t pos, void* out, size_t len) const {
+  const auto offset = static_cast<size_t>(pos & mask_);
+  const size_t firstLen = std::min(len, capacity_ - offset);
+  std::memcpy(out, buffer_ + offset, firstLen);
+  std::memcpy(static_cast<uint8_t*>(out) + firstLen, buffer_, len - firstLen);
+}
+
+void TraceBuffer::publish(uint64_t end, uint64_t oldest, const void* header, size_t headerLen, const void* data,
+                          size_t len) {
+  const uint64_t head = end - headerLen - len;
+  // 顺序为 oldest_ -> release 栅栏 -> 数据 -> committed_。新数据只会覆盖 oldest 之前的字节，
+  // 读方拷贝后经 acquire 栅栏重读 oldest_：若读到的值覆盖了已拷贝的字节则剔除它们；
+  // 若拷贝读到了新数据，栅栏保证重读的 oldest_ 不早于这里的存储
+  oldest_.store(oldest, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  if (headerLen > 0) {
+    copyIn(head, header, headerLen);
+  }
+  copyIn(head + headerLen, data, len);
+  committed_.store(end, std::memory_order_release);
+}
+
+void TraceBuffer::write(const uint8_t* data, size_t len) {
+  // 模式不符是调用方 bug：在 Records 模式下写入裸字节会破坏长度前缀分帧。
+  // 调试期断言暴露，release 期拒绝写入
+  assert(mode_ == Mode::Bytes && "TraceBuffer: write() requires Mode::Bytes");
+  if (mode_ != Mode::Bytes || data == nullptr || len == 0) {
+    return;
+  }
+  const uint64_t head = committed_.load(std::memory_order_relaxed);
+  const uint64_t end = head + len;
+  if (len > capacity_) {
+    // 只有最后 capacity_ 字节会留下，前面的部分视为写入后立即被覆盖
+    data += len - capacity_;
+    len = capacity_;
+  }
+  const uint64_t oldest = std::max(oldest_.load(std::memory_order_relaxed), end > capacity_ ? end - capacity_ : 0);
+  publish(end, oldest, nullptr, 0, data, len);
+}
+
+bool TraceBuffer::writeRecord(const void* data, size_t len) {
+  assert(mode_ == Mode::Records && "TraceBuffer: writeRecord() requires Mode::Records");
+  if (mode_ != Mode::Records || len + kRecordHeaderSize > capacity_) {
+    return false;
+  }
+  const uint64_t head = committed_.load(std::memory_order_relaxed);
+  const uint64_t end = head + kRecordHeaderSize + len;
+
+  // 从最旧记录起整条淘汰，直到新记录放得下；只有写入线程修改数据，这里读取是安全的
+  uint64_t oldest = oldest_.load(std::memory_order_relaxed);
+  uint64_t dropped = 0;
+  while (end - oldest > capacity_) {
+    uint32_t recordLen = 0;
+    copyOut(oldest, &recordLen, kRecordHeaderSize);
+    oldest += kRecordHeaderSize + recordLen;
+    ++dropped;
+  }
+  if (dropped > 0) {
+    droppedRecords_.fetch_add(dropped, std::memory_order_relaxed);
+  }
+
+  const auto header = static_cast<uint32_t>(len);
+  publish(end, oldest, &header, kRecordHeaderSize, data, len);
+  return true;
+}
+
+ByteBuffer TraceBuffer::copyConsistent() const {
+  const uint64_t end = committed_.load(std::memory_order_acquire);
+  const uint64_t start = std::min(oldest_.load(std::memory_order_relaxed), end);
+
+  ByteBuffer out;
+  const auto len = static_cast<size_t>(end - start);
+  if (len > 0) {
+    copyOut(start, out.appendWritable(len), len);
+  }
+
+  // 拷贝期间写入方若已公布新的最旧位置，则此前的字节可能已被改写，予以剔除
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const uint64_t validStart = oldest_.load(std::memory_order_relaxed);
+  if (validStart > start) {
+    out.shift(static_cast<size_t>(std::min(validStart, end) - start));
+  }
+  return out;
+}
+
+ByteBuffer TraceBuffer::snapshot() const { return copyConsistent(); }
+
+std::vector<ByteSlice> TraceBuffer::snapshotRecords() const {
+  std::vector<ByteSlice> records;
+  ByteSlice all(copyConsistent());
+  // 快照起点总是记录边界（最旧位置只会按整条记录推进）
+  while (all.size() >= kRecordHeaderSize) {
+    uint32_t recordLen = 0;
+    std::memcpy(&recordLen, all.data(), kRecordHeaderSize);
+    all.removePrefix(kRecordHeaderSize);
+    if (recordLen > all.size()) {
+      break;
+    }
+    records.push_back(all.popFront(recordLen));
+  }
+  return records;
+}
+
+}  // namespace buffer
+}  // namespace pickup
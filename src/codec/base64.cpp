@@ -1,155 +1,684 @@
 #include "pickup/codec/base64.h"
 
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
 #include <string>
 
-#include "pickup/utils/StringUtils.h"
+#include "pickup/buffer/ByteBuffer.h"
+#include "pickup/utils/CpuFeatures.h"
+
+#if PICKUP_X86_SIMD
+#include <immintrin.h>
+#endif
 
 namespace pickup {
 namespace codec {
 namespace base64 {
 
-// Base64 编码字符表
-static const std::string kBase64Chars =
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-    "abcdefghijklmnopqrstuvwxyz"
-    "0123456789+/";
+namespace {
+
+// 编码表与 256 项解码表（-1 表示非法字符），编译期生成
+struct Alphabet {
+  std::array<char, 64> chars{};
+  std::array<int8_t, 256> values{};
+  std::array<uint8_t, 128> vbmiValues{};  // values 的 7 位版本，非法为 0x80，供 vpermi2b 使用
+  char c62 = 0;  // 第 62、63 号字符是各变体唯一不同之处
+  char c63 = 0;
+  bool pad = true;
+};
 
-// 判断一个字符是否是有效的 base64 字符
-static bool isBase64Char(unsigned char c) {
-  return (c == '+' ||
-          (c >= '/' && c <= '9') ||  // /-9
-          (c >= 'A' && c <= 'Z') ||
-          (c >= 'a' && c <= 'z'));
+constexpr Alphabet makeAlphabet(char c62, char c63, bool pad) {
+  Alphabet a;
+  constexpr char kAlnum[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+      "abcdefghijklmnopqrstuvwxyz"
+      "0123456789";
+  for (size_t i = 0; i < 62; ++i) {
+    a.chars[i] = kAlnum[i];
+  }
+  a.chars[62] = c62;
+  a.chars[63] = c63;
+  for (auto& v : a.values) {
+    v = -1;
+  }
+  for (size_t i = 0; i < 64; ++i) {
+    a.values[static_cast<uint8_t>(a.chars[i])] = static_cast<int8_t>(i);
+  }
+  for (size_t c = 0; c < 128; ++c) {
+    a.vbmiValues[c] = a.values[c] < 0 ? 0x80 : static_cast<uint8_t>(a.values[c]);
+  }
+  a.c62 = c62;
+  a.c63 = c63;
+  a.pad = pad;
+  return a;
 }
 
-std::string encode(unsigned char const* input, size_t len) {
-  std::string ret;
-  int i = 0;
-  int j = 0;
-  unsigned char charArray3[3];  // 存储 3 个原始字节
-  unsigned char charArray4[4];  // 存储 4 个 Base64 编码后的字节
-
-  while (len--) {
-    charArray3[i++] = *(input++);  // 读取一个字节
-    if (i == 3) {                  // 每攒够 3 个字节进行一次编码
-      // 编码过程：将 3 个 8 位字节转换为 4 个 6 位 Base64 字符
-      charArray4[0] = (charArray3[0] & 0xfc) >> 2;
-      charArray4[1] = ((charArray3[0] & 0x03) << 4) + ((charArray3[1] & 0xf0) >> 4);
-      charArray4[2] = ((charArray3[1] & 0x0f) << 2) + ((charArray3[2] & 0xc0) >> 6);
-      charArray4[3] = charArray3[2] & 0x3f;
-
-      // 将 6 位值映射到 Base64 字符表
-      for (i = 0; i < 4; i++) {
-        ret += kBase64Chars[charArray4[i]];
-      }
-      i = 0;  // 重置计数器
+constexpr Alphabet kStandard = makeAlphabet('+', '/', true);
+constexpr Alphabet kStandardNoPad = makeAlphabet('+', '/', false);
+constexpr Alphabet kUrlSafe = makeAlphabet('-', '_', true);
+constexpr Alphabet kUrlSafeNoPad = makeAlphabet('-', '_', false);
+
+const Alphabet& alphabetOf(Variant variant) {
+  switch (variant) {
+    case Variant::StandardNoPad:
+      return kStandardNoPad;
+    case Variant::UrlSafe:
+      return kUrlSafe;
+    case Variant::UrlSafeNoPad:
+      return kUrlSafeNoPad;
+    case Variant::Standard:
+    default:
+      return kStandard;
+  }
+}
+
+// ---------------------------------------------------------------------------
+// 标量实现
+// ---------------------------------------------------------------------------
+
+// 编码所有完整的 3 字节组，返回消耗的输入字节数
+size_t encodeBlocksScalar(const uint8_t* in, size_t len, char* out, const Alphabet& a) {
+  size_t i = 0;
+  for (; i + 3 <= len; i += 3) {
+    const uint32_t n = (uint32_t{in[i]} << 16) | (uint32_t{in[i + 1]} << 8) | in[i + 2];
+    out[0] = a.chars[n >> 18];
+    out[1] = a.chars[(n >> 12) & 0x3f];
+    out[2] = a.chars[(n >> 6) & 0x3f];
+    out[3] = a.chars[n & 0x3f];
+    out += 4;
+  }
+  return i;
+}
+
+// 编码不足 3 字节的尾部（len 为 0、1 或 2），按变体决定是否以 '=' 补齐，返回写入字符数
+size_t encodeTail(const uint8_t* in, size_t len, char* out, const Alphabet& a) {
+  if (len == 0) {
+    return 0;
+  }
+  const uint32_t n = (uint32_t{in[0]} << 16) | (len > 1 ? uint32_t{in[1]} << 8 : 0);
+  out[0] = a.chars[n >> 18];
+  out[1] = a.chars[(n >> 12) & 0x3f];
+  if (len > 1) {
+    out[2] = a.chars[(n >> 6) & 0x3f];
+  }
+  if (!a.pad) {
+    return len + 1;
+  }
+  if (len == 1) {
+    out[2] = '=';
+  }
+  out[3] = '=';
+  return 4;
+}
+
+// 解码完整的 4 字符组，遇到非法字符的组即停止；返回消耗的输入字符数
+size_t decodeBlocksScalar(const char* in, size_t len, uint8_t* out, const Alphabet& a) {
+  size_t i = 0;
+  for (; i + 4 <= len; i += 4) {
+    const int32_t v0 = a.values[static_cast<uint8_t>(in[i])];
+    const int32_t v1 = a.values[static_cast<uint8_t>(in[i + 1])];
+    const int32_t v2 = a.values[static_cast<uint8_t>(in[i + 2])];
+    const int32_t v3 = a.values[static_cast<uint8_t>(in[i + 3])];
+    // 任一为 -1 时按位或结果为负
+    if ((v0 | v1 | v2 | v3) < 0) {
+      break;
     }
+    const uint32_t n = (static_cast<uint32_t>(v0) << 18) | (static_cast<uint32_t>(v1) << 12) |
+                       (static_cast<uint32_t>(v2) << 6) | static_cast<uint32_t>(v3);
+    out[0] = static_cast<uint8_t>(n >> 16);
+    out[1] = static_cast<uint8_t>(n >> 8);
+    out[2] = static_cast<uint8_t>(n);
+    out += 3;
+  }
+  return i;
+}
+
+#if PICKUP_X86_SIMD
+
+// ---------------------------------------------------------------------------
+// SSSE3 / AVX2：编码用 pshufb 重排 + 乘法移位取出 6 位索引，再用 pshufb 查偏移表
+// 转成字符；解码用区间比较求出每个字符的值，再用 maddubs/madd 合并成 24 位。
+// ---------------------------------------------------------------------------
+
+// 6 位索引 → 字符的偏移表：按索引区间 [0,26) [26,52) [52,62) 62 63 分类后查表
+PICKUP_TARGET("ssse3") inline __m128i encodeOffsetLut(const Alphabet& a) {
+  return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                       '0' - 52, '0' - 52, static_cast<char>(a.c62 - 62), static_cast<char>(a.c63 - 63), 'A', 0, 0);
+}
+
+PICKUP_TARGET("ssse3") inline __m128i encodeBlockSSSE3(__m128i in, __m128i lut) {
+  // 每 3 字节 b0 b1 b2 排成 b1 b0 b2 b1，使各 6 位字段落在 16 位字内便于移位
+  in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  const __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+  const __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+  const __m128i indices = _mm_or_si128(t0, t1);
+
+  __m128i cls = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  cls = _mm_or_si128(cls, _mm_and_si128(upper, _mm_set1_epi8(13)));
+  return _mm_add_epi8(indices, _mm_shuffle_epi8(lut, cls));
+}
+
+PICKUP_TARGET("ssse3") size_t encodeSSSE3(const uint8_t* in, size_t len, char* out, const Alphabet& a) {
+  const __m128i lut = encodeOffsetLut(a);
+  size_t i = 0;
+  // 每次消耗 12 字节但读取 16 字节
+  for (; i + 16 <= len; i += 12) {
+    const __m128i chars = encodeBlockSSSE3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), lut);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chars);
+    out += 16;
+  }
+  return i;
+}
+
+PICKUP_TARGET("avx2") size_t encodeAVX2(const uint8_t* in, size_t len, char* out, const Alphabet& a) {
+  const __m256i lut = _mm256_broadcastsi128_si256(encodeOffsetLut(a));
+  const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,  //
+                                           1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+  size_t i = 0;
+  // 两个 128 位通道各处理 12 字节：读取 [i, i+16) 与 [i+12, i+28)
+  for (; i + 28 <= len; i += 24) {
+    __m256i v = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12)), 1);
+    v = _mm256_shuffle_epi8(v, shuffle);
+    const __m256i t0 =
+        _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+    const __m256i t1 =
+        _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+    const __m256i indices = _mm256_or_si256(t0, t1);
+
+    __m256i cls = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    cls = _mm256_or_si256(cls, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+    const __m256i chars = _mm256_add_epi8(indices, _mm256_shuffle_epi8(lut, cls));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), chars);
+    out += 32;
+  }
+  return i;
+}
+
+// 16 个字符 → 16 个 6 位值；valid 的每个字节为 0xFF 表示该字符合法
+PICKUP_TARGET("ssse3") inline __m128i decodeValuesSSSE3(__m128i c, const Alphabet& a, __m128i& valid) {
+  const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), c));
+  const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), c));
+  const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+  const __m128i is62 = _mm_cmpeq_epi8(c, _mm_set1_epi8(a.c62));
+  const __m128i is63 = _mm_cmpeq_epi8(c, _mm_set1_epi8(a.c63));
+  const __m128i special = _mm_or_si128(is62, is63);
+  valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, special));
+
+  __m128i offset = _mm_and_si128(upper, _mm_set1_epi8(-65));
+  offset = _mm_or_si128(offset, _mm_and_si128(lower, _mm_set1_epi8(-71)));
+  offset = _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8(4)));
+  const __m128i values = _mm_andnot_si128(special, _mm_add_epi8(c, offset));
+  return _mm_or_si128(values, _mm_or_si128(_mm_and_si128(is62, _mm_set1_epi8(62)), _mm_and_si128(is63, _mm_set1_epi8(63))));
+}
+
+// 16 个 6 位值合并为 12 字节，位于结果的低 12 字节
+PICKUP_TARGET("ssse3") inline __m128i packValuesSSSE3(__m128i values) {
+  const __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+PICKUP_TARGET("ssse3") size_t decodeSSSE3(const char* in, size_t len, uint8_t* out, const Alphabet& a) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m128i valid;
+    const __m128i values = decodeValuesSSSE3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), a, valid);
+    if (_mm_movemask_epi8(valid) != 0xFFFF) {
+      break;  // 含非法字符（或 '='）的块交给标量路径逐组处理
+    }
+    const __m128i bytes = packValuesSSSE3(values);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), bytes);
+    const auto high = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(bytes, 8)));
+    std::memcpy(out + 8, &high, 4);
+    out += 12;
+  }
+  return i;
+}
+
+PICKUP_TARGET("avx2") size_t decodeAVX2(const char* in, size_t len, uint8_t* out, const Alphabet& a) {
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    const __m256i upper =
+        _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), c));
+    const __m256i lower =
+        _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), c));
+    const __m256i digit =
+        _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+    const __m256i is62 = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(a.c62));
+    const __m256i is63 = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(a.c63));
+    const __m256i special = _mm256_or_si256(is62, is63);
+    const __m256i valid = _mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, special));
+    if (_mm256_movemask_epi8(valid) != -1) {
+      break;
+    }
+
+    __m256i offset = _mm256_and_si256(upper, _mm256_set1_epi8(-65));
+    offset = _mm256_or_si256(offset, _mm256_and_si256(lower, _mm256_set1_epi8(-71)));
+    offset = _mm256_or_si256(offset, _mm256_and_si256(digit, _mm256_set1_epi8(4)));
+    __m256i values = _mm256_andnot_si256(special, _mm256_add_epi8(c, offset));
+    values = _mm256_or_si256(values, _mm256_or_si256(_mm256_and_si256(is62, _mm256_set1_epi8(62)),
+                                                     _mm256_and_si256(is63, _mm256_set1_epi8(63))));
+
+    __m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)),
+                                       _mm256_set1_epi32(0x00011000));
+    merged = _mm256_shuffle_epi8(merged, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,  //
+                                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    // 两个通道各 12 字节，拼成连续的 24 字节
+    merged = _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(merged));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 16), _mm256_extracti128_si256(merged, 1));
+    out += 24;
+  }
+  return i;
+}
+
+// ---------------------------------------------------------------------------
+// AVX-512 VBMI：vpermb 直接以 64 字节寄存器作查找表，vpmultishiftqb 一次取出
+// 8 个 6 位字段。每次编码 48 字节 / 解码 64 字符。
+// ---------------------------------------------------------------------------
+
+constexpr uint64_t kMask48 = (uint64_t{1} << 48) - 1;
+
+// 每个 32 位字放入 b2 b1 b0 b0，使 24 位组 N = b0<<16 | b1<<8 | b2 位于字的低 24 位
+constexpr std::array<uint8_t, 64> kEncodeShuffle512 = [] {
+  std::array<uint8_t, 64> idx{};
+  for (size_t k = 0; k < 16; ++k) {
+    idx[4 * k + 0] = static_cast<uint8_t>(3 * k + 2);
+    idx[4 * k + 1] = static_cast<uint8_t>(3 * k + 1);
+    idx[4 * k + 2] = static_cast<uint8_t>(3 * k);
+    idx[4 * k + 3] = static_cast<uint8_t>(3 * k);
+  }
+  return idx;
+}();
+
+// 每个 32 位字的 24 位结果按大端取出：4k+2, 4k+1, 4k
+constexpr std::array<uint8_t, 64> kDecodeShuffle512 = [] {
+  std::array<uint8_t, 64> idx{};
+  for (size_t j = 0; j < 48; ++j) {
+    idx[j] = static_cast<uint8_t>(4 * (j / 3) + 2 - (j % 3));
+  }
+  return idx;
+}();
+
+PICKUP_TARGET("avx512f,avx512bw,avx512vbmi")
+size_t encodeAVX512VBMI(const uint8_t* in, size_t len, char* out, const Alphabet& a) {
+  const __m512i lookup = _mm512_loadu_si512(a.chars.data());
+  const __m512i shuffle = _mm512_loadu_si512(kEncodeShuffle512.data());
+  // 每个 64 位通道中两个 24 位组的 4 个字段起始位：18 12 6 0 | 50 44 38 32
+  const __m512i shifts = _mm512_set1_epi64(0x20262c3200060c12);
+  size_t i = 0;
+  for (; i + 48 <= len; i += 48) {
+    const __m512i v = _mm512_maskz_loadu_epi8(kMask48, in + i);
+    const __m512i indices = _mm512_multishift_epi64_epi8(shifts, _mm512_permutexvar_epi8(shuffle, v));
+    _mm512_storeu_si512(out, _mm512_permutexvar_epi8(indices, lookup));
+    out += 64;
+  }
+  return i;
+}
+
+PICKUP_TARGET("avx512f,avx512bw,avx512vbmi")
+size_t decodeAVX512VBMI(const char* in, size_t len, uint8_t* out, const Alphabet& a) {
+  // 128 项查找表分两半供 vpermi2b 使用；>= 0x80 的输入由最高位检出
+  const __m512i lo = _mm512_loadu_si512(a.vbmiValues.data());
+  const __m512i hi = _mm512_loadu_si512(a.vbmiValues.data() + 64);
+  const __m512i pack = _mm512_loadu_si512(kDecodeShuffle512.data());
+
+  size_t i = 0;
+  for (; i + 64 <= len; i += 64) {
+    const __m512i c = _mm512_loadu_si512(in + i);
+    const __m512i values = _mm512_permutex2var_epi8(lo, c, hi);
+    if (_mm512_movepi8_mask(_mm512_or_si512(values, c)) != 0) {
+      break;
+    }
+    const __m512i merged = _mm512_madd_epi16(_mm512_maddubs_epi16(values, _mm512_set1_epi32(0x01400140)),
+                                             _mm512_set1_epi32(0x00011000));
+    _mm512_mask_storeu_epi8(out, kMask48, _mm512_permutexvar_epi8(pack, merged));
+    out += 48;
+  }
+  return i;
+}
+
+#endif  // PICKUP_X86_SIMD
+
+// 按 SIMD 级别从高到低依次编码完整的 3 字节组，返回消耗的输入字节数（3 的倍数）
+size_t encodeBlocks(const uint8_t* in, size_t len, char* out, const Alphabet& a) {
+  size_t i = 0;
+#if PICKUP_X86_SIMD
+  const utils::SimdLevel level = utils::simdLevel();
+  if (level >= utils::SimdLevel::AVX512VBMI) {
+    i += encodeAVX512VBMI(in, len, out, a);
+  }
+  if (level >= utils::SimdLevel::AVX2) {
+    i += encodeAVX2(in + i, len - i, out + i / 3 * 4, a);
+  }
+  if (level >= utils::SimdLevel::SSSE3) {
+    i += encodeSSSE3(in + i, len - i, out + i / 3 * 4, a);
+  }
+#endif
+  i += encodeBlocksScalar(in + i, len - i, out + i / 3 * 4, a);
+  return i;
+}
+
+// 解码完整的 4 字符组直至输入结束或遇到含 '=' / 非法字符的组，返回消耗的字符数（4 的倍数）
+size_t decodeBlocks(const char* in, size_t len, uint8_t* out, const Alphabet& a) {
+  size_t i = 0;
+#if PICKUP_X86_SIMD
+  const utils::SimdLevel level = utils::simdLevel();
+  if (level >= utils::SimdLevel::AVX512VBMI) {
+    i += decodeAVX512VBMI(in, len, out, a);
+  }
+  if (level >= utils::SimdLevel::AVX2) {
+    i += decodeAVX2(in + i, len - i, out + i / 4 * 3, a);
   }
+  if (level >= utils::SimdLevel::SSSE3) {
+    i += decodeSSSE3(in + i, len - i, out + i / 4 * 3, a);
+  }
+#endif
+  i += decodeBlocksScalar(in + i, len - i, out + i / 4 * 3, a);
+  return i;
+}
+
+// 将不足 4 个的有效字符（k 个）解出 k-1 字节，返回写入的字节数
+size_t decodePartial(const uint8_t* values, size_t k, uint8_t* out) {
+  uint32_t acc = 0;
+  for (size_t j = 0; j < k; ++j) {
+    acc |= static_cast<uint32_t>(values[j]) << (18 - 6 * j);
+  }
+  for (size_t j = 0; j + 1 < k; ++j) {
+    out[j] = static_cast<uint8_t>(acc >> (16 - 8 * j));
+  }
+  return k > 0 ? k - 1 : 0;
+}
+
+size_t encodeImpl(const uint8_t* in, size_t len, char* out, const Alphabet& a) {
+  const size_t i = encodeBlocks(in, len, out, a);
+  return i / 3 * 4 + encodeTail(in + i, len - i, out + i / 3 * 4, a);
+}
 
-  // 处理剩余不足 3 字节的情况（填充）
-  if (i) {
-    for (j = i; j < 3; j++) {
-      charArray3[j] = '\0';  // 用 0 填充不足的字节
+size_t decodeImpl(const char* in, size_t len, uint8_t* out, const Alphabet& a) {
+  const size_t i = decodeBlocks(in, len, out, a);
+  size_t n = i / 4 * 3;
+
+  // decodeBlocks 停在输入末尾或含 '=' / 非法字符的组，此处至多剩 3 个有效字符
+  uint8_t values[3];
+  size_t k = 0;
+  for (; k < 3 && i + k < len; ++k) {
+    const int8_t v = a.values[static_cast<uint8_t>(in[i + k])];
+    if (v < 0) {
+      break;
     }
+    values[k] = static_cast<uint8_t>(v);
+  }
+  n += decodePartial(values, k, out + n);
+  return n;
+}
 
-    // 对剩余字节进行编码
-    charArray4[0] = (charArray3[0] & 0xfc) >> 2;
-    charArray4[1] = ((charArray3[0] & 0x03) << 4) + ((charArray3[1] & 0xf0) >> 4);
-    charArray4[2] = ((charArray3[1] & 0x0f) << 2) + ((charArray3[2] & 0xc0) >> 6);
-    charArray4[3] = charArray3[2] & 0x3f;
+DecodeStatus decodeStrictImpl(const char* in, size_t len, uint8_t* out, const Alphabet& a) {
+  // 带填充时最后一组可能含 '='，留给下面的尾部检查
+  size_t bulk = len / 4 * 4;
+  if (a.pad && bulk == len && len > 0 && in[len - 1] == '=') {
+    bulk -= 4;
+  }
+  const size_t i = decodeBlocks(in, bulk, out, a);
+  DecodeStatus status{false, i / 4 * 3, 0};
+  if (i < bulk) {
+    // 停下的组内必有非法字符
+    size_t j = i;
+    while (a.values[static_cast<uint8_t>(in[j])] >= 0) {
+      ++j;
+    }
+    status.errorOffset = j;
+    return status;
+  }
 
-    // 添加编码后的字符
-    for (j = 0; j < i + 1; j++) {
-      ret += kBase64Chars[charArray4[j]];
+  const size_t tail = len - i;
+  uint8_t values[4];
+  size_t k = 0;
+  for (; k < tail; ++k) {
+    const int8_t v = a.values[static_cast<uint8_t>(in[i + k])];
+    if (v < 0) {
+      break;
     }
+    values[k] = static_cast<uint8_t>(v);
+  }
 
-    // 添加填充字符 '='
-    while (i++ < 3) {
-      ret += '=';
+  if (a.pad) {
+    // 有效字符之后只能是补齐到 4 个字符的 '='，且至少要有 2 个有效字符
+    for (size_t j = i + k; j < len; ++j) {
+      if (in[j] != '=' || k < 2) {
+        status.errorOffset = j;
+        return status;
+      }
+    }
+    if (tail % 4 != 0) {
+      status.errorOffset = len;  // 缺少填充（输入被截断）
+      return status;
+    }
+  } else {
+    if (k < tail) {
+      status.errorOffset = i + k;
+      return status;
+    }
+    if (tail == 1) {
+      status.errorOffset = i;  // 单个字符不足以构成一个字节
+      return status;
     }
   }
 
+  status.written += decodePartial(values, k, out + status.written);
+  status.ok = true;
+  status.errorOffset = len;
+  return status;
+}
+
+}  // namespace
+
+size_t encode(const uint8_t* input, size_t len, char* out) { return encodeImpl(input, len, out, kStandard); }
+
+size_t encode(const uint8_t* input, size_t len, char* out, Variant variant) {
+  return encodeImpl(input, len, out, alphabetOf(variant));
+}
+
+std::string encode(std::string_view input, Variant variant) {
+  std::string ret(encodedLength(input.size(), variant), '\0');
+  encodeImpl(reinterpret_cast<const uint8_t*>(input.data()), input.size(), ret.data(), alphabetOf(variant));
+  return ret;
+}
+
+std::string encode(unsigned char const* input, size_t len) {
+  std::string ret(encodedLength(len), '\0');
+  encodeImpl(input, len, ret.data(), kStandard);
   return ret;
 }
 
+size_t decode(const char* input, size_t len, uint8_t* out) { return decodeImpl(input, len, out, kStandard); }
+
 std::string decode(std::string const& input) {
-  size_t inLen = input.size();  // 输入字符串长度
-  int i = 0;
-  int j = 0;
-  int index = 0;                                 // 输入字符串索引
-  unsigned char charArray4[4], charArray3[3];   // 解码用缓冲区
-  std::string ret;                               // 返回的解码结果
-
-  // 遍历输入字符串（忽略填充 '=' 和非 Base64 字符）
-  while (inLen-- && (input[index] != '=') && isBase64Char(input[index])) {
-    charArray4[i++] = input[index];
-    index++;
-    if (i == 4) {  // 每攒够 4 个 Base64 字符进行一次解码
-      // 将 Base64 字符转换回 6 位值
-      for (i = 0; i < 4; i++) {
-        charArray4[i] = static_cast<unsigned char>(kBase64Chars.find(charArray4[i]));
-      }
+  std::string ret(maxDecodedLength(input.size()), '\0');
+  ret.resize(decodeImpl(input.data(), input.size(), reinterpret_cast<uint8_t*>(ret.data()), kStandard));
+  return ret;
+}
 
-      // 解码过程：将 4 个 6 位 Base64 字符转换为 3 个 8 位原始字节
-      charArray3[0] = (charArray4[0] << 2) + ((charArray4[1] & 0x30) >> 4);
-      charArray3[1] = ((charArray4[1] & 0xf) << 4) + ((charArray4[2] & 0x3c) >> 2);
-      charArray3[2] = ((charArray4[2] & 0x3) << 6) + charArray4[3];
+std::string decode(std::string_view input, Variant variant) {
+  std::string ret(maxDecodedLength(input.size()), '\0');
+  ret.resize(
+      decodeImpl(input.data(), input.size(), reinterpret_cast<uint8_t*>(ret.data()), alphabetOf(variant)));
+  return ret;
+}
 
-      // 添加解码后的原始字节
-      for (i = 0; i < 3; i++) {
-        ret += charArray3[i];
-      }
-      i = 0;  // 重置计数器
-    }
+DecodeStatus decodeStrict(const char* input, size_t len, uint8_t* out, Variant variant) {
+  return decodeStrictImpl(input, len, out, alphabetOf(variant));
+}
+
+std::optional<std::string> decodeStrict(std::string_view input, Variant variant, size_t* errorOffset) {
+  std::string ret(maxDecodedLength(input.size()), '\0');
+  const DecodeStatus status =
+      decodeStrictImpl(input.data(), input.size(), reinterpret_cast<uint8_t*>(ret.data()), alphabetOf(variant));
+  if (errorOffset != nullptr) {
+    *errorOffset = status.errorOffset;
+  }
+  if (!status.ok) {
+    return std::nullopt;
+  }
+  ret.resize(status.written);
+  return ret;
+}
+
+size_t Encoder::update(std::span<const uint8_t> input, std::span<char> out) {
+  if (out.size() < maxOutputLength(input.size())) {
+    throw std::length_error("base64::Encoder: output buffer too small");
   }
+  const Alphabet& alphabet = alphabetOf(variant_);
+  const uint8_t* in = input.data();
+  size_t len = input.size();
+  char* o = out.data();
 
-  // 处理剩余 Base64 字符（可能包含填充）
-  if (i) {
-    // 用 0 填充不足的 Base64 字符
-    for (j = i; j < 4; j++) {
-      charArray4[j] = 0;
+  // 先用新数据补齐上次暂存的不完整组
+  if (pendingSize_ > 0) {
+    uint8_t group[3] = {pending_[0], pending_[1], 0};
+    while (pendingSize_ < 3 && len > 0) {
+      group[pendingSize_++] = *in++;
+      --len;
+    }
+    if (pendingSize_ < 3) {
+      pending_[0] = group[0];
+      pending_[1] = group[1];
+      return 0;
     }
+    o += encodeBlocksScalar(group, 3, o, alphabet) / 3 * 4;
+    pendingSize_ = 0;
+  }
 
-    // 将剩余 Base64 字符转换回 6 位值
-    for (j = 0; j < 4; j++) {
-      charArray4[j] = static_cast<unsigned char>(kBase64Chars.find(charArray4[j]));
+  const size_t consumed = encodeBlocks(in, len, o, alphabet);
+  o += consumed / 3 * 4;
+  for (size_t i = consumed; i < len; ++i) {
+    pending_[pendingSize_++] = in[i];
+  }
+  return static_cast<size_t>(o - out.data());
+}
+
+void Encoder::update(std::span<const uint8_t> input, buffer::ByteBuffer& out) {
+  const size_t reserved = maxOutputLength(input.size());
+  auto* dst = reinterpret_cast<char*>(out.appendWritable(reserved));
+  const size_t written = update(input, std::span<char>(dst, reserved));
+  out.resize(out.size() - reserved + written);
+}
+
+size_t Encoder::finish(std::span<char> out) {
+  if (out.size() < kMaxFinishLength) {
+    throw std::length_error("base64::Encoder: output buffer too small");
+  }
+  const size_t written = encodeTail(pending_, pendingSize_, out.data(), alphabetOf(variant_));
+  pendingSize_ = 0;
+  return written;
+}
+
+void Encoder::finish(buffer::ByteBuffer& out) {
+  char tail[kMaxFinishLength];
+  const size_t written = finish(tail);
+  out.append(tail, tail + written);
+}
+
+size_t Decoder::update(std::span<const char> input, std::span<uint8_t> out) {
+  if (out.size() < maxOutputLength(input.size())) {
+    throw std::length_error("base64::Decoder: output buffer too small");
+  }
+  if (stopped_) {
+    return 0;
+  }
+  const Alphabet& alphabet = alphabetOf(variant_);
+  const char* in = input.data();
+  const size_t len = input.size();
+  uint8_t* o = out.data();
+  size_t i = 0;
+
+  // 先逐字符补齐暂存的不完整组；整组完成后才能进入批量路径
+  while (pendingSize_ > 0 && i < len) {
+    const int8_t v = alphabet.values[static_cast<uint8_t>(in[i])];
+    if (v < 0) {
+      stopped_ = true;
+      return static_cast<size_t>(o - out.data());
+    }
+    ++i;
+    if (pendingSize_ < 3) {
+      pending_[pendingSize_++] = static_cast<uint8_t>(v);
+      continue;
     }
+    const uint32_t n = (uint32_t{pending_[0]} << 18) | (uint32_t{pending_[1]} << 12) |
+                       (uint32_t{pending_[2]} << 6) | static_cast<uint32_t>(v);
+    o[0] = static_cast<uint8_t>(n >> 16);
+    o[1] = static_cast<uint8_t>(n >> 8);
+    o[2] = static_cast<uint8_t>(n);
+    o += 3;
+    pendingSize_ = 0;
+  }
 
-    // 解码剩余字符
-    charArray3[0] = (charArray4[0] << 2) + ((charArray4[1] & 0x30) >> 4);
-    charArray3[1] = ((charArray4[1] & 0xf) << 4) + ((charArray4[2] & 0x3c) >> 2);
-    charArray3[2] = ((charArray4[2] & 0x3) << 6) + charArray4[3];
+  const size_t consumed = decodeBlocks(in + i, len - i, o, alphabet);
+  o += consumed / 4 * 3;
+  i += consumed;
 
-    // 添加有效解码字节（忽略填充产生的 0 字节）
-    for (j = 0; j < i - 1; j++) {
-      ret += static_cast<std::string::value_type>(charArray3[j]);
+  // 剩余不足一组（或含 '=' / 非法字符的组）：有效前缀暂存，遇到无效字符即停止
+  for (; i < len; ++i) {
+    const int8_t v = alphabet.values[static_cast<uint8_t>(in[i])];
+    if (v < 0) {
+      stopped_ = true;
+      break;
     }
+    pending_[pendingSize_++] = static_cast<uint8_t>(v);
   }
+  return static_cast<size_t>(o - out.data());
+}
 
-  return ret;
+void Decoder::update(std::span<const char> input, buffer::ByteBuffer& out) {
+  const size_t reserved = maxOutputLength(input.size());
+  uint8_t* dst = out.appendWritable(reserved);
+  const size_t written = update(input, std::span<uint8_t>(dst, reserved));
+  out.resize(out.size() - reserved + written);
 }
 
-std::string fromUrlSafe(const std::string& input) {
-  // 将 URL-safe Base64 字母表转换为标准 Base64
-  std::string temp = utils::replaceAll(input, "-", "+");
-  temp = utils::replaceAll(temp, "_", "/");
+size_t Decoder::finish(std::span<uint8_t> out) {
+  if (out.size() < kMaxFinishLength) {
+    throw std::length_error("base64::Decoder: output buffer too small");
+  }
+  const size_t written = decodePartial(pending_, pendingSize_, out.data());
+  reset();
+  return written;
+}
 
-  // 添加 padding 至 4 的倍数
-  return utils::padRight(temp, ((temp.size() + 3) / 4) * 4, '=');
+void Decoder::finish(buffer::ByteBuffer& out) {
+  uint8_t tail[kMaxFinishLength];
+  const size_t written = finish(tail);
+  out.append(tail, tail + written);
 }
 
-std::string toUrlSafe(const std::string& input) {
-  std::string temp(input);
+std::string fromUrlSafe(const std::string& input) {
+  // 单次遍历完成字母表替换，并补齐 '=' 至 4 的倍数
+  std::string ret((input.size() + 3) / 4 * 4, '=');
+  for (size_t i = 0; i < input.size(); ++i) {
+    const char c = input[i];
+    ret[i] = c == '-' ? '+' : (c == '_' ? '/' : c);
+  }
+  return ret;
+}
 
-  // 移除 padding
-  size_t found = temp.find_last_not_of('=');
+std::string toUrlSafe(const std::string& input) {
+  // 去掉末尾 padding 后单次遍历完成字母表替换
+  const size_t found = input.find_last_not_of('=');
   if (found == std::string::npos) return "";
 
-  // 将标准 Base64 字母表转换为 URL-safe Base64
-  temp = utils::replaceAll(temp, "+", "-");
-  temp = utils::replaceAll(temp, "/", "_");
-
-  return temp.substr(0, found + 1);
+  std::string ret(found + 1, '\0');
+  for (size_t i = 0; i <= found; ++i) {
+    const char c = input[i];
+    ret[i] = c == '+' ? '-' : (c == '/' ? '_' : c);
+  }
+  return ret;
 }
 
 }  // namespace base64
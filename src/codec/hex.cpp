@@ -1,106 +1,315 @@
 #include "pickup/codec/hex.h"
 
 #include <array>
+#include <stdexcept>
+
+#include "pickup/utils/CpuFeatures.h"
+
+#if PICKUP_X86_SIMD
+#include <immintrin.h>
+#endif
 
 namespace pickup {
 namespace codec {
 namespace hex {
 
-std::string encode(const uint8_t* data, size_t len, bool uppercase) {
-  const char* hex_table = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+namespace {
 
-  std::string hex_str;
-  hex_str.reserve(len * 2);  // 预分配空间，每个字节对应 2 个字符
+constexpr char kUpperDigits[] = "0123456789ABCDEF";
+constexpr char kLowerDigits[] = "0123456789abcdef";
+
+// 字符 → 4 位值，0xFF 表示非法字符
+constexpr std::array<uint8_t, 256> kNibbles = [] {
+  std::array<uint8_t, 256> table{};
+  for (auto& v : table) {
+    v = 0xFF;
+  }
+  for (size_t i = 0; i < 10; ++i) {
+    table['0' + i] = static_cast<uint8_t>(i);  // 数字 0-9
+  }
+  for (size_t i = 0; i < 6; ++i) {
+    table['A' + i] = static_cast<uint8_t>(10 + i);  // 大写 A-F
+    table['a' + i] = static_cast<uint8_t>(10 + i);  // 小写 a-f
+  }
+  return table;
+}();
 
+size_t encodeScalar(const uint8_t* data, size_t len, char* out, const char* digits) {
   for (size_t i = 0; i < len; ++i) {
-    uint8_t byte = data[i];
-    // 将高 4 位和低 4 位分别转换为十六进制字符
-    hex_str.push_back(hex_table[(byte >> 4) & 0x0F]);  // 高 4 位
-    hex_str.push_back(hex_table[byte & 0x0F]);         // 低 4 位
+    out[2 * i] = digits[data[i] >> 4];
+    out[2 * i + 1] = digits[data[i] & 0x0F];
   }
+  return len;
+}
 
-  return hex_str;
+// 解码 len 个字节（2 * len 个字符），返回成功解码的字节数；遇到非法字符时小于 len
+size_t decodeScalar(const char* in, size_t len, uint8_t* out) {
+  for (size_t i = 0; i < len; ++i) {
+    const uint8_t high = kNibbles[static_cast<uint8_t>(in[2 * i])];
+    const uint8_t low = kNibbles[static_cast<uint8_t>(in[2 * i + 1])];
+    if ((high | low) > 0x0F) {  // 任一为 0xFF
+      return i;
+    }
+    out[i] = static_cast<uint8_t>((high << 4) | low);
+  }
+  return len;
 }
 
-std::string encodeWithSeparator(const uint8_t* data, size_t len, bool uppercase, char separator) {
-  const char* hex_table = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+#if PICKUP_X86_SIMD
 
-  std::string hex_str;
-  if (len == 0) return hex_str;
+// ---------------------------------------------------------------------------
+// 编码：高低 4 位分别作为 pshufb 的索引查 16 项字符表，再交错成字符对。
+// 解码：按 '0'-'9' 与（忽略大小写的）'a'-'f' 两个区间求 4 位值并校验，
+// 再用 maddubs 把相邻两个 4 位值合并成一个字节。
+// ---------------------------------------------------------------------------
 
-  // 预计算内存：每个字节 2 字符 + 分隔符
-  size_t total_len = len * 2;
-  if (separator != '\0') {
-    total_len += (len - 1);  // 分隔符数量为 len - 1
+PICKUP_TARGET("ssse3") size_t encodeSSSE3(const uint8_t* data, size_t len, char* out, const char* digits) {
+  const __m128i lut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const __m128i high = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+    const __m128i low = _mm_shuffle_epi8(lut, _mm_and_si128(v, mask));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(high, low));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(high, low));
   }
-  hex_str.reserve(total_len);
+  return i;
+}
 
-  // 逐个字节处理
-  for (size_t i = 0; i < len; ++i) {
-    uint8_t byte = data[i];
-    hex_str.push_back(hex_table[(byte >> 4) & 0x0F]);  // 高 4 位
-    hex_str.push_back(hex_table[byte & 0x0F]);         // 低 4 位
+PICKUP_TARGET("avx2") size_t encodeAVX2(const uint8_t* data, size_t len, char* out, const char* digits) {
+  const __m256i lut = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digits)));
+  const __m256i mask = _mm256_set1_epi8(0x0F);
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    const __m256i high = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+    const __m256i low = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, mask));
+    // unpack 在各 128 位通道内进行，再按通道重新拼接成连续的 64 个字符
+    const __m256i a = _mm256_unpacklo_epi8(high, low);
+    const __m256i b = _mm256_unpackhi_epi8(high, low);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+  }
+  return i;
+}
 
-    // 添加分隔符（最后一个字节不添加）
-    if (separator != '\0' && i != len - 1) {
-      hex_str.push_back(separator);
+// 16 个字符 → 16 个 4 位值；valid 的每个字节为 0xFF 表示该字符合法
+PICKUP_TARGET("ssse3") inline __m128i nibblesSSSE3(__m128i c, __m128i& valid) {
+  const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+  const __m128i alpha = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+  const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+  const __m128i isAlpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+  valid = _mm_or_si128(isDigit, isAlpha);
+  return _mm_or_si128(_mm_and_si128(isDigit, digit),
+                      _mm_and_si128(isAlpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+
+PICKUP_TARGET("ssse3") size_t decodeSSSE3(const char* in, size_t len, uint8_t* out) {
+  const __m128i weights = _mm_set1_epi16(0x0110);  // 每对字符：高位 ×16 + 低位 ×1
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m128i valid0;
+    __m128i valid1;
+    const __m128i n0 = nibblesSSSE3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i)), valid0);
+    const __m128i n1 = nibblesSSSE3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i + 16)), valid1);
+    if (_mm_movemask_epi8(_mm_and_si128(valid0, valid1)) != 0xFFFF) {
+      break;  // 含非法字符的块交给标量路径定位
     }
+    const __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(n0, weights), _mm_maddubs_epi16(n1, weights));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), bytes);
   }
+  return i;
+}
 
-  return hex_str;
+PICKUP_TARGET("avx2") inline __m256i nibblesAVX2(__m256i c, __m256i& valid) {
+  const __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+  const __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+  const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+  const __m256i isAlpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+  valid = _mm256_or_si256(isDigit, isAlpha);
+  return _mm256_or_si256(_mm256_and_si256(isDigit, digit),
+                         _mm256_and_si256(isAlpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
 }
 
-std::optional<std::vector<uint8_t>> decode(const std::string& input) {
-  // 验证输入有效性
-  if (input.length() % 2 != 0) {
-    return std::nullopt;
+PICKUP_TARGET("avx2") size_t decodeAVX2(const char* in, size_t len, uint8_t* out) {
+  const __m256i weights = _mm256_set1_epi16(0x0110);
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    __m256i valid0;
+    __m256i valid1;
+    const __m256i n0 = nibblesAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i)), valid0);
+    const __m256i n1 = nibblesAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i + 32)), valid1);
+    if (_mm256_movemask_epi8(_mm256_and_si256(valid0, valid1)) != -1) {
+      break;
+    }
+    // packus 在通道内交错两个输入，需再按 64 位重排恢复顺序
+    const __m256i packed =
+        _mm256_packus_epi16(_mm256_maddubs_epi16(n0, weights), _mm256_maddubs_epi16(n1, weights));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(packed, 0xD8));
   }
+  return i;
+}
+
+#endif  // PICKUP_X86_SIMD
 
-  // 构建反向映射表（字符 -> 4 位值）
-  std::vector<uint8_t> lookup(256, 0xFF);  // 初始化为无效值
-  for (int i = 0; i < 10; ++i) {
-    lookup['0' + i] = i;  // 数字 0-9
+void encodeImpl(const uint8_t* data, size_t len, char* out, bool uppercase) {
+  const char* digits = uppercase ? kUpperDigits : kLowerDigits;
+  size_t i = 0;
+#if PICKUP_X86_SIMD
+  const utils::SimdLevel level = utils::simdLevel();
+  if (level >= utils::SimdLevel::AVX2) {
+    i += encodeAVX2(data, len, out, digits);
   }
-  for (int i = 0; i < 6; ++i) {
-    lookup['A' + i] = 10 + i;  // 大写 A-F
-    lookup['a' + i] = 10 + i;  // 小写 a-f
+  if (level >= utils::SimdLevel::SSSE3) {
+    i += encodeSSSE3(data + i, len - i, out + 2 * i, digits);
   }
+#endif
+  encodeScalar(data + i, len - i, out + 2 * i, digits);
+}
 
-  std::vector<uint8_t> bytes;
-  bytes.reserve(input.length() / 2);  // 预分配空间
+// 解码 len 个字节（2 * len 个字符），全部合法时返回 true
+bool decodeImpl(const char* in, size_t len, uint8_t* out) {
+  size_t i = 0;
+#if PICKUP_X86_SIMD
+  const utils::SimdLevel level = utils::simdLevel();
+  if (level >= utils::SimdLevel::AVX2) {
+    i += decodeAVX2(in, len, out);
+  }
+  if (level >= utils::SimdLevel::SSSE3) {
+    i += decodeSSSE3(in + 2 * i, len - i, out + i);
+  }
+#endif
+  return decodeScalar(in + 2 * i, len - i, out + i) == len - i;
+}
 
-  for (size_t i = 0; i < input.length(); i += 2) {
-    // 检查字符有效性
-    uint8_t high_nibble = lookup[static_cast<uint8_t>(input[i])];
-    uint8_t low_nibble = lookup[static_cast<uint8_t>(input[i + 1])];
+// 规整格式 "HH<sep>HH<sep>...HH"：按固定步长直接取字符对并校验分隔符位置
+bool decodeStrided(const char* in, size_t count, uint8_t* out, char separator) {
+  for (size_t i = 0; i < count; ++i) {
+    const char* p = in + 3 * i;
+    const uint8_t high = kNibbles[static_cast<uint8_t>(p[0])];
+    const uint8_t low = kNibbles[static_cast<uint8_t>(p[1])];
+    if ((high | low) > 0x0F || (i + 1 < count && p[2] != separator)) {
+      return false;
+    }
+    out[i] = static_cast<uint8_t>((high << 4) | low);
+  }
+  return true;
+}
 
-    if (high_nibble == 0xFF || low_nibble == 0xFF) {
+// 任意位置出现分隔符：逐字符跳过分隔符并两两配对，返回写入的字节数
+std::optional<size_t> decodeSkipping(std::string_view input, uint8_t* out, size_t outSize, char separator) {
+  size_t written = 0;
+  int high = -1;
+  for (const char c : input) {
+    if (c == separator) {
+      continue;
+    }
+    const uint8_t nibble = kNibbles[static_cast<uint8_t>(c)];
+    if (nibble == 0xFF) {
       return std::nullopt;
     }
+    if (high < 0) {
+      high = nibble;
+      continue;
+    }
+    if (written == outSize) {
+      throw std::length_error("hex::decodeWithSeparator: output buffer too small");
+    }
+    out[written++] = static_cast<uint8_t>((high << 4) | nibble);
+    high = -1;
+  }
+  if (high >= 0) {
+    return std::nullopt;  // 有效字符数为奇数
+  }
+  return written;
+}
+
+}  // namespace
+
+std::string encode(const uint8_t* data, size_t len, bool uppercase) {
+  std::string hex_str(encodedLength(len), '\0');
+  encodeImpl(data, len, hex_str.data(), uppercase);
+  return hex_str;
+}
 
-    // 组合高 4 位和低 4 位
-    bytes.push_back((high_nibble << 4) | low_nibble);
+size_t encode(std::span<const uint8_t> data, std::span<char> out, bool uppercase) {
+  if (out.size() < encodedLength(data.size())) {
+    throw std::length_error("hex::encode: output buffer too small");
   }
+  encodeImpl(data.data(), data.size(), out.data(), uppercase);
+  return encodedLength(data.size());
+}
 
-  return bytes;
+std::string encodeWithSeparator(const uint8_t* data, size_t len, bool uppercase, char separator) {
+  const char* hex_table = uppercase ? kUpperDigits : kLowerDigits;
+
+  std::string hex_str;
+  if (len == 0) return hex_str;
+  if (separator == '\0') return encode(data, len, uppercase);
+
+  // 每个字节 2 字符 + 分隔符（最后一个字节不加），一次分配后直接写入
+  hex_str.resize(len * 3 - 1);
+  char* out = hex_str.data();
+  for (size_t i = 0; i < len; ++i) {
+    out[3 * i] = hex_table[data[i] >> 4];        // 高 4 位
+    out[3 * i + 1] = hex_table[data[i] & 0x0F];  // 低 4 位
+    if (i != len - 1) {
+      out[3 * i + 2] = separator;
+    }
+  }
+
+  return hex_str;
 }
 
-std::optional<std::vector<uint8_t>> decodeWithSeparator(const std::string& input, char separator) {
-  std::string clean_hex;
-  clean_hex.reserve(input.length());
+std::optional<size_t> decode(std::string_view input, std::span<uint8_t> out) {
+  if (input.length() % 2 != 0) {
+    return std::nullopt;
+  }
+  const size_t len = input.length() / 2;
+  if (out.size() < len) {
+    throw std::length_error("hex::decode: output buffer too small");
+  }
+  if (!decodeImpl(input.data(), len, out.data())) {
+    return std::nullopt;
+  }
+  return len;
+}
+
+std::optional<std::vector<uint8_t>> decode(const std::string& input) {
+  std::vector<uint8_t> bytes(input.length() / 2);
+  if (!decode(std::string_view(input), bytes)) {
+    return std::nullopt;
+  }
+  return bytes;
+}
 
-  // 移除分隔符
-  for (char c : input) {
-    if (c != separator) {
-      clean_hex.push_back(c);
+std::optional<size_t> decodeWithSeparator(std::string_view input, std::span<uint8_t> out, char separator) {
+  // 分隔符本身不是十六进制字符、且长度符合 3n-1 时先尝试按固定步长解码
+  if (kNibbles[static_cast<uint8_t>(separator)] == 0xFF && (input.length() + 1) % 3 == 0) {
+    const size_t count = (input.length() + 1) / 3;
+    if (out.size() < count) {
+      throw std::length_error("hex::decodeWithSeparator: output buffer too small");
+    }
+    if (decodeStrided(input.data(), count, out.data(), separator)) {
+      return count;
     }
   }
+  return decodeSkipping(input, out.data(), out.size(), separator);
+}
 
-  return decode(clean_hex);
+std::optional<std::vector<uint8_t>> decodeWithSeparator(const std::string& input, char separator) {
+  std::vector<uint8_t> bytes(maxDecodedLength(input.length()));
+  const auto written = decodeWithSeparator(std::string_view(input), bytes, separator);
+  if (!written) {
+    return std::nullopt;
+  }
+  bytes.resize(*written);
+  return bytes;
 }
 
 std::string encode(uint8_t value, bool uppercase) {
-  const char* hex_table = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+  const char* hex_table = uppercase ? kUpperDigits : kLowerDigits;
   return {hex_table[value >> 4], hex_table[value & 0x0F]};
 }
 
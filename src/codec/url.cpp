@@ -1,49 +1,251 @@
 #include "pickup/codec/url.h"
 
-#include <cctype>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#include "pickup/utils/ByteSet.h"
+#include "pickup/utils/CpuFeatures.h"
+
+#if PICKUP_X86_SIMD
+#include <immintrin.h>
+#endif
 
 namespace pickup {
 namespace codec {
 namespace url {
 
-// 将十六进制字符转换为数值
-static unsigned char hexToValue(unsigned char x) {
-  if (x >= '0' && x <= '9') {
-    return x - '0';
+namespace {
+
+constexpr char kHexTable[] = "0123456789ABCDEF";
+
+// 十六进制字符 → 4 位值，0xFF 表示非法字符
+constexpr std::array<uint8_t, 256> kHexValues = [] {
+  std::array<uint8_t, 256> table{};
+  for (auto& v : table) {
+    v = 0xFF;
+  }
+  for (size_t i = 0; i < 10; ++i) {
+    table['0' + i] = static_cast<uint8_t>(i);
   }
-  if (x >= 'A' && x <= 'F') {
-    return x - 'A' + 10;
+  for (size_t i = 0; i < 6; ++i) {
+    table['A' + i] = static_cast<uint8_t>(10 + i);
+    table['a' + i] = static_cast<uint8_t>(10 + i);
+  }
+  return table;
+}();
+
+using utils::detail::ByteTable;
+
+// 编码时原样保留的字符集合：unreserved 加上 extra
+constexpr ByteTable makeKeepSet(std::string_view extra) {
+  ByteTable set = utils::detail::makeByteTable("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-._~");
+  for (const char c : extra) set.add(static_cast<unsigned char>(c));
+  return set;
+}
+
+// RFC 3986：unreserved 总是保留；路径段另外保留 sub-delims 与 ':' '@' '/'，
+// 查询串保留 sub-delims 中除 '&' '=' '+' 外的字符（它们在键值对中有特殊含义）
+constexpr ByteTable kUnreservedSet = makeKeepSet("");
+constexpr ByteTable kPathSet = makeKeepSet("!$&'()*+,;=:@/");
+constexpr ByteTable kQuerySet = makeKeepSet("!$'()*,;:@/?");
+
+const ByteTable& charSetOf(Component component) {
+  switch (component) {
+    case Component::Path:
+      return kPathSet;
+    case Component::Query:
+      return kQuerySet;
+    case Component::Unreserved:
+    case Component::Form:
+    default:
+      return kUnreservedSet;
   }
-  if (x >= 'a' && x <= 'f') {
-    return x - 'a' + 10;
+}
+
+// ---------------------------------------------------------------------------
+// 扫描：keepRun 返回从 in 开始连续属于集合的字节数，plainRun 返回不含特殊字符的字节数。
+// ---------------------------------------------------------------------------
+
+// 返回从 in 开始不含 '%'（以及 plusIsSpace 时的 '+'）的字节数
+size_t plainRunScalar(const char* in, size_t len, bool plusIsSpace) {
+  size_t i = 0;
+  while (i < len && in[i] != '%' && !(plusIsSpace && in[i] == '+')) {
+    ++i;
   }
-  return 0;
+  return i;
 }
 
-std::string encode(const std::string& input) {
-  std::string result;
-  result.reserve(input.length() * 3);
+#if PICKUP_X86_SIMD
+
+PICKUP_TARGET("ssse3") size_t plainRunSSSE3(const char* in, size_t len, bool plusIsSpace) {
+  const __m128i percent = _mm_set1_epi8('%');
+  // 不把 '+' 当特殊字符时用 '%' 代替，比较结果不变
+  const __m128i plus = _mm_set1_epi8(plusIsSpace ? '+' : '%');
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    const int special = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(c, percent), _mm_cmpeq_epi8(c, plus)));
+    if (special != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(special)));
+    }
+  }
+  return i + plainRunScalar(in + i, len - i, plusIsSpace);
+}
 
-  static const char kHexTable[] = "0123456789ABCDEF";
-  for (unsigned char ch : input) {
-    if (std::isalnum(ch) || ch == '-' || ch == '_' || ch == '.' || ch == '~') {
-      result += static_cast<char>(ch);
-    } else if (ch == ' ') {
-      result += '+';
+PICKUP_TARGET("avx2") size_t plainRunAVX2(const char* in, size_t len, bool plusIsSpace) {
+  const __m256i percent = _mm256_set1_epi8('%');
+  const __m256i plus = _mm256_set1_epi8(plusIsSpace ? '+' : '%');
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    const auto special = static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(c, percent), _mm256_cmpeq_epi8(c, plus))));
+    if (special != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(special));
+    }
+  }
+  return i + plainRunScalar(in + i, len - i, plusIsSpace);
+}
+
+#endif  // PICKUP_X86_SIMD
+
+// 查表与 SIMD 内核见 utils/ByteSet.h，与 StringUtils 共用
+size_t keepRun(const char* in, size_t len, const ByteTable& set) {
+  return utils::detail::scanByteSet(in, len, set, false);
+}
+
+size_t plainRun(const char* in, size_t len, bool plusIsSpace) {
+#if PICKUP_X86_SIMD
+  const utils::SimdLevel level = utils::simdLevel();
+  if (level >= utils::SimdLevel::AVX2) {
+    return plainRunAVX2(in, len, plusIsSpace);
+  }
+  if (level >= utils::SimdLevel::SSSE3) {
+    return plainRunSSSE3(in, len, plusIsSpace);
+  }
+#endif
+  return plainRunScalar(in, len, plusIsSpace);
+}
+
+// 写出编码结果，out 须至少 encodedLength(input, component) 字节
+size_t encodeImpl(std::string_view input, char* out, Component component) {
+  const ByteTable& set = charSetOf(component);
+  const bool spaceAsPlus = component == Component::Form;
+  const char* in = input.data();
+  const size_t len = input.size();
+  char* o = out;
+  size_t i = 0;
+  while (i < len) {
+    const size_t run = keepRun(in + i, len - i, set);
+    std::memcpy(o, in + i, run);
+    o += run;
+    i += run;
+    if (i == len) {
+      break;
+    }
+    const auto ch = static_cast<unsigned char>(in[i++]);
+    if (spaceAsPlus && ch == ' ') {
+      *o++ = '+';
     } else {
-      result += '%';
-      result += kHexTable[(ch >> 4) & 0x0F];
-      result += kHexTable[ch & 0x0F];
+      o[0] = '%';
+      o[1] = kHexTable[ch >> 4];
+      o[2] = kHexTable[ch & 0x0F];
+      o += 3;
     }
   }
+  return static_cast<size_t>(o - out);
+}
+
+// out 可与 input 指向同一内存：写位置永远不超过读位置
+DecodeStatus decodeImpl(std::string_view input, char* out, Component component) {
+  const bool plusIsSpace = component == Component::Form;
+  const char* in = input.data();
+  const size_t len = input.size();
+  size_t i = 0;
+  size_t o = 0;
+  while (i < len) {
+    const size_t run = plainRun(in + i, len - i, plusIsSpace);
+    if (out + o != in + i) {
+      std::memmove(out + o, in + i, run);
+    }
+    o += run;
+    i += run;
+    if (i == len) {
+      break;
+    }
+    if (in[i] == '+') {
+      out[o++] = ' ';
+      ++i;
+      continue;
+    }
+    if (len - i < 3) {
+      return DecodeStatus{false, o, i};  // 不完整的转义序列
+    }
+    const uint8_t high = kHexValues[static_cast<uint8_t>(in[i + 1])];
+    const uint8_t low = kHexValues[static_cast<uint8_t>(in[i + 2])];
+    if ((high | low) > 0x0F) {
+      return DecodeStatus{false, o, i};
+    }
+    out[o++] = static_cast<char>((high << 4) | low);
+    i += 3;
+  }
+  return DecodeStatus{true, o, len};
+}
+
+// 旧版 decode 的容错规则：非十六进制字符按 0 处理
+uint8_t legacyHexValue(char c) {
+  const uint8_t v = kHexValues[static_cast<uint8_t>(c)];
+  return v > 0x0F ? 0 : v;
+}
+
+}  // namespace
+
+size_t encodedLength(std::string_view input, Component component) {
+  const ByteTable& set = charSetOf(component);
+  const bool spaceAsPlus = component == Component::Form;
+  size_t total = input.size();
+  size_t i = 0;
+  while (i < input.size()) {
+    i += keepRun(input.data() + i, input.size() - i, set);
+    if (i == input.size()) {
+      break;
+    }
+    if (!(spaceAsPlus && input[i] == ' ')) {
+      total += 2;
+    }
+    ++i;
+  }
+  return total;
+}
+
+std::string encode(const std::string& input) { return encode(std::string_view(input), Component::Form); }
+
+std::string encode(std::string_view input, Component component) {
+  std::string result(encodedLength(input, component), '\0');
+  encodeImpl(input, result.data(), component);
   return result;
 }
 
+size_t encode(std::string_view input, std::span<char> out, Component component) {
+  const size_t needed = encodedLength(input, component);
+  if (out.size() < needed) {
+    throw std::length_error("url::encode: output buffer too small");
+  }
+  return encodeImpl(input, out.data(), component);
+}
+
 std::string decode(const std::string& input) {
-  std::string result;
-  result.reserve(input.length());
+  std::string result(input.size(), '\0');
+  const DecodeStatus status = decodeImpl(input, result.data(), Component::Form);
+  if (status.ok) {
+    result.resize(status.written);
+    return result;
+  }
 
-  for (size_t i = 0; i < input.length(); ++i) {
+  // 兼容旧行为：非十六进制字符按 0 处理，不完整的转义序列输出 '?' 并结束
+  result.resize(status.written);
+  for (size_t i = status.errorOffset; i < input.length(); ++i) {
     char ch = input[i];
     if (ch == '%') {
       if (i + 2 >= input.size()) {
@@ -51,8 +253,8 @@ std::string decode(const std::string& input) {
         break;
       }
 
-      const char hi = hexToValue(input[i + 1]);
-      const char lo = hexToValue(input[i + 2]);
+      const uint8_t hi = legacyHexValue(input[i + 1]);
+      const uint8_t lo = legacyHexValue(input[i + 2]);
       result += static_cast<char>((hi << 4) + lo);
       i += 2;
     } else if (ch == '+') {
@@ -64,6 +266,74 @@ std::string decode(const std::string& input) {
   return result;
 }
 
+DecodeStatus decode(std::string_view input, std::span<char> out, Component component) {
+  if (out.size() < input.size()) {
+    throw std::length_error("url::decode: output buffer too small");
+  }
+  return decodeImpl(input, out.data(), component);
+}
+
+std::optional<std::string> decodeStrict(std::string_view input, Component component, size_t* errorOffset) {
+  std::string result(input.size(), '\0');
+  const DecodeStatus status = decodeImpl(input, result.data(), component);
+  if (errorOffset != nullptr) {
+    *errorOffset = status.errorOffset;
+  }
+  if (!status.ok) {
+    return std::nullopt;
+  }
+  result.resize(status.written);
+  return result;
+}
+
+bool decodeInPlace(std::string& inout, Component component, size_t* errorOffset) {
+  const DecodeStatus status = decodeImpl(inout, inout.data(), component);
+  if (errorOffset != nullptr) {
+    *errorOffset = status.errorOffset;
+  }
+  if (!status.ok) {
+    return false;
+  }
+  inout.resize(status.written);
+  return true;
+}
+
+QueryString::QueryString(std::string_view query) : query_(query) {
+  if (!query_.empty() && query_.front() == '?') {
+    query_.remove_prefix(1);
+  }
+  const size_t fragment = query_.find('#');
+  if (fragment != std::string_view::npos) {
+    query_ = query_.substr(0, fragment);
+  }
+}
+
+void QueryString::Iterator::advance() {
+  while (!rest_.empty()) {
+    const size_t amp = rest_.find('&');
+    const std::string_view segment = rest_.substr(0, amp);
+    rest_ = amp == std::string_view::npos ? std::string_view() : rest_.substr(amp + 1);
+    if (segment.empty()) {
+      continue;
+    }
+    const size_t eq = segment.find('=');
+    current_.key = segment.substr(0, eq);
+    current_.value = eq == std::string_view::npos ? std::string_view() : segment.substr(eq + 1);
+    return;
+  }
+  current_ = QueryParam{};
+  atEnd_ = true;
+}
+
+std::optional<std::string_view> QueryString::find(std::string_view key) const {
+  for (const QueryParam& param : *this) {
+    if (param.key == key) {
+      return param.value;
+    }
+  }
+  return std::nullopt;
+}
+
 }  // namespace url
 }  // namespace codec
 }  // namespace pickup
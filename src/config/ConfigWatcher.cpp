@@ -0,0 +1,143 @@
+#include "pickup/config/ConfigWatcher.h"
+
+#include <filesystem>
+#include <system_error>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace pickup {
+namespace config {
+
+FileWatcher::~FileWatcher() {
+  stop();
+}
+
+bool FileWatcher::start(const std::string& path, Callback onChange, std::chrono::milliseconds settle) {
+  if (running()) return false;
+  stop();  // 回收因监视失效而自行退出的线程
+
+  path_ = path;
+  onChange_ = std::move(onChange);
+  settle_ = settle;
+  stopping_.store(false, std::memory_order_relaxed);
+
+#if defined(__linux__)
+  std::filesystem::path dir = std::filesystem::path(path).parent_path();
+  if (dir.empty()) dir = ".";
+
+  notifyFd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (notifyFd_ < 0) return false;
+  wakeFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (wakeFd_ < 0 || ::inotify_add_watch(notifyFd_, dir.c_str(),
+                                         IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE |
+                                             IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR) < 0) {
+    ::close(notifyFd_);
+    notifyFd_ = -1;
+    if (wakeFd_ >= 0) ::close(wakeFd_);
+    wakeFd_ = -1;
+    return false;
+  }
+#endif
+
+  active_.store(true, std::memory_order_release);
+  thread_ = thread::Thread("cfg-watch", &FileWatcher::run, this);
+  return true;
+}
+
+void FileWatcher::stop() {
+  if (!thread_.joinable()) return;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_.store(true, std::memory_order_relaxed);
+  }
+  wakeup_.notify_all();
+#if defined(__linux__)
+  const uint64_t one = 1;
+  [[maybe_unused]] ssize_t n = ::write(wakeFd_, &one, sizeof(one));
+#endif
+  thread_.join();
+  active_.store(false, std::memory_order_release);
+
+#if defined(__linux__)
+  ::close(notifyFd_);
+  ::close(wakeFd_);
+  notifyFd_ = -1;
+  wakeFd_ = -1;
+#endif
+}
+
+#if defined(__linux__)
+
+void FileWatcher::run() {
+  const std::string name = std::filesystem::path(path_).filename().string();
+  alignas(struct inotify_event) char buffer[4096];
+  bool pending = false;
+
+  while (!stopping_.load(std::memory_order_relaxed)) {
+    pollfd fds[2] = {{notifyFd_, POLLIN, 0}, {wakeFd_, POLLIN, 0}};
+    // 有待处理的变化时，只等待 settle 时长：期间无新事件即视为写入结束
+    const int timeout = pending ? static_cast<int>(settle_.count()) : -1;
+    const int ready = ::poll(fds, 2, timeout);
+    if (ready < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+    if (ready == 0) {
+      pending = false;
+      onChange_();
+      continue;
+    }
+    if (fds[1].revents & POLLIN) break;
+
+    bool watchLost = false;
+    for (;;) {
+      const ssize_t len = ::read(notifyFd_, buffer, sizeof(buffer));
+      if (len <= 0) break;
+      for (ssize_t offset = 0; offset < len;) {
+        inotify_event event;
+        std::memcpy(&event, buffer + offset, sizeof(event));
+        const char* eventName = buffer + offset + static_cast<ssize_t>(sizeof(inotify_event));
+        if (event.mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+          watchLost = true;
+        } else if (event.len > 0 && name == eventName) {
+          pending = true;
+        }
+        offset += static_cast<ssize_t>(sizeof(inotify_event) + event.len);
+      }
+    }
+    // 目录本身被删除或移走，监视已失效
+    if (watchLost) break;
+  }
+  // 无论因 stop() 还是监视失效退出，都不再监视；线程与描述符留给 stop()/start() 回收
+  active_.store(false, std::memory_order_release);
+}
+
+#else
+
+void FileWatcher::run() {
+  std::error_code ec;
+  auto lastWrite = std::filesystem::last_write_time(path_, ec);
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!wakeup_.wait_for(lock, settle_, [this] { return stopping_.load(std::memory_order_relaxed); })) {
+    const auto current = std::filesystem::last_write_time(path_, ec);
+    if (!ec && current != lastWrite) {
+      lastWrite = current;
+      lock.unlock();
+      onChange_();
+      lock.lock();
+    }
+  }
+}
+
+#endif
+
+}  // namespace config
+}  // namespace pickup
@@ -0,0 +1,133 @@
+#include "pickup/config/INIParser.h"
+
+#include <cstring>
+
+#include "pickup/buffer/MappedFile.h"
+
+namespace pickup {
+namespace config {
+
+namespace {
+
+// 与 C locale 下的 std::isspace 一致，避免逐字符的函数调用
+constexpr bool isSpace(char c) noexcept {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+std::string_view trimRight(std::string_view s) noexcept {
+  while (!s.empty() && isSpace(s.back())) s.remove_suffix(1);
+  return s;
+}
+
+std::string_view trimLeft(std::string_view s) noexcept {
+  while (!s.empty() && isSpace(s.front())) s.remove_prefix(1);
+  return s;
+}
+
+/** @brief 返回第一个满足 isTarget 的字符或行内注释（空白之后的 ';'）的位置 */
+template <typename IsTarget>
+size_t findOrComment(std::string_view s, IsTarget isTarget) noexcept {
+  bool wasSpace = false;
+  for (size_t i = 0; i < s.size(); ++i) {
+    const char c = s[i];
+    if (isTarget(c)) return i;
+    if (wasSpace && c == ';') return i;
+    wasSpace = isSpace(c);
+  }
+  return s.size();
+}
+
+size_t findComment(std::string_view s) noexcept {
+  return findOrComment(s, [](char) { return false; });
+}
+
+class CallbackHandler : public INIParser::Handler {
+ public:
+  explicit CallbackHandler(const INIParser::ValueCallback& onValue) : onValue_(onValue) {}
+
+  bool onValue(std::string_view section, std::string_view name, std::string_view value, int) override {
+    return onValue_(section, name, value);
+  }
+
+ private:
+  const INIParser::ValueCallback& onValue_;
+};
+
+}  // namespace
+
+std::optional<INIParser::ParseError> INIParser::parse(std::string_view text, Handler& handler) {
+  std::optional<ParseError> error;
+  std::string_view section;
+  std::string_view prevName;
+  int lineno = 0;
+
+  const char* pos = text.data();
+  const char* const end = text.data() + text.size();
+  while (pos < end) {
+    const char* eol = static_cast<const char*>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+    if (!eol) eol = end;
+    std::string_view line(pos, static_cast<size_t>(eol - pos));
+    pos = eol + 1;
+    ++lineno;
+
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+    if (lineno == 1 && line.size() >= 3 && static_cast<unsigned char>(line[0]) == 0xEF &&
+        static_cast<unsigned char>(line[1]) == 0xBB && static_cast<unsigned char>(line[2]) == 0xBF) {
+      line.remove_prefix(3);
+    }
+
+    const bool hasLeadingSpace = !line.empty() && isSpace(line[0]);
+    const std::string_view start = trimLeft(trimRight(line));
+
+    if (start.empty() || start[0] == ';' || start[0] == '#') {
+      continue;
+    }
+
+    if (!prevName.empty() && hasLeadingSpace) {
+      const std::string_view value = trimRight(start.substr(0, findComment(start)));
+      if (!handler.onContinuation(section, prevName, value, lineno)) break;
+    } else if (start[0] == '[') {
+      const std::string_view after = start.substr(1);
+      const size_t close = findOrComment(after, [](char c) { return c == ']'; });
+      if (close < after.size() && after[close] == ']') {
+        section = after.substr(0, close);
+        prevName = {};
+        if (!handler.onSection(section, lineno)) break;
+      } else {
+        if (!error) error = ParseError{ParseError::Kind::Syntax, lineno};
+        if (!handler.onError(lineno)) break;
+      }
+    } else {
+      const size_t sep = findOrComment(start, [](char c) { return c == '=' || c == ':'; });
+      if (sep < start.size() && (start[sep] == '=' || start[sep] == ':')) {
+        const std::string_view name = trimRight(start.substr(0, sep));
+        std::string_view value = trimLeft(start.substr(sep + 1));
+        value = trimRight(value.substr(0, findComment(value)));
+        prevName = name;
+        if (!handler.onValue(section, name, value, lineno)) break;
+      } else {
+        if (!error) error = ParseError{ParseError::Kind::Syntax, lineno};
+        if (!handler.onError(lineno)) break;
+      }
+    }
+  }
+  return error;
+}
+
+std::optional<INIParser::ParseError> INIParser::parse(std::string_view text, const ValueCallback& onValue) {
+  CallbackHandler handler(onValue);
+  return parse(text, handler);
+}
+
+std::optional<INIParser::ParseError> INIParser::parseFile(const std::string& path, Handler& handler) {
+  buffer::MappedFile file;
+  if (!file.openRead(path)) {
+    return ParseError{ParseError::Kind::FileOpen};
+  }
+  file.advise(buffer::MappedFile::Advice::Sequential);
+  return parse(file.view(), handler);
+}
+
+}  // namespace config
+}  // namespace pickup
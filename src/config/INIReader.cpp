@@ -1,175 +1,386 @@
 #include "pickup/config/INIReader.h"
 
-#include <algorithm>
 #include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <string>
+#include <unordered_map>
 
 namespace pickup {
 namespace config {
 
+namespace {
+
+constexpr char asciiLower(char c) noexcept {
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) noexcept {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (asciiLower(a[i]) != asciiLower(b[i])) return false;
+  }
+  return true;
+}
+
+// 大小写不敏感的 FNV-1a，与 CaseInsensitiveEqual 配合作为 unordered_map 的哈希
+struct CaseInsensitiveHash {
+  size_t operator()(std::string_view s) const noexcept {
+    uint64_t h = 14695981039346656037ULL;
+    for (char c : s) {
+      h ^= static_cast<unsigned char>(asciiLower(c));
+      h *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(h);
+  }
+};
+
+struct CaseInsensitiveEqual {
+  bool operator()(std::string_view a, std::string_view b) const noexcept { return equalsIgnoreCase(a, b); }
+};
+
+template <typename T>
+using CaseInsensitiveMap = std::unordered_map<std::string_view, T, CaseInsensitiveHash, CaseInsensitiveEqual>;
+
+std::string readAll(std::istream& stream) {
+  return {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+}
+
+bool hasHexPrefix(const char* first, const char* last) noexcept {
+  return last - first >= 2 && first[0] == '0' && (first[1] == 'x' || first[1] == 'X');
+}
+
+// 与 std::stol(s, &idx, 0) 一致：可选正负号，0x 十六进制、0 开头八进制，接受有效前缀
+std::optional<long> parseIntegerPrefix(std::string_view s) noexcept {
+  const char* first = s.data();
+  const char* last = first + s.size();
+  bool negative = false;
+  if (first != last && (*first == '+' || *first == '-')) {
+    negative = *first == '-';
+    ++first;
+  }
+  int base = 10;
+  if (hasHexPrefix(first, last)) {
+    base = 16;
+    first += 2;
+  } else if (first != last && *first == '0') {
+    base = 8;
+  }
+
+  unsigned long magnitude = 0;
+  auto [ptr, ec] = std::from_chars(first, last, magnitude, base);
+  if (ec == std::errc::result_out_of_range) return std::nullopt;
+  if (ptr == first) {
+    // "0x" 后面没有十六进制数字时只有 "0" 被解析
+    if (base == 16) return 0L;
+    return std::nullopt;
+  }
+  constexpr auto kMax = static_cast<unsigned long>(std::numeric_limits<long>::max());
+  if (magnitude > kMax + (negative ? 1UL : 0UL)) return std::nullopt;
+  return negative ? static_cast<long>(0UL - magnitude) : static_cast<long>(magnitude);
+}
+
+// 与 std::stod/stof 一致：可选正负号，接受十六进制浮点、inf/nan 与有效前缀
+template <typename T>
+std::optional<T> parseRealPrefix(std::string_view s) noexcept {
+  const char* first = s.data();
+  const char* last = first + s.size();
+  bool negative = false;
+  if (first != last && (*first == '+' || *first == '-')) {
+    negative = *first == '-';
+    ++first;
+    if (first != last && (*first == '+' || *first == '-')) return std::nullopt;
+  }
+  auto format = std::chars_format::general;
+  if (hasHexPrefix(first, last)) {
+    format = std::chars_format::hex;
+    first += 2;
+  }
+  T value{};
+  auto [ptr, ec] = std::from_chars(first, last, value, format);
+  if (ec == std::errc::invalid_argument && format == std::chars_format::hex) {
+    value = 0;
+  } else if (ec != std::errc{}) {
+    return std::nullopt;
+  }
+  return negative ? -value : value;
+}
+
+struct DurationUnit {
+  std::string_view name;
+  int64_t nanoseconds;
+};
+
+constexpr DurationUnit kDurationUnits[] = {
+    {"ns", 1LL},
+    {"us", 1000LL},
+    {"\xC2\xB5s", 1000LL},  // µs
+    {"ms", 1000000LL},
+    {"s", 1000000000LL},
+    {"m", 60LL * 1000000000LL},
+    {"min", 60LL * 1000000000LL},
+    {"h", 3600LL * 1000000000LL},
+    {"d", 86400LL * 1000000000LL},
+};
+
+bool isDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+bool isSpace(char c) noexcept { return std::isspace(static_cast<unsigned char>(c)) != 0; }
+
+}  // namespace
+
+struct INIReader::Data {
+  struct Entry {
+    Value value;                    ///< value.text 指向 text 或 joined 中的某个字符串
+    std::string* joined = nullptr;  ///< 续行/重复 key 拼接后的值，单行值为空
+  };
+  using Section = CaseInsensitiveMap<Entry>;
+
+  std::string text;                      ///< 文件内容，所有 key/单行值的视图都指向这里
+  std::deque<std::string> joined;        ///< 拼接值的存储，deque 保证元素地址稳定
+  CaseInsensitiveMap<Section> sections;  ///< section 名 -> (key 名 -> 值)
+
+  const Entry* find(std::string_view section, std::string_view name) const noexcept {
+    auto sit = sections.find(section);
+    if (sit == sections.end()) return nullptr;
+    auto it = sit->second.find(name);
+    return it != sit->second.end() ? &it->second : nullptr;
+  }
+
+  void append(Entry& entry, std::string_view piece) {
+    if (!entry.joined) entry.joined = &joined.emplace_back(entry.value.text);
+    entry.joined->push_back('\n');
+    entry.joined->append(piece);
+    entry.value.text = *entry.joined;
+  }
+
+};
+
 INIReader::INIReader(const std::string& filename) {
-  std::ifstream file(filename);
-  if (!file.is_open())
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
     error_ = ParseError{ParseError::Kind::FileOpen};
-  else
-    parse(file);
+    return;
+  }
+  file.seekg(0, std::ios::end);
+  const std::streamoff size = file.tellg();
+  file.seekg(0, std::ios::beg);
+  std::string text;
+  if (size > 0 && file) {
+    text.resize(static_cast<size_t>(size));
+    file.read(text.data(), size);
+    text.resize(static_cast<size_t>(file.gcount()));
+  } else {
+    file.clear();
+    text = readAll(file);
+  }
+  parse(std::move(text));
 }
 
 INIReader::INIReader(std::istream& stream) {
-  parse(stream);
+  parse(readAll(stream));
+}
+
+auto INIReader::lookup(std::string_view section, std::string_view name) const noexcept -> const Value* {
+  if (!data_) return nullptr;
+  const Data::Entry* entry = data_->find(section, name);
+  return entry ? &entry->value : nullptr;
+}
+
+bool INIReader::hasValue(std::string_view section, std::string_view name) const noexcept {
+  return lookup(section, name) != nullptr;
+}
+
+std::optional<std::string_view> INIReader::find(std::string_view section,
+                                                std::string_view name) const noexcept {
+  const Value* value = lookup(section, name);
+  if (!value) return std::nullopt;
+  return value->text;
 }
 
-bool INIReader::hasValue(const std::string& section, const std::string& name) const {
-  return values_.count(makeKey(section, name)) > 0;
+std::string_view INIReader::getView(std::string_view section, std::string_view name,
+                                    std::string_view default_value) const noexcept {
+  return find(section, name).value_or(default_value);
 }
 
-std::string INIReader::get(const std::string& section, const std::string& name,
-                           const std::string& default_value) const {
-  auto it = values_.find(makeKey(section, name));
-  return it != values_.end() ? it->second : default_value;
+std::string INIReader::get(std::string_view section, std::string_view name,
+                           std::string_view default_value) const {
+  return std::string(getView(section, name, default_value));
 }
 
-long INIReader::getInteger(const std::string& section, const std::string& name,
+long INIReader::getInteger(std::string_view section, std::string_view name,
                            long default_value) const {
-  std::string valstr = get(section, name, "");
-  if (valstr.empty()) return default_value;
-  try {
-    size_t idx;
-    long n = std::stol(valstr, &idx, 0);
-    return idx > 0 ? n : default_value;
-  } catch (...) {
-    return default_value;
-  }
+  const Value* value = lookup(section, name);
+  if (!value) return default_value;
+  return cached<long>(*value, Value::Kind::IntegerPrefix, &parseIntegerPrefix).value_or(default_value);
 }
 
-double INIReader::getReal(const std::string& section, const std::string& name,
+double INIReader::getReal(std::string_view section, std::string_view name,
                           double default_value) const {
-  std::string valstr = get(section, name, "");
-  if (valstr.empty()) return default_value;
-  try {
-    size_t idx;
-    double n = std::stod(valstr, &idx);
-    return idx > 0 ? n : default_value;
-  } catch (...) {
-    return default_value;
-  }
+  const Value* value = lookup(section, name);
+  if (!value) return default_value;
+  return cached<double>(*value, Value::Kind::RealPrefix, &parseRealPrefix<double>).value_or(default_value);
 }
 
-float INIReader::getFloat(const std::string& section, const std::string& name,
+float INIReader::getFloat(std::string_view section, std::string_view name,
                           float default_value) const {
-  std::string valstr = get(section, name, "");
-  if (valstr.empty()) return default_value;
-  try {
-    size_t idx;
-    float n = std::stof(valstr, &idx);
-    return idx > 0 ? n : default_value;
-  } catch (...) {
-    return default_value;
-  }
+  const Value* value = lookup(section, name);
+  if (!value) return default_value;
+  return cached<float>(*value, Value::Kind::FloatPrefix, &parseRealPrefix<float>).value_or(default_value);
 }
 
-bool INIReader::getBoolean(const std::string& section, const std::string& name,
+bool INIReader::getBoolean(std::string_view section, std::string_view name,
                            bool default_value) const {
-  std::string valstr = get(section, name, "");
-  std::transform(valstr.begin(), valstr.end(), valstr.begin(),
-                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-  if (valstr == "true" || valstr == "yes" || valstr == "on" || valstr == "1")
-    return true;
-  if (valstr == "false" || valstr == "no" || valstr == "off" || valstr == "0")
-    return false;
-  return default_value;
+  const Value* value = lookup(section, name);
+  if (!value) return default_value;
+  return cached<bool>(*value, Value::Kind::Boolean, &parseBoolean).value_or(default_value);
 }
 
-std::string INIReader::makeKey(const std::string& section, const std::string& name) {
-  std::string key = section + "=" + name;
-  std::transform(key.begin(), key.end(), key.begin(),
-                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-  return key;
+void INIReader::forEach(
+    const std::function<void(std::string_view section, std::string_view name, std::string_view value)>& visitor)
+    const {
+  if (!data_) return;
+  for (const auto& [section, entries] : data_->sections) {
+    for (const auto& [name, entry] : entries) visitor(section, name, entry.value.text);
+  }
 }
 
-std::string INIReader::trimRight(const std::string& s) {
-  auto end = s.end();
-  while (end != s.begin() && std::isspace(static_cast<unsigned char>(*(end - 1))))
-    --end;
-  return {s.begin(), end};
+std::optional<bool> INIReader::parseBoolean(std::string_view text) noexcept {
+  if (equalsIgnoreCase(text, "true") || equalsIgnoreCase(text, "yes") ||
+      equalsIgnoreCase(text, "on") || text == "1")
+    return true;
+  if (equalsIgnoreCase(text, "false") || equalsIgnoreCase(text, "no") ||
+      equalsIgnoreCase(text, "off") || text == "0")
+    return false;
+  return std::nullopt;
 }
 
-std::string INIReader::trimLeft(const std::string& s) {
-  auto begin = s.begin();
-  while (begin != s.end() && std::isspace(static_cast<unsigned char>(*begin)))
-    ++begin;
-  return {begin, s.end()};
-}
+std::optional<time::Timespan> INIReader::parseDuration(std::string_view text) noexcept {
+  text = trimLeft(trimRight(text));
+  bool negative = false;
+  if (!text.empty() && text.front() == '-') {
+    negative = true;
+    text.remove_prefix(1);
+  }
+  if (text == "0") return time::Timespan::zero();
+  if (text.empty()) return std::nullopt;
+
+  constexpr int64_t kMax = std::numeric_limits<int64_t>::max();
+  int64_t total = 0;
+  while (!text.empty()) {
+    // 整数部分
+    int64_t whole = 0;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), whole);
+    if (ec != std::errc{} || whole < 0) return std::nullopt;
+    size_t pos = static_cast<size_t>(ptr - text.data());
+
+    // 小数部分，最多取 18 位
+    int64_t fraction = 0;
+    int64_t scale = 1;
+    if (pos < text.size() && text[pos] == '.') {
+      ++pos;
+      const size_t digitsBegin = pos;
+      for (; pos < text.size() && isDigit(text[pos]); ++pos) {
+        if (scale < 1000000000000000000LL) {
+          fraction = fraction * 10 + (text[pos] - '0');
+          scale *= 10;
+        }
+      }
+      if (pos == digitsBegin) return std::nullopt;
+    }
+    while (pos < text.size() && isSpace(text[pos])) ++pos;
+
+    // 单位
+    const size_t unitBegin = pos;
+    while (pos < text.size() && !isDigit(text[pos]) && !isSpace(text[pos]) && text[pos] != '.') ++pos;
+    const std::string_view unitName = text.substr(unitBegin, pos - unitBegin);
+    int64_t unit = 0;
+    for (const auto& candidate : kDurationUnits) {
+      if (candidate.name == unitName) unit = candidate.nanoseconds;
+    }
+    if (unit == 0) return std::nullopt;
+
+    // 小数部分不超过 unit，先算出来，再检查整数部分加上它是否溢出
+    const auto fracPart = static_cast<int64_t>(std::llround(static_cast<long double>(fraction) /
+                                                            static_cast<long double>(scale) *
+                                                            static_cast<long double>(unit)));
+    if (whole > kMax / unit || whole * unit > kMax - fracPart) return std::nullopt;
+    const int64_t part = whole * unit + fracPart;
+    if (part > kMax - total) return std::nullopt;
+    total += part;
 
-size_t INIReader::findCharsOrComment(const std::string& s, const std::string& chars) {
-  bool was_space = false;
-  for (size_t i = 0; i < s.size(); ++i) {
-    char c = s[i];
-    if (!chars.empty() && chars.find(c) != std::string::npos)
-      return i;
-    if (was_space && c == ';')
-      return i;
-    was_space = std::isspace(static_cast<unsigned char>(c)) != 0;
+    while (pos < text.size() && isSpace(text[pos])) ++pos;
+    text.remove_prefix(pos);
   }
-  return s.size();
+  return time::Timespan(negative ? -total : total);
 }
 
-void INIReader::parse(std::istream& stream) {
-  std::string section;
-  std::string prev_name;
-  int lineno = 0;
+std::string_view INIReader::trimRight(std::string_view s) {
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back())))
+    s.remove_suffix(1);
+  return s;
+}
+
+std::string_view INIReader::trimLeft(std::string_view s) {
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front())))
+    s.remove_prefix(1);
+  return s;
+}
 
-  for (std::string raw_line; std::getline(stream, raw_line);) {
-    ++lineno;
+void INIReader::parse(std::string text) {
+  // 先把文本移入最终位置再切视图：std::string 移动时短字符串的缓冲区会跟着搬家
+  auto data = std::make_shared<Data>();
+  data->text = std::move(text);
 
-    if (!raw_line.empty() && raw_line.back() == '\r')
-      raw_line.pop_back();
+  // 把解析事件写入 Data：键值对建索引，续行与重复键拼接
+  class Builder : public INIParser::Handler {
+   public:
+    Builder(Data& data, std::set<std::string>& sections) : data_(data), sections_(sections) {}
 
-    if (lineno == 1 && raw_line.size() >= 3 &&
-        static_cast<unsigned char>(raw_line[0]) == 0xEF &&
-        static_cast<unsigned char>(raw_line[1]) == 0xBB &&
-        static_cast<unsigned char>(raw_line[2]) == 0xBF) {
-      raw_line = raw_line.substr(3);
+    bool onSection(std::string_view, int) override {
+      recorded_ = false;
+      return true;
     }
 
-    bool has_leading_space =
-        !raw_line.empty() && std::isspace(static_cast<unsigned char>(raw_line[0]));
-    std::string start = trimLeft(trimRight(raw_line));
-
-    if (start.empty() || start[0] == ';' || start[0] == '#') {
-    } else if (!prev_name.empty() && has_leading_space) {
-      size_t end = findCharsOrComment(start, "");
-      std::string val = trimRight(start.substr(0, end));
-      values_[makeKey(section, prev_name)] += "\n" + val;
-    } else if (start[0] == '[') {
-      std::string after = start.substr(1);
-      size_t end = findCharsOrComment(after, "]");
-      if (end < after.size() && after[end] == ']') {
-        section = after.substr(0, end);
-        prev_name.clear();
-      } else if (!error_) {
-        error_ = ParseError{ParseError::Kind::Syntax, lineno};
+    bool onValue(std::string_view section, std::string_view name, std::string_view value, int) override {
+      auto [it, inserted] = data_.sections[section].try_emplace(name);
+      Data::Entry& entry = it->second;
+      if (entry.value.text.empty()) {
+        entry.value.text = value;
+        entry.joined = nullptr;
+      } else {
+        data_.append(entry, value);
       }
-    } else {
-      size_t sep = findCharsOrComment(start, "=:");
-      if (sep < start.size() && (start[sep] == '=' || start[sep] == ':')) {
-        std::string name = trimRight(start.substr(0, sep));
-        std::string value = trimLeft(start.substr(sep + 1));
-        size_t vend = findCharsOrComment(value, "");
-        value = trimRight(value.substr(0, vend));
-
-        prev_name = name;
-        std::string& stored = values_[makeKey(section, name)];
-        if (!stored.empty()) stored += "\n";
-        stored += value;
-        sections_.insert(section);
-      } else if (!error_) {
-        error_ = ParseError{ParseError::Kind::Syntax, lineno};
+      prev_ = &entry;
+      // sections() 只包含有键的 section，每个 section 头之后只需插入一次
+      if (!recorded_) {
+        sections_.emplace(section);
+        recorded_ = true;
       }
+      return true;
     }
-  }
+
+    bool onContinuation(std::string_view, std::string_view, std::string_view value, int) override {
+      data_.append(*prev_, value);
+      return true;
+    }
+
+   private:
+    Data& data_;
+    std::set<std::string>& sections_;
+    Data::Entry* prev_ = nullptr;
+    bool recorded_ = false;
+  } builder(*data, sections_);
+
+  error_ = INIParser::parse(data->text, builder);
+
+  data_ = std::move(data);
 }
 
 }  // namespace config
@@ -0,0 +1,247 @@
+#include "pickup/config/LayeredConfig.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+#include "pickup/utils/LexicalCast.hpp"
+
+namespace pickup {
+namespace config {
+
+namespace {
+
+constexpr char asciiLower(char c) noexcept {
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+constexpr char envChar(char c) noexcept {
+  if (c >= 'a' && c <= 'z') return static_cast<char>(c - 'a' + 'A');
+  if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) return c;
+  return '_';
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) noexcept {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (asciiLower(a[i]) != asciiLower(b[i])) return false;
+  }
+  return true;
+}
+
+uint64_t hashIgnoreCase(uint64_t h, std::string_view s) noexcept {
+  for (char c : s) {
+    h ^= static_cast<unsigned char>(asciiLower(c));
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+std::string environmentName(std::string_view prefix, std::string_view section, std::string_view name) {
+  std::string env(prefix);
+  for (char c : section) env.push_back(envChar(c));
+  if (!section.empty()) env.push_back('_');
+  for (char c : name) env.push_back(envChar(c));
+  return env;
+}
+
+}  // namespace
+
+size_t LayeredConfig::KeyHash::operator()(const KeyRef& key) const noexcept {
+  uint64_t h = hashIgnoreCase(14695981039346656037ULL, key.section);
+  h = (h ^ 0x1F) * 1099511628211ULL;  // 分隔 section 与 name，使 ("ab","c") 与 ("a","bc") 不同
+  return static_cast<size_t>(hashIgnoreCase(h, key.name));
+}
+
+bool LayeredConfig::KeyEqual::operator()(const KeyRef& a, const KeyRef& b) const noexcept {
+  return equalsIgnoreCase(a.section, b.section) && equalsIgnoreCase(a.name, b.name);
+}
+
+std::optional<INIReader::ParseError> LayeredConfig::addFile(std::string layer, const std::string& path) {
+  INIReader reader(path);
+  auto error = reader.error();
+  if (error && error->kind == INIReader::ParseError::Kind::FileOpen) return error;
+  addReader(std::move(layer), std::move(reader));
+  return error;
+}
+
+void LayeredConfig::addReader(std::string layer, INIReader reader) {
+  layers_.push_back(Layer{std::move(layer), Layer::Kind::Reader, std::move(reader), {}, {}});
+}
+
+void LayeredConfig::addEnvironment(std::string layer, std::string prefix) {
+  layers_.push_back(Layer{std::move(layer), Layer::Kind::Environment, {}, std::move(prefix), {}});
+}
+
+void LayeredConfig::addOverrides(std::string layer, std::vector<Override> overrides) {
+  layers_.push_back(Layer{std::move(layer), Layer::Kind::Overrides, {}, {}, std::move(overrides)});
+}
+
+void LayeredConfig::addOverrides(std::string layer, const std::vector<std::string>& assignments) {
+  std::vector<Override> overrides;
+  overrides.reserve(assignments.size());
+  for (const auto& assignment : assignments) {
+    const size_t eq = assignment.find('=');
+    if (eq == std::string::npos) continue;
+    const std::string_view key = std::string_view(assignment).substr(0, eq);
+    const size_t dot = key.rfind('.');
+    Override item;
+    if (dot != std::string_view::npos) {
+      item.section = std::string(key.substr(0, dot));
+      item.name = std::string(key.substr(dot + 1));
+    } else {
+      item.name = std::string(key);
+    }
+    item.value = assignment.substr(eq + 1);
+    overrides.push_back(std::move(item));
+  }
+  addOverrides(std::move(layer), std::move(overrides));
+}
+
+bool LayeredConfig::build() {
+  entries_.clear();
+  index_.clear();
+
+  // 重建字符串池：先把已注册键的名称与默认值移入新池，旧池在合并完成后释放
+  std::deque<std::string> previous;
+  previous.swap(pool_);
+  interned_.clear();
+  for (auto& slot : slots_) {
+    slot.section = intern(slot.section);
+    slot.name = intern(slot.name);
+    if (auto* text = std::get_if<std::string_view>(&slot.defaultValue)) *text = intern(*text);
+  }
+
+  for (size_t i = 0; i < layers_.size(); ++i) {
+    const Layer& layer = layers_[i];
+    const int id = static_cast<int>(i);
+    switch (layer.kind) {
+      case Layer::Kind::Reader:
+        layer.reader.forEach([&](std::string_view section, std::string_view name, std::string_view value) {
+          set(section, name, value, id);
+        });
+        break;
+      case Layer::Kind::Overrides:
+        for (const auto& item : layer.overrides) set(item.section, item.name, item.value, id);
+        break;
+      case Layer::Kind::Environment: {
+        // 只考察此前已出现的键与已注册的键；先收集名称，避免边遍历边插入
+        std::vector<KeyRef> keys;
+        keys.reserve(entries_.size() + slots_.size());
+        for (const auto& entry : entries_) keys.push_back({entry.section, entry.name});
+        for (const auto& slot : slots_) keys.push_back({slot.section, slot.name});
+        for (const auto& key : keys) {
+          if (const char* value = std::getenv(environmentName(layer.prefix, key.section, key.name).c_str())) {
+            set(key.section, key.name, value, id);
+          }
+        }
+        break;
+      }
+    }
+  }
+
+  invalid_.clear();
+  bool ok = true;
+  for (auto& slot : slots_) ok = resolve(slot) && ok;
+  return ok;
+}
+
+std::optional<std::string_view> LayeredConfig::find(std::string_view section,
+                                                    std::string_view name) const noexcept {
+  const Entry* entry = findEntry(section, name);
+  if (!entry) return std::nullopt;
+  return entry->value;
+}
+
+std::optional<std::string_view> LayeredConfig::sourceOf(std::string_view section,
+                                                        std::string_view name) const noexcept {
+  const Entry* entry = findEntry(section, name);
+  if (!entry) return std::nullopt;
+  return layerName(entry->layer);
+}
+
+void LayeredConfig::forEach(const Visitor& visitor) const {
+  for (const auto& entry : entries_) {
+    visitor(entry.section, entry.name, entry.value, layers_[static_cast<size_t>(entry.layer)].name);
+  }
+}
+
+std::string_view LayeredConfig::intern(std::string_view s) {
+  auto it = interned_.find(s);
+  if (it != interned_.end()) return *it;
+  const std::string_view stored = pool_.emplace_back(s);
+  interned_.insert(stored);
+  return stored;
+}
+
+void LayeredConfig::set(std::string_view section, std::string_view name, std::string_view value, int layer) {
+  auto it = index_.find(KeyRef{section, name});
+  if (it != index_.end()) {
+    Entry& entry = entries_[it->second];
+    entry.value = intern(value);
+    entry.layer = layer;
+    return;
+  }
+  Entry entry{intern(section), intern(name), intern(value), layer};
+  index_.emplace(KeyRef{entry.section, entry.name}, static_cast<uint32_t>(entries_.size()));
+  entries_.push_back(entry);
+}
+
+auto LayeredConfig::findEntry(std::string_view section, std::string_view name) const noexcept -> const Entry* {
+  auto it = index_.find(KeyRef{section, name});
+  return it != index_.end() ? &entries_[it->second] : nullptr;
+}
+
+bool LayeredConfig::resolve(Slot& slot) {
+  slot.value = slot.defaultValue;
+  slot.layer = kDefaultLayer;
+  const Entry* entry = findEntry(slot.section, slot.name);
+  if (!entry) return true;
+
+  const std::string_view text = entry->value;
+  std::optional<Value> parsed;
+  std::visit(
+      [&](const auto& def) {
+        using S = std::decay_t<decltype(def)>;
+        if constexpr (std::is_same_v<S, bool>) {
+          if (auto v = INIReader::parseBoolean(text)) parsed = *v;
+        } else if constexpr (std::is_same_v<S, int64_t>) {
+          auto v = utils::lexicalCast<int64_t>(text);
+          if (v && *v >= slot.min && *v <= slot.max) parsed = *v;
+        } else if constexpr (std::is_same_v<S, double>) {
+          // float 键：有限值超出 float 范围时转换是未定义行为，按无法转换处理
+          auto v = utils::lexicalCast<double>(text);
+          if (v && (!std::isfinite(*v) || std::fabs(*v) <= slot.realMax)) parsed = *v;
+        } else if constexpr (std::is_same_v<S, std::string_view>) {
+          parsed = text;
+        } else {
+          if (auto v = INIReader::parseDuration(text)) parsed = *v;
+        }
+      },
+      slot.defaultValue);
+
+  if (!parsed) {
+    invalid_.push_back(std::string(slot.section) + "." + std::string(slot.name));
+    return false;
+  }
+  slot.value = *parsed;
+  slot.layer = entry->layer;
+  return true;
+}
+
+size_t LayeredConfig::addSlot(std::string_view section, std::string_view name, Value default_value, int64_t min,
+                              int64_t max, double realMax) {
+  Slot slot{intern(section), intern(name), default_value, default_value, min, max, realMax, kDefaultLayer};
+  // 注册晚于 build() 时立即取值；尚未 build() 时 entries_ 为空，得到默认值
+  resolve(slot);
+  slots_.push_back(slot);
+  return slots_.size() - 1;
+}
+
+std::optional<std::string_view> LayeredConfig::layerName(int layer) const noexcept {
+  if (layer == kDefaultLayer) return std::nullopt;
+  return layers_[static_cast<size_t>(layer)].name;
+}
+
+}  // namespace config
+}  // namespace pickup
@@ -0,0 +1,316 @@
+#include "pickup/timer/CronSchedule.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pickup/time/Time.h"
+
+namespace pickup {
+namespace timer {
+
+namespace {
+
+constexpr int64_t kNanosPerSecond = 1000000000ll;
+
+// 搜索上限：一个完整的格里高利历周期（400 年）内必然覆盖所有 日/月/周 组合
+constexpr int kSearchYears = 400;
+// Timestamp（int64 纳秒）可表示的最大年份
+constexpr int kMaxYear = 2262;
+
+constexpr const char* kMonthNames[] = {"JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+                                       "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+constexpr const char* kWeekdayNames[] = {"SUN", "MON", "TUE", "WED", "THU", "FRI", "SAT"};
+
+int64_t floorDiv(int64_t a, int64_t b) noexcept {
+  int64_t q = a / b;
+  if ((a % b != 0) && ((a < 0) != (b < 0))) --q;
+  return q;
+}
+
+bool isLeapYear(int year) noexcept { return (year % 400 == 0) || ((year % 100 != 0) && (year % 4 == 0)); }
+
+int daysInMonth(int year, int month) noexcept {
+  static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return (month == 2 && isLeapYear(year)) ? 29 : days[month - 1];
+}
+
+// Sakamoto 算法，返回 0–6（0 = 周日）
+int weekdayOf(int year, int month, int day) noexcept {
+  static const int t[] = {0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4};
+  int y = year;
+  if (month < 3) --y;
+  return (y + y / 4 - y / 100 + y / 400 + t[month - 1] + day) % 7;
+}
+
+// mask 中不小于 from 的最低置位下标，不存在返回 -1
+int nextBit(uint64_t mask, int from) noexcept {
+  if (from >= 64) return -1;
+  const uint64_t rest = mask >> from;
+  return rest == 0 ? -1 : from + std::countr_zero(rest);
+}
+
+// 挂钟字段，带进位的逐级前进
+struct Fields {
+  int year;
+  int month;
+  int day;
+  int hour;
+  int minute;
+  int second;
+
+  void nextMonth() noexcept {
+    if (++month > 12) {
+      month = 1;
+      ++year;
+    }
+    day = 1;
+    hour = minute = second = 0;
+  }
+  void nextDay() noexcept {
+    if (++day > daysInMonth(year, month)) {
+      nextMonth();
+      return;
+    }
+    hour = minute = second = 0;
+  }
+  void nextHour() noexcept {
+    if (++hour > 23) {
+      nextDay();
+      return;
+    }
+    minute = second = 0;
+  }
+  void nextMinute() noexcept {
+    if (++minute > 59) {
+      nextHour();
+      return;
+    }
+    second = 0;
+  }
+  void nextSecond() noexcept {
+    if (++second > 59) {
+      nextMinute();
+    }
+  }
+};
+
+Fields fieldsOf(const time::Time& t) noexcept {
+  return {t.year(), t.month(), t.day(), t.hour(), t.minute(), t.second()};
+}
+
+std::string toUpperAscii(std::string_view s) {
+  std::string out(s);
+  std::transform(out.begin(), out.end(), out.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+  return out;
+}
+
+std::vector<std::string_view> splitOn(std::string_view s, char delimiter) {
+  std::vector<std::string_view> parts;
+  size_t start = 0;
+  while (true) {
+    const size_t pos = s.find(delimiter, start);
+    parts.push_back(s.substr(start, pos == std::string_view::npos ? std::string_view::npos : pos - start));
+    if (pos == std::string_view::npos) break;
+    start = pos + 1;
+  }
+  return parts;
+}
+
+// 单个取值：数字或（若提供 names）三字母缩写
+int parseValue(std::string_view token, int min, int max, const char* const* names, int nameCount,
+               const std::string& expression) {
+  if (token.empty()) {
+    throw std::invalid_argument("cron: empty field value in '" + expression + "'");
+  }
+  if (names != nullptr && std::isalpha(static_cast<unsigned char>(token[0]))) {
+    const std::string upper = toUpperAscii(token);
+    for (int i = 0; i < nameCount; ++i) {
+      if (upper == names[i]) {
+        // 月份名从 1 起，星期名从 0 起
+        return min == 1 ? i + 1 : i;
+      }
+    }
+    throw std::invalid_argument("cron: unknown name '" + std::string(token) + "' in '" + expression + "'");
+  }
+  int value = 0;
+  for (char c : token) {
+    if (!std::isdigit(static_cast<unsigned char>(c)) || value > 1000) {
+      throw std::invalid_argument("cron: invalid number '" + std::string(token) + "' in '" + expression + "'");
+    }
+    value = value * 10 + (c - '0');
+  }
+  if (value < min || value > max) {
+    throw std::invalid_argument("cron: value " + std::to_string(value) + " out of range in '" + expression + "'");
+  }
+  return value;
+}
+
+// 解析一段（逗号列表），返回位集合；star 输出该段是否为单独的 "*"
+uint64_t parseField(std::string_view field, int min, int max, const char* const* names, int nameCount,
+                    const std::string& expression, bool* star = nullptr) {
+  if (star != nullptr) {
+    *star = (field == "*" || field == "?");
+  }
+  uint64_t mask = 0;
+  for (std::string_view item : splitOn(field, ',')) {
+    int step = 1;
+    const size_t slash = item.find('/');
+    std::string_view range = item;
+    if (slash != std::string_view::npos) {
+      step = parseValue(item.substr(slash + 1), 1, max, nullptr, 0, expression);
+      range = item.substr(0, slash);
+    }
+
+    int lo = min;
+    int hi = max;
+    if (range != "*" && range != "?") {
+      const size_t dash = range.find('-');
+      if (dash != std::string_view::npos) {
+        lo = parseValue(range.substr(0, dash), min, max, names, nameCount, expression);
+        hi = parseValue(range.substr(dash + 1), min, max, names, nameCount, expression);
+        if (lo > hi) {
+          throw std::invalid_argument("cron: descending range in '" + expression + "'");
+        }
+      } else {
+        lo = parseValue(range, min, max, names, nameCount, expression);
+        // "a/s" 表示从 a 起每 s 个；单独的 "a" 只取 a
+        hi = (slash != std::string_view::npos) ? max : lo;
+      }
+    }
+    for (int v = lo; v <= hi; v += step) {
+      mask |= uint64_t{1} << v;
+    }
+  }
+  return mask;
+}
+
+std::string expandMacro(const std::string& expression) {
+  const std::string upper = toUpperAscii(expression);
+  if (upper == "@YEARLY" || upper == "@ANNUALLY") return "0 0 1 1 *";
+  if (upper == "@MONTHLY") return "0 0 1 * *";
+  if (upper == "@WEEKLY") return "0 0 * * 0";
+  if (upper == "@DAILY" || upper == "@MIDNIGHT") return "0 0 * * *";
+  if (upper == "@HOURLY") return "0 * * * *";
+  throw std::invalid_argument("cron: unknown macro '" + expression + "'");
+}
+
+}  // namespace
+
+CronSchedule CronSchedule::parse(const std::string& expression) { return compile(expression, std::nullopt); }
+
+CronSchedule CronSchedule::parse(const std::string& expression, const time::Timezone& timezone) {
+  return compile(expression, timezone.total());
+}
+
+CronSchedule CronSchedule::everyMinute() { return parse("0 * * * * *"); }
+
+CronSchedule CronSchedule::hourly(int minute) { return parse(std::to_string(minute) + " * * * *"); }
+
+CronSchedule CronSchedule::daily(int hour, int minute) {
+  return parse(std::to_string(minute) + " " + std::to_string(hour) + " * * *");
+}
+
+CronSchedule CronSchedule::compile(const std::string& expression, std::optional<time::Timespan> offset) {
+  const std::string expanded = (!expression.empty() && expression[0] == '@') ? expandMacro(expression) : expression;
+
+  std::vector<std::string_view> fields;
+  std::string_view rest(expanded);
+  while (!rest.empty()) {
+    const size_t begin = rest.find_first_not_of(" \t");
+    if (begin == std::string_view::npos) break;
+    rest.remove_prefix(begin);
+    const size_t end = rest.find_first_of(" \t");
+    fields.push_back(rest.substr(0, end));
+    rest.remove_prefix(end == std::string_view::npos ? rest.size() : end);
+  }
+  if (fields.size() != 5 && fields.size() != 6) {
+    throw std::invalid_argument("cron: expected 5 or 6 fields in '" + expression + "'");
+  }
+
+  CronSchedule s;
+  s.expression_ = expression;
+  s.offset_ = offset;
+
+  size_t i = 0;
+  s.seconds_ = (fields.size() == 6) ? parseField(fields[i++], 0, 59, nullptr, 0, expression) : uint64_t{1};
+  s.minutes_ = parseField(fields[i++], 0, 59, nullptr, 0, expression);
+  s.hours_ = static_cast<uint32_t>(parseField(fields[i++], 0, 23, nullptr, 0, expression));
+  s.days_ = static_cast<uint32_t>(parseField(fields[i++], 1, 31, nullptr, 0, expression, &s.anyDay_));
+  s.months_ = static_cast<uint16_t>(parseField(fields[i++], 1, 12, kMonthNames, 12, expression));
+  uint64_t weekdays = parseField(fields[i++], 0, 7, kWeekdayNames, 7, expression, &s.anyWeekday_);
+  if (weekdays & (uint64_t{1} << 7)) {
+    weekdays = (weekdays | 1u) & 0x7Fu;  // 7 与 0 均表示周日
+  }
+  s.weekdays_ = static_cast<uint8_t>(weekdays);
+  return s;
+}
+
+bool CronSchedule::matchesDay(int year, int month, int day) const noexcept {
+  const bool dayHit = (days_ >> day) & 1u;
+  const bool weekdayHit = (weekdays_ >> weekdayOf(year, month, day)) & 1u;
+  if (anyDay_) return weekdayHit;
+  if (anyWeekday_) return dayHit;
+  return dayHit || weekdayHit;
+}
+
+std::optional<time::UtcTimestamp> CronSchedule::next(const time::Timestamp& after) const {
+  // 从严格晚于 after 的下一个整秒开始，以目标时区的挂钟字段逐级匹配
+  const int64_t startSecond = floorDiv(after.total(), kNanosPerSecond) + 1;
+  const time::Timestamp start(startSecond * kNanosPerSecond);
+  Fields f = offset_ ? fieldsOf(time::UtcTime(start + *offset_)) : fieldsOf(time::LocalTime(start));
+
+  const int yearLimit = std::min(f.year + kSearchYears, kMaxYear);
+  while (f.year <= yearLimit) {
+    if (!((months_ >> f.month) & 1u)) {
+      f.nextMonth();
+      continue;
+    }
+    if (!matchesDay(f.year, f.month, f.day)) {
+      f.nextDay();
+      continue;
+    }
+    const int hour = nextBit(hours_, f.hour);
+    if (hour < 0) {
+      f.nextDay();
+      continue;
+    }
+    if (hour != f.hour) {
+      f.hour = hour;
+      f.minute = f.second = 0;
+    }
+    const int minute = nextBit(minutes_, f.minute);
+    if (minute < 0) {
+      f.nextHour();
+      continue;
+    }
+    if (minute != f.minute) {
+      f.minute = minute;
+      f.second = 0;
+    }
+    const int second = nextBit(seconds_, f.second);
+    if (second < 0) {
+      f.nextMinute();
+      continue;
+    }
+    f.second = second;
+
+    const time::Time wall(f.year, f.month, f.day, f.hour, f.minute, f.second);
+    const time::Timestamp candidate = offset_ ? time::Timestamp(wall.utcstamp() - *offset_)
+                                              : time::Timestamp(wall.localstamp());
+    // 夏令时回拨时同一挂钟时刻会出现两次，换算结果可能不晚于 after，跳过继续找
+    if (candidate > after) {
+      return time::UtcTimestamp(candidate);
+    }
+    f.nextSecond();
+  }
+  return std::nullopt;
+}
+
+}  // namespace timer
+}  // namespace pickup
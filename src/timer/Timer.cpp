@@ -1,16 +1,64 @@
 #include "pickup/timer/Timer.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <exception>
 #include <stdexcept>
 #include <thread>
 
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
 namespace pickup {
 namespace timer {
 
+namespace {
+
+// 挂钟与单调时钟偏差的变化超过该值才重新对齐日历任务（吸收两次读时钟的抖动与 NTP 微调）
+constexpr std::chrono::milliseconds kCalendarResyncTolerance{1};
+
+std::chrono::nanoseconds wallMinusSteady(std::chrono::system_clock::time_point wall,
+                                         std::chrono::steady_clock::time_point steady) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(wall.time_since_epoch()) -
+         std::chrono::duration_cast<std::chrono::nanoseconds>(steady.time_since_epoch());
+}
+
+// 自旋等待时提示 CPU 降低功耗、让出超线程资源
+inline void cpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+}  // namespace
+
 TimerTask::~TimerTask() = default;
 
-Timer::Timer() : wakeUpTime_(std::chrono::steady_clock::time_point{}), worker_(&Timer::runLoop, this) {}
+Timer::Timer() : Timer(TimerOptions{}) {}
+
+Timer::Timer(const TimerOptions& options)
+    : wakeUpTime_(std::chrono::steady_clock::time_point{}), options_(options) {
+#if defined(__linux__)
+  // 创建失败时退回条件变量休眠，自旋段不受影响
+  if (options_.highResolution) {
+    timerFd_ = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    wakeFd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (timerFd_ < 0 || wakeFd_ < 0) {
+      if (timerFd_ >= 0) ::close(timerFd_);
+      if (wakeFd_ >= 0) ::close(wakeFd_);
+      timerFd_ = wakeFd_ = -1;
+    }
+  }
+#endif
+  worker_ = std::thread(&Timer::runLoop, this);
+}
 
 Timer::~Timer() {
   if (worker_.joinable()) {
@@ -20,6 +68,10 @@ Timer::~Timer() {
       // 析构函数不能抛异常
     }
   }
+#if defined(__linux__)
+  if (timerFd_ >= 0) ::close(timerFd_);
+  if (wakeFd_ >= 0) ::close(wakeFd_);
+#endif
 }
 
 void Timer::stop() {
@@ -34,7 +86,8 @@ void Timer::stop() {
     destroyed_ = true;
     tasks_.clear();
     tokens_.clear();
-    condition_.notify_one();
+    calendars_.clear();
+    notifyWorker();
   }
   worker_.join();
 }
@@ -52,6 +105,28 @@ bool Timer::isScheduled(const TimerTaskPtr& task) const {
   return tasks_.find(task) != tasks_.end();
 }
 
+TimerStats Timer::stats() const {
+  TimerStats s;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    s.pending = tokens_.size();
+  }
+  s.fired = fired_.load(std::memory_order_relaxed);
+  s.exceptions = exceptions_.load(std::memory_order_relaxed);
+  s.fixedRateOverruns = fixedRateOverruns_.load(std::memory_order_relaxed);
+  s.lag = lag_.snapshot();
+  s.execution = execution_.snapshot();
+  return s;
+}
+
+void Timer::resetStats() noexcept {
+  fired_.store(0, std::memory_order_relaxed);
+  exceptions_.store(0, std::memory_order_relaxed);
+  fixedRateOverruns_.store(0, std::memory_order_relaxed);
+  lag_.reset();
+  execution_.reset();
+}
+
 void Timer::addTask(const TimerTaskPtr& task, std::chrono::nanoseconds delay,
                     std::optional<std::chrono::nanoseconds> repeat, bool reschedule,
                     bool fixedRate) {
@@ -88,8 +163,125 @@ void Timer::addTask(const TimerTaskPtr& task, std::chrono::nanoseconds delay,
 
   // 仅当新任务比当前等待目标更早（或工作线程正空等）时才唤醒，避免无谓唤醒
   if (wakeUpTime_ == std::chrono::steady_clock::time_point{} || time < wakeUpTime_) {
-    condition_.notify_one();
+    notifyWorker();
+  }
+}
+
+void Timer::scheduleAt(const TimerTaskPtr& task, const CronSchedule& schedule) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (destroyed_) {
+    throw std::invalid_argument("timer destroyed");
+  }
+  if (tasks_.count(task) > 0) {
+    throw std::invalid_argument("task is already scheduled");
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  const auto wallNow = std::chrono::system_clock::now();
+  const auto next = schedule.next(time::Timestamp(wallNow));
+  if (!next) {
+    throw std::invalid_argument("calendar schedule has no future fire time");
+  }
+  const auto wallTime = next->chrono();
+  const auto time = now + std::max(std::chrono::steady_clock::duration::zero(),
+                                   std::chrono::duration_cast<std::chrono::steady_clock::duration>(wallTime - wallNow));
+
+  if (calendars_.empty()) {
+    wallOffset_ = wallMinusSteady(wallNow, now);
+  }
+  auto [it, inserted] = tasks_.insert({task, time});
+  try {
+    calendars_.insert({task, CalendarEntry{schedule, wallTime}});
+    tokens_.insert({time, std::nullopt, task, false, true});
+  } catch (...) {
+    calendars_.erase(task);
+    tasks_.erase(it);
+    throw;
+  }
+
+  if (wakeUpTime_ == std::chrono::steady_clock::time_point{} || time < wakeUpTime_) {
+    notifyWorker();
+  }
+}
+
+void Timer::resyncCalendarNoSync(std::chrono::steady_clock::time_point now) {
+  const auto wallNow = std::chrono::system_clock::now();
+  const auto offset = wallMinusSteady(wallNow, now);
+  const auto drift = offset - wallOffset_;
+  if (drift < kCalendarResyncTolerance && -drift < kCalendarResyncTolerance) {
+    return;
+  }
+  wallOffset_ = offset;
+
+  for (const auto& [task, entry] : calendars_) {
+    auto p = tasks_.find(task);
+    if (p == tasks_.end()) {
+      continue;
+    }
+    auto it = tokens_.find(Token{p->second, std::nullopt, task});
+    if (it == tokens_.end()) {
+      continue;  // 正在执行，执行完续排时自然按挂钟重算
+    }
+    Token token = *it;
+    tokens_.erase(it);
+    token.scheduledTime =
+        now + std::max(std::chrono::steady_clock::duration::zero(),
+                       std::chrono::duration_cast<std::chrono::steady_clock::duration>(entry.wallTime - wallNow));
+    p->second = token.scheduledTime;
+    tokens_.insert(token);
+  }
+}
+
+void Timer::notifyWorker() {
+  condition_.notify_one();
+#if defined(__linux__)
+  if (wakeFd_ >= 0) {
+    const uint64_t one = 1;
+    [[maybe_unused]] const auto n = ::write(wakeFd_, &one, sizeof(one));
   }
+#endif
+}
+
+void Timer::waitPrecise(std::unique_lock<std::mutex>& lock, std::chrono::steady_clock::time_point deadline) {
+  const auto spinStart = deadline - options_.spinWindow;
+  if (std::chrono::steady_clock::now() < spinStart) {
+#if defined(__linux__)
+    if (timerFd_ >= 0) {
+      const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(spinStart.time_since_epoch()).count();
+      itimerspec spec{};
+      spec.it_value.tv_sec = static_cast<time_t>(ns / 1000000000);
+      spec.it_value.tv_nsec = static_cast<long>(ns % 1000000000);
+      ::timerfd_settime(timerFd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+
+      // 锁外休眠；期间的 notifyWorker() 写入 eventfd，计数不会丢失
+      lock.unlock();
+      pollfd fds[2] = {{timerFd_, POLLIN, 0}, {wakeFd_, POLLIN, 0}};
+      ::poll(fds, 2, -1);
+      uint64_t count = 0;
+      if (fds[1].revents & POLLIN) {
+        [[maybe_unused]] const auto n = ::read(wakeFd_, &count, sizeof(count));
+      }
+      if (fds[0].revents & POLLIN) {
+        [[maybe_unused]] const auto n = ::read(timerFd_, &count, sizeof(count));
+      }
+      lock.lock();
+    } else
+#endif
+    {
+      condition_.wait_until(lock, spinStart);
+    }
+    // 被提前唤醒（新任务、取消、stop）或伪唤醒：交回调用方重新评估
+    if (destroyed_ || std::chrono::steady_clock::now() < spinStart) {
+      return;
+    }
+  }
+
+  // 自旋段不持锁，期间新增的更早任务最多被推迟 spinWindow
+  lock.unlock();
+  while (std::chrono::steady_clock::now() < deadline) {
+    cpuRelax();
+  }
+  lock.lock();
 }
 
 void Timer::executeTask(const TimerTaskPtr& task) { task->run(); }
@@ -99,6 +291,7 @@ void Timer::onException(const TimerTaskPtr& /*task*/, std::exception_ptr /*error
 
 void Timer::runLoop() {
   Token token{std::chrono::steady_clock::time_point{}, std::nullopt, nullptr};
+  std::chrono::steady_clock::time_point firedAt;
   while (true) {
     {
       std::unique_lock<std::mutex> lock(mutex_);
@@ -108,14 +301,38 @@ void Timer::runLoop() {
         // 的 cancel/reschedule 改动该任务，故仅当 map 中的排期仍是本次执行所依据的
         // 那一次（p->second 未变）时才自动续排；否则以并发改动为准，避免残留重复
         // token、破坏重排语义。
-        if (token.delay) {
+        if (token.calendar) {
+          auto p = tasks_.find(token.task);
+          auto c = calendars_.find(token.task);
+          if (p != tasks_.end() && p->second == token.scheduledTime && c != calendars_.end()) {
+            // 以挂钟重新求下次触发；取 max 防止挂钟回拨导致同一时刻重复触发
+            const auto now = std::chrono::steady_clock::now();
+            const auto wallNow = std::chrono::system_clock::now();
+            const auto next = c->second.schedule.next(time::Timestamp(std::max(wallNow, c->second.wallTime)));
+            if (next) {
+              c->second.wallTime = next->chrono();
+              token.scheduledTime =
+                  now + std::max(std::chrono::steady_clock::duration::zero(),
+                                 std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                     c->second.wallTime - wallNow));
+              p->second = token.scheduledTime;
+              tokens_.insert(token);
+            } else {
+              calendars_.erase(c);
+              tasks_.erase(p);
+            }
+          }
+        } else if (token.delay) {
           auto p = tasks_.find(token.task);
           if (p != tasks_.end() && p->second == token.scheduledTime) {
             // fixed-rate 以上次计划时刻为基准（不受执行耗时影响，落后时靠后续补触发
             // 追赶）；fixed-delay 以完成时刻为基准。
-            token.scheduledTime = token.fixedRate
-                                      ? token.scheduledTime + token.delay.value()
-                                      : std::chrono::steady_clock::now() + token.delay.value();
+            const auto now = std::chrono::steady_clock::now();
+            token.scheduledTime = token.fixedRate ? token.scheduledTime + token.delay.value()
+                                                  : now + token.delay.value();
+            if (token.fixedRate && token.scheduledTime <= now) {
+              fixedRateOverruns_.fetch_add(1, std::memory_order_relaxed);
+            }
             p->second = token.scheduledTime;
             tokens_.insert(token);
           }
@@ -134,18 +351,29 @@ void Timer::runLoop() {
 
       while (!tokens_.empty() && !destroyed_) {
         const auto now = std::chrono::steady_clock::now();
+        if (!calendars_.empty()) {
+          resyncCalendarNoSync(now);
+        }
         const Token& first = *(tokens_.begin());
         if (first.scheduledTime <= now) {
+          firedAt = now;
           token = first;
           tokens_.erase(tokens_.begin());
-          if (!token.delay) {
+          if (!token.delay && !token.calendar) {
             tasks_.erase(token.task);
           }
           break;
         }
 
         wakeUpTime_ = first.scheduledTime;
-        condition_.wait_until(lock, first.scheduledTime);
+        // 有日历任务时分段等待，以便及时察觉挂起恢复等导致的挂钟跳变
+        const auto deadline =
+            calendars_.empty() ? first.scheduledTime : std::min(first.scheduledTime, now + kCalendarResyncInterval);
+        if (options_.highResolution && deadline == first.scheduledTime) {
+          waitPrecise(lock, deadline);
+        } else {
+          condition_.wait_until(lock, deadline);
+        }
       }
 
       if (destroyed_) {
@@ -154,14 +382,19 @@ void Timer::runLoop() {
     }
 
     if (token.task) {
+      lag_.record(firedAt - token.scheduledTime);
+
       // 异常在锁外交给可覆盖的钩子处理，避免单个任务失败中断定时线程
       try {
         executeTask(token.task);
       } catch (...) {
+        exceptions_.fetch_add(1, std::memory_order_relaxed);
         onException(token.task, std::current_exception());
       }
+      execution_.record(std::chrono::steady_clock::now() - firedAt);
+      fired_.fetch_add(1, std::memory_order_relaxed);
 
-      if (!token.delay) {
+      if (!token.delay && !token.calendar) {
         // 对于一次性任务，清除 task 引用以避免死锁（task 的析构可能触发用户代码）
         token.task = nullptr;
       }
@@ -181,6 +414,7 @@ bool Timer::cancelNoSync(const TimerTaskPtr& task) noexcept {
 
   tokens_.erase(Token{p->second, std::nullopt, p->first});
   tasks_.erase(p);
+  calendars_.erase(task);
 
   return true;
 }
@@ -0,0 +1,84 @@
+#include "pickup/timer/TimerStats.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace pickup {
+namespace timer {
+
+std::chrono::nanoseconds LatencyHistogram::mean() const noexcept {
+  if (count == 0) {
+    return std::chrono::nanoseconds::zero();
+  }
+  return total / static_cast<int64_t>(count);
+}
+
+std::chrono::nanoseconds LatencyHistogram::percentile(double p) const noexcept {
+  if (count == 0) {
+    return std::chrono::nanoseconds::zero();
+  }
+  p = std::clamp(p, 0.0, 1.0);
+  // 第 rank 个样本（1 起）所在的桶
+  const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p * static_cast<double>(count))));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      // 桶 i 的上界为 2^i - 1；最高桶可能溢出 int64，以 max 封顶
+      if (i >= 63) {
+        return max;
+      }
+      const auto upper = std::chrono::nanoseconds((int64_t{1} << i) - 1);
+      return std::min(upper, max);
+    }
+  }
+  return max;
+}
+
+size_t LatencyHistogram::bucketOf(std::chrono::nanoseconds value) noexcept {
+  if (value.count() <= 0) {
+    return 0;
+  }
+  const auto width = static_cast<size_t>(std::bit_width(static_cast<uint64_t>(value.count())));
+  return std::min(width, kBucketCount - 1);
+}
+
+namespace detail {
+
+void HistogramRecorder::record(std::chrono::nanoseconds value) noexcept {
+  // 负值（如时钟回拨）按 0 计
+  const int64_t ns = std::max<int64_t>(value.count(), 0);
+  buckets_[LatencyHistogram::bucketOf(std::chrono::nanoseconds(ns))].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  total_.fetch_add(ns, std::memory_order_relaxed);
+  // reset() 可能在其他线程并发清零：CAS 只在 ns 确实大于当前值时写入，不会用过期的比较结果覆盖清零
+  int64_t seen = max_.load(std::memory_order_relaxed);
+  while (ns > seen && !max_.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+  }
+}
+
+LatencyHistogram HistogramRecorder::snapshot() const noexcept {
+  LatencyHistogram h;
+  for (size_t i = 0; i < LatencyHistogram::kBucketCount; ++i) {
+    h.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+  }
+  h.count = count_.load(std::memory_order_relaxed);
+  h.total = std::chrono::nanoseconds(total_.load(std::memory_order_relaxed));
+  h.max = std::chrono::nanoseconds(max_.load(std::memory_order_relaxed));
+  return h;
+}
+
+void HistogramRecorder::reset() noexcept {
+  for (auto& b : buckets_) {
+    b.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  total_.store(0, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace detail
+
+}  // namespace timer
+}  // namespace pickup
@@ -0,0 +1,95 @@
+#include "pickup/utils/ByteSet.h"
+
+#if PICKUP_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace pickup {
+namespace utils {
+namespace detail {
+
+#if PICKUP_X86_SIMD
+
+// SSSE3/AVX2 版本要求 len ≥ 16：不足一个向量的结尾改为与已检查部分重叠地读取最后一个
+// 向量，重叠的字节都已确认不命中，命中位置不受影响，省去逐字节的结尾循环
+
+PICKUP_TARGET("ssse3") size_t scanByteSetSSSE3(const char* s, size_t len, const ByteSet& set, bool member) noexcept {
+  const __m128i rows = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.rows.data()));
+  // 高 4 位 ≥ 8（非 ASCII）对应位掩码为 0，恒判为不属于集合
+  const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  const unsigned flip = member ? 0xFFFFu : 0u;
+  for (size_t i = 0;; i += 16) {
+    if (i + 16 > len) i = len - 16;
+    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+    const __m128i row = _mm_shuffle_epi8(rows, _mm_and_si128(c, mask));
+    const __m128i bit = _mm_shuffle_epi8(bits, _mm_and_si128(_mm_srli_epi16(c, 4), mask));
+    const auto outside =
+        static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(row, bit), _mm_setzero_si128())));
+    const unsigned hit = outside ^ flip;
+    if (hit != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(hit));
+    }
+    if (i + 16 == len) return len;
+  }
+}
+
+PICKUP_TARGET("sse4.2") size_t scanByteSetSSE42(const char* s, size_t len, const ByteSet& set, bool member) noexcept {
+  constexpr int kAny = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY;
+  const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.chars.data()));
+  const int count = static_cast<int>(set.count);
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+    const int idx = member ? _mm_cmpestri(chars, count, c, 16, kAny)
+                           : _mm_cmpestri(chars, count, c, 16, kAny | _SIDD_NEGATIVE_POLARITY);
+    if (idx < 16) {
+      return i + static_cast<size_t>(idx);
+    }
+  }
+  return i + scanByteSetScalar(s + i, len - i, set, member);
+}
+
+PICKUP_TARGET("avx2") size_t scanByteSetAVX2(const char* s, size_t len, const ByteSet& set, bool member) noexcept {
+  const __m256i rows = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(set.rows.data())));
+  const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,  //
+                                        1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i mask = _mm256_set1_epi8(0x0F);
+  if (len >= 32) {
+    const unsigned flip = member ? ~0u : 0u;
+    for (size_t i = 0;; i += 32) {
+      if (i + 32 > len) i = len - 32;
+      const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+      const __m256i row = _mm256_shuffle_epi8(rows, _mm256_and_si256(c, mask));
+      const __m256i bit = _mm256_shuffle_epi8(bits, _mm256_and_si256(_mm256_srli_epi16(c, 4), mask));
+      const auto outside = static_cast<unsigned>(
+          _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(row, bit), _mm256_setzero_si256())));
+      const unsigned hit = outside ^ flip;
+      if (hit != 0) {
+        return i + static_cast<size_t>(__builtin_ctz(hit));
+      }
+      if (i + 32 == len) return len;
+    }
+  }
+  // 16~31 字节：读开头与结尾两个 16 字节块；不调用 scanByteSetSSSE3，避免 AVX 与传统 SSE 编码混用的切换代价
+  const unsigned flip = member ? 0xFFFFu : 0u;
+  const __m128i m = _mm256_castsi256_si128(mask);
+  for (size_t i = 0;; i = len - 16) {
+    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+    const __m128i row = _mm_shuffle_epi8(_mm256_castsi256_si128(rows), _mm_and_si128(c, m));
+    const __m128i bit = _mm_shuffle_epi8(_mm256_castsi256_si128(bits), _mm_and_si128(_mm_srli_epi16(c, 4), m));
+    const auto outside =
+        static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(row, bit), _mm_setzero_si128())));
+    const unsigned hit = outside ^ flip;
+    if (hit != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(hit));
+    }
+    if (i + 16 == len) return len;
+  }
+}
+
+#endif  // PICKUP_X86_SIMD
+
+}  // namespace detail
+}  // namespace utils
+}  // namespace pickup
@@ -0,0 +1,75 @@
+#include "pickup/utils/CpuFeatures.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace pickup {
+namespace utils {
+
+namespace {
+
+SimdLevel detect() noexcept {
+#if PICKUP_X86_SIMD
+  // __builtin_cpu_supports 已同时检查操作系统是否保存了对应的寄存器状态（XCR0）
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512vbmi") && __builtin_cpu_supports("avx512bw")) {
+    return SimdLevel::AVX512VBMI;
+  }
+  if (__builtin_cpu_supports("avx512bw")) {
+    return SimdLevel::AVX512BW;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return SimdLevel::SSE42;
+  }
+  if (__builtin_cpu_supports("ssse3")) {
+    return SimdLevel::SSSE3;
+  }
+#endif
+  return SimdLevel::None;
+}
+
+std::atomic<int> gLimit{static_cast<int>(SimdLevel::AVX512VBMI)};
+
+}  // namespace
+
+SimdLevel detectedSimdLevel() noexcept {
+  static const SimdLevel level = detect();
+  return level;
+}
+
+SimdLevel simdLevel() noexcept {
+  const int limit = gLimit.load(std::memory_order_relaxed);
+  return static_cast<SimdLevel>(std::min(static_cast<int>(detectedSimdLevel()), limit));
+}
+
+void setSimdLevelLimit(SimdLevel limit) noexcept {
+  gLimit.store(static_cast<int>(limit), std::memory_order_relaxed);
+}
+
+SimdLevel simdLevelLimit() noexcept {
+  return static_cast<SimdLevel>(gLimit.load(std::memory_order_relaxed));
+}
+
+const char* toString(SimdLevel level) noexcept {
+  switch (level) {
+    case SimdLevel::SSSE3:
+      return "ssse3";
+    case SimdLevel::SSE42:
+      return "sse4.2";
+    case SimdLevel::AVX2:
+      return "avx2";
+    case SimdLevel::AVX512BW:
+      return "avx512bw";
+    case SimdLevel::AVX512VBMI:
+      return "avx512vbmi";
+    case SimdLevel::None:
+    default:
+      return "scalar";
+  }
+}
+
+}  // namespace utils
+}  // namespace pickup
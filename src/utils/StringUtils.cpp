@@ -1,47 +1,194 @@
 #include "pickup/utils/StringUtils.h"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "pickup/utils/ByteSet.h"
+#include "pickup/utils/CpuFeatures.h"
+
+#if PICKUP_X86_SIMD
+#include <immintrin.h>
+#endif
 
 namespace pickup {
 namespace utils {
 
-std::string toUpper(const std::string& str) {
-  std::string result = str;
-  std::transform(result.begin(), result.end(), result.begin(),
-                 [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+namespace {
+
+constexpr size_t npos = std::string::npos;
+
+using detail::ByteSet;
+using detail::makeByteSet;
+using detail::scanByteSet;
+
+constexpr ByteSet kBlankSet = makeByteSet(" \t\n\r\f\v");
+
+// 返回第一个属于集合的字节下标，没有则返回 len；单字符集合直接用 memchr
+size_t findFirstOf(const char* s, size_t len, const ByteSet& set) {
+  if (set.count == 1) {
+    const void* hit = std::memchr(s, set.chars[0], len);
+    return hit ? static_cast<size_t>(static_cast<const char*>(hit) - s) : len;
+  }
+  return scanByteSet(s, len, set, true);
+}
+
+// 供 SplitView 使用：片段通常很短，先用成员表逐字节检查开头一段，
+// 找不到时才构建完整的 ByteSet 交给 SIMD 内核
+size_t findFirstOfShort(const char* s, size_t len, const std::array<uint64_t, 4>& bits, std::string_view chars) {
+  const size_t head = std::min<size_t>(len, 16);
+  for (size_t i = 0; i < head; ++i) {
+    const auto c = static_cast<unsigned char>(s[i]);
+    if ((bits[c >> 6] >> (c & 63)) & 1) return i;
+  }
+  if (head == len) return len;
+  return head + findFirstOf(s + head, len - head, makeByteSet(chars));
+}
+
+// 结尾的空白通常很短，逆向扫描直接查表
+size_t lastNotOf(const char* s, size_t len, const ByteSet& set) {
+  while (len > 0 && set.has(static_cast<unsigned char>(s[len - 1]))) {
+    --len;
+  }
+  return len;
+}
+
+// ---------------------------------------------------------------------------
+// 子串查找：返回 p（长度 m ≥ 2）在 s 中首次出现的下标，没有则返回 npos。
+// SIMD 版本同时比较候选位置的首字节与末字节，只对两者都相等的位置调用 memcmp，
+// 对日志等自然文本几乎不产生误报。
+// ---------------------------------------------------------------------------
+
+size_t findScalar(const char* s, size_t n, const char* p, size_t m) {
+  if (m > n) return npos;
+  const char* cur = s;
+  const char* const last = s + (n - m);  // 最后一个可能的起点
+  while (cur <= last) {
+    cur = static_cast<const char*>(std::memchr(cur, p[0], static_cast<size_t>(last - cur) + 1));
+    if (!cur) return npos;
+    if (std::memcmp(cur + 1, p + 1, m - 1) == 0) return static_cast<size_t>(cur - s);
+    ++cur;
+  }
+  return npos;
+}
+
+#if PICKUP_X86_SIMD
+
+// 只用到 SSE2，按 SSSE3 级别启用
+PICKUP_TARGET("sse2") size_t findSSE2(const char* s, size_t n, const char* p, size_t m) {
+  const __m128i first = _mm_set1_epi8(p[0]);
+  const __m128i last = _mm_set1_epi8(p[m - 1]);
+  size_t i = 0;
+  for (; i + m - 1 + 16 <= n; i += 16) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m - 1));
+    auto hit = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+    while (hit != 0) {
+      const size_t pos = i + static_cast<size_t>(__builtin_ctz(hit));
+      if (std::memcmp(s + pos + 1, p + 1, m - 2) == 0) return pos;
+      hit &= hit - 1;
+    }
+  }
+  const size_t tail = findScalar(s + i, n - i, p, m);
+  return tail == npos ? npos : i + tail;
+}
+
+PICKUP_TARGET("avx2") size_t findAVX2(const char* s, size_t n, const char* p, size_t m) {
+  const __m256i first = _mm256_set1_epi8(p[0]);
+  const __m256i last = _mm256_set1_epi8(p[m - 1]);
+  size_t i = 0;
+  for (; i + m - 1 + 32 <= n; i += 32) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + m - 1));
+    auto hit = static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last))));
+    while (hit != 0) {
+      const size_t pos = i + static_cast<size_t>(__builtin_ctz(hit));
+      if (std::memcmp(s + pos + 1, p + 1, m - 2) == 0) return pos;
+      hit &= hit - 1;
+    }
+  }
+  const size_t tail = findScalar(s + i, n - i, p, m);
+  return tail == npos ? npos : i + tail;
+}
+
+#endif  // PICKUP_X86_SIMD
+
+size_t findSubstring(std::string_view s, std::string_view p, size_t from = 0) {
+  if (from > s.size()) return npos;
+  const char* base = s.data() + from;
+  const size_t n = s.size() - from;
+  const size_t m = p.size();
+  if (m == 0) return from;
+  if (m > n) return npos;
+  if (m == 1) {
+    const void* hit = std::memchr(base, p[0], n);
+    return hit ? from + static_cast<size_t>(static_cast<const char*>(hit) - base) : npos;
+  }
+  size_t pos;
+#if PICKUP_X86_SIMD
+  const SimdLevel level = simdLevel();
+  if (level >= SimdLevel::AVX2) {
+    pos = findAVX2(base, n, p.data(), m);
+  } else if (level >= SimdLevel::SSSE3) {
+    pos = findSSE2(base, n, p.data(), m);
+  } else {
+    pos = findScalar(base, n, p.data(), m);
+  }
+#else
+  pos = findScalar(base, n, p.data(), m);
+#endif
+  return pos == npos ? npos : from + pos;
+}
+
+}  // namespace
+
+std::string toUpper(std::string_view str) {
+  std::string result(str);
+  toUpperInPlace(result);
   return result;
 }
 
-std::string toLower(const std::string& str) {
-  std::string result = str;
-  std::transform(result.begin(), result.end(), result.begin(),
-                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+std::string toLower(std::string_view str) {
+  std::string result(str);
+  toLowerInPlace(result);
   return result;
 }
 
-bool isBlank(const std::string& str) {
-  return str.find_first_not_of(" \t\n\r\f\v") == std::string::npos;
+void toUpperInPlace(std::string& str) {
+  std::transform(str.begin(), str.end(), str.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+}
+
+void toLowerInPlace(std::string& str) {
+  std::transform(str.begin(), str.end(), str.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
 }
 
-bool contains(const std::string& str, const std::string& pattern) {
-  return str.find(pattern) != std::string::npos;
+bool isBlank(std::string_view str) {
+  return scanByteSet(str.data(), str.size(), kBlankSet, false) == str.size();
 }
 
-bool startsWith(const std::string& str, char ch) {
+bool contains(std::string_view str, std::string_view pattern) {
+  return findSubstring(str, pattern) != npos;
+}
+
+bool startsWith(std::string_view str, char ch) {
   return !str.empty() && str.front() == ch;
 }
 
-bool startsWith(const std::string& str, const std::string& prefix) {
-  return str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0;
+bool startsWith(std::string_view str, std::string_view prefix) {
+  return str.starts_with(prefix);
 }
 
-bool endsWith(const std::string& str, char ch) {
+bool endsWith(std::string_view str, char ch) {
   return !str.empty() && str.back() == ch;
 }
 
-bool endsWith(const std::string& str, const std::string& suffix) {
-  return str.size() >= suffix.size() &&
-         str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+bool endsWith(std::string_view str, std::string_view suffix) {
+  return str.ends_with(suffix);
 }
 
 bool compareNoCase(char c1, char c2) {
@@ -49,7 +196,7 @@ bool compareNoCase(char c1, char c2) {
          std::tolower(static_cast<unsigned char>(c2));
 }
 
-bool compareNoCase(const std::string& str1, const std::string& str2) {
+bool compareNoCase(std::string_view str1, std::string_view str2) {
   if (str1.length() != str2.length()) return false;
   return std::equal(str1.begin(), str1.end(), str2.begin(), [](char c1, char c2) {
     return std::tolower(static_cast<unsigned char>(c1)) ==
@@ -70,112 +217,208 @@ void trim(std::string& str, char c) {
   trimLeft(str, c);
 }
 
-void trimLeft(std::string& str, const std::string& chars) {
-  str.erase(0, str.find_first_not_of(chars));
+void trimLeft(std::string& str, std::string_view chars) {
+  const ByteSet set = makeByteSet(chars);
+  str.erase(0, scanByteSet(str.data(), str.size(), set, false));
 }
 
-void trimRight(std::string& str, const std::string& chars) {
-  const auto pos = str.find_last_not_of(chars);
-  if (pos == std::string::npos) {
-    str.clear();
-  } else {
-    str.erase(pos + 1);
-  }
+void trimRight(std::string& str, std::string_view chars) {
+  const ByteSet set = makeByteSet(chars);
+  str.erase(lastNotOf(str.data(), str.size(), set));
 }
 
-void trim(std::string& str, const std::string& chars) {
-  trimRight(str, chars);
-  trimLeft(str, chars);
+void trim(std::string& str, std::string_view chars) {
+  const ByteSet set = makeByteSet(chars);
+  str.erase(lastNotOf(str.data(), str.size(), set));
+  str.erase(0, scanByteSet(str.data(), str.size(), set, false));
 }
 
-std::string replaceAll(const std::string& str, const std::string& from, const std::string& to) {
-  if (from.empty()) return str;
-  std::string result = str;
-  size_t pos = 0;
-  while ((pos = result.find(from, pos)) != std::string::npos) {
-    result.replace(pos, from.length(), to);
-    pos += to.length();
-  }
+std::string_view trimLeftView(std::string_view str, std::string_view chars) {
+  const ByteSet set = makeByteSet(chars);
+  str.remove_prefix(scanByteSet(str.data(), str.size(), set, false));
+  return str;
+}
+
+std::string_view trimRightView(std::string_view str, std::string_view chars) {
+  const ByteSet set = makeByteSet(chars);
+  return str.substr(0, lastNotOf(str.data(), str.size(), set));
+}
+
+std::string_view trimView(std::string_view str, std::string_view chars) {
+  const ByteSet set = makeByteSet(chars);
+  str = str.substr(0, lastNotOf(str.data(), str.size(), set));
+  str.remove_prefix(scanByteSet(str.data(), str.size(), set, false));
+  return str;
+}
+
+std::string replaceAll(std::string_view str, std::string_view from, std::string_view to) {
+  if (from.empty()) return std::string(str);
+  size_t pos = findSubstring(str, from);
+  if (pos == npos) return std::string(str);
+  // 单遍拼接结果，避免原地 replace 反复搬移尾部
+  std::string result;
+  result.reserve(str.size());
+  size_t start = 0;
+  do {
+    result.append(str.substr(start, pos - start));
+    result.append(to);
+    start = pos + from.size();
+  } while ((pos = findSubstring(str, from, start)) != npos);
+  result.append(str.substr(start));
   return result;
 }
 
-std::string stripPrefix(const std::string& str, const std::string& prefix) {
-  if (startsWith(str, prefix)) return str.substr(prefix.size());
+std::string stripPrefix(std::string_view str, std::string_view prefix) {
+  return std::string(stripPrefixView(str, prefix));
+}
+
+std::string stripSuffix(std::string_view str, std::string_view suffix) {
+  return std::string(stripSuffixView(str, suffix));
+}
+
+std::string_view stripPrefixView(std::string_view str, std::string_view prefix) {
+  if (str.starts_with(prefix)) str.remove_prefix(prefix.size());
   return str;
 }
 
-std::string stripSuffix(const std::string& str, const std::string& suffix) {
-  if (endsWith(str, suffix)) return str.substr(0, str.size() - suffix.size());
+std::string_view stripSuffixView(std::string_view str, std::string_view suffix) {
+  if (str.ends_with(suffix)) str.remove_suffix(suffix.size());
   return str;
 }
 
-std::string padLeft(const std::string& str, size_t width, char fill) {
-  if (str.size() >= width) return str;
-  return std::string(width - str.size(), fill) + str;
+std::string padLeft(std::string_view str, size_t width, char fill) {
+  if (str.size() >= width) return std::string(str);
+  std::string result(width - str.size(), fill);
+  result.append(str);
+  return result;
 }
 
-std::string padRight(const std::string& str, size_t width, char fill) {
-  if (str.size() >= width) return str;
-  return str + std::string(width - str.size(), fill);
+std::string padRight(std::string_view str, size_t width, char fill) {
+  std::string result(str);
+  if (result.size() < width) result.resize(width, fill);
+  return result;
 }
 
-std::string repeat(const std::string& str, size_t n) {
+std::string repeat(std::string_view str, size_t n) {
   std::string result;
   result.reserve(str.size() * n);
-  for (size_t i = 0; i < n; ++i) result += str;
+  for (size_t i = 0; i < n; ++i) result.append(str);
   return result;
 }
 
-std::vector<std::string> split(const std::string& str, const std::string& delimiter) {
+std::vector<std::string> split(std::string_view str, std::string_view delimiter) {
   std::vector<std::string> vec;
-  if (delimiter.empty()) {
-    for (char c : str) vec.emplace_back(1, c);
-    return vec;
+  for (const std::string_view token : splitView(str, delimiter)) vec.emplace_back(token);
+  return vec;
+}
+
+std::vector<std::string> split(std::string_view str, char delimiter) {
+  std::vector<std::string> vec;
+  const char* const end = str.data() + str.size();
+  const char* start = str.data();
+  while (const void* hit = std::memchr(start, delimiter, static_cast<size_t>(end - start))) {
+    const char* pos = static_cast<const char*>(hit);
+    vec.emplace_back(start, pos);
+    start = pos + 1;
   }
+  vec.emplace_back(start, end);
+  return vec;
+}
+
+std::vector<std::string> splitAnyOf(std::string_view str, std::string_view delimiters) {
+  std::vector<std::string> vec;
+  // 字符集合只构建一次，逐字符判断是查表而不是重新扫描 delimiters
+  const ByteSet set = makeByteSet(delimiters);
+  const char* const data = str.data();
   size_t start = 0;
   size_t pos = 0;
-  while ((pos = str.find(delimiter, start)) != std::string::npos) {
+  while ((pos = start + findFirstOf(data + start, str.size() - start, set)) < str.size()) {
     vec.emplace_back(str.substr(start, pos - start));
-    start = pos + delimiter.size();
+    start = pos + 1;
   }
   vec.emplace_back(str.substr(start));
   return vec;
 }
 
-std::vector<std::string> splitAnyOf(const std::string& str, const std::string& delimiters) {
-  std::vector<std::string> vec;
-  size_t old_pos = 0;
-  size_t pos = 0;
-  while ((pos = str.find_first_of(delimiters, old_pos)) != std::string::npos) {
-    vec.emplace_back(str.substr(old_pos, pos - old_pos));
-    old_pos = pos + 1;
+SplitView::iterator::iterator(std::string_view str, std::string_view delimiter, char ch, Mode mode)
+    : str_(str), delimiter_(delimiter), ch_(ch), mode_(mode), done_(false) {
+  if (mode_ == Mode::AnyOf) {
+    for (const char d : delimiter_) {
+      const auto c = static_cast<unsigned char>(d);
+      set_[c >> 6] |= uint64_t{1} << (c & 63);
+    }
   }
-  vec.emplace_back(str.substr(old_pos));
-  return vec;
+  // 与 split(str, "") 一致：逐字符分割时空字符串不产生片段
+  if (mode_ == Mode::String && delimiter_.empty() && str_.empty()) {
+    done_ = true;
+    return;
+  }
+  load();
 }
 
-std::string join(char glue, const std::vector<std::string>& pieces) {
-  std::string result;
-  if (!pieces.empty()) {
-    result.append(pieces[0]);
-    for (size_t i = 1; i < pieces.size(); ++i) {
-      result.push_back(glue);
-      result.append(pieces[i]);
+void SplitView::iterator::load() {
+  const char* const base = str_.data() + pos_;
+  const size_t remain = str_.size() - pos_;
+  size_t len = remain;  // 片段长度
+  size_t skip = 0;      // 其后分隔符的长度，0 表示没有分隔符
+  if (remain > 0) {
+    switch (mode_) {
+      case Mode::Char:
+        if (const void* hit = std::memchr(base, ch_, remain)) {
+          len = static_cast<size_t>(static_cast<const char*>(hit) - base);
+          skip = 1;
+        }
+        break;
+      case Mode::String:
+        if (delimiter_.empty()) {
+          token_ = str_.substr(pos_, 1);
+          next_ = pos_ + 1;
+          last_ = next_ >= str_.size();
+          return;
+        }
+        if (const size_t hit = findSubstring(str_, delimiter_, pos_); hit != npos) {
+          len = hit - pos_;
+          skip = delimiter_.size();
+        }
+        break;
+      case Mode::AnyOf:
+        len = findFirstOfShort(base, remain, set_, delimiter_);
+        skip = len < remain ? 1 : 0;
+        break;
     }
   }
-  return result;
+  token_ = std::string_view(base, len);
+  next_ = pos_ + len + skip;
+  last_ = skip == 0;
 }
 
-std::string join(const std::string& glue, const std::vector<std::string>& pieces) {
-  std::string result;
-  if (!pieces.empty()) {
-    result.append(pieces[0]);
-    for (size_t i = 1; i < pieces.size(); ++i) {
-      result.append(glue);
-      result.append(pieces[i]);
-    }
+void SplitView::iterator::advance() {
+  if (last_) {
+    done_ = true;
+    return;
   }
-  return result;
+  pos_ = next_;
+  load();
+}
+
+SplitView splitView(std::string_view str, char delimiter) {
+  return SplitView(str, delimiter);
+}
+
+SplitView splitView(std::string_view str, std::string_view delimiter) {
+  return SplitView(str, delimiter, SplitView::Mode::String);
+}
+
+SplitView splitAnyOfView(std::string_view str, std::string_view delimiters) {
+  return SplitView(str, delimiters, SplitView::Mode::AnyOf);
+}
+
+std::string join(char glue, const std::vector<std::string>& pieces) {
+  return detail::joinRange(std::string_view(&glue, 1), pieces);
+}
+
+std::string join(std::string_view glue, const std::vector<std::string>& pieces) {
+  return detail::joinRange(glue, pieces);
 }
 
 }  // namespace utils
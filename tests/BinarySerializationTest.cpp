@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "pickup/buffer/BinaryReader.h"
+#include "pickup/buffer/BinaryWriter.h"
+
+using namespace pickup::buffer;
+using pickup::utils::Endian;
+
+TEST(BinarySerializationTest, FixedWidthBigEndian) {
+  ByteBuffer out;
+  BinaryWriter w(out);
+  w.write<uint16_t>(0x0102);
+  w.write<uint32_t>(0x03040506);
+  EXPECT_EQ(out.toStringView(), std::string_view("\x01\x02\x03\x04\x05\x06", 6));
+
+  BinaryReader r(out);
+  uint16_t a = 0;
+  uint32_t b = 0;
+  EXPECT_TRUE(r.read(a));
+  EXPECT_TRUE(r.read(b));
+  EXPECT_EQ(a, 0x0102);
+  EXPECT_EQ(b, 0x03040506u);
+  EXPECT_TRUE(r.atEnd());
+}
+
+TEST(BinarySerializationTest, FixedWidthLittleEndianAndFloat) {
+  ByteBuffer out;
+  BinaryWriter w(out, Endian::Little);
+  w.write<int32_t>(-2);
+  w.write(3.5);
+  EXPECT_EQ(out.toStringView().substr(0, 4), std::string_view("\xfe\xff\xff\xff", 4));
+
+  BinaryReader r(out, Endian::Little);
+  int32_t i = 0;
+  double d = 0;
+  EXPECT_TRUE(r.read(i));
+  EXPECT_TRUE(r.read(d));
+  EXPECT_EQ(i, -2);
+  EXPECT_DOUBLE_EQ(d, 3.5);
+}
+
+TEST(BinarySerializationTest, ZigZag) {
+  EXPECT_EQ(encodeZigZag(0), 0u);
+  EXPECT_EQ(encodeZigZag(-1), 1u);
+  EXPECT_EQ(encodeZigZag(1), 2u);
+  EXPECT_EQ(encodeZigZag(-2), 3u);
+  for (int64_t v : {int64_t{0}, int64_t{-1}, int64_t{123456}, std::numeric_limits<int64_t>::min(),
+                    std::numeric_limits<int64_t>::max()}) {
+    EXPECT_EQ(decodeZigZag(encodeZigZag(v)), v);
+  }
+}
+
+TEST(BinarySerializationTest, VarintRoundTrip) {
+  const uint64_t values[] = {0, 1, 127, 128, 300, 16383, 16384, 0xFFFFFFFFull, std::numeric_limits<uint64_t>::max()};
+  ByteBuffer out;
+  BinaryWriter w(out);
+  size_t expected = 0;
+  for (uint64_t v : values) {
+    w.writeVarint(v);
+    expected += varintSize(v);
+  }
+  w.writeSignedVarint(-64);
+  expected += 1;
+  EXPECT_EQ(w.bytesWritten(), expected);
+  EXPECT_EQ(out[2], 0x7F);
+
+  BinaryReader r(out);
+  for (uint64_t v : values) {
+    uint64_t got = 1;
+    ASSERT_TRUE(r.readVarint(got));
+    EXPECT_EQ(got, v);
+  }
+  int64_t s = 0;
+  EXPECT_TRUE(r.readSignedVarint(s));
+  EXPECT_EQ(s, -64);
+  EXPECT_TRUE(r.atEnd());
+}
+
+TEST(BinarySerializationTest, VarintMalformed) {
+  BinaryReader truncated(std::string_view("\x80\x80", 2));
+  uint64_t v = 0;
+  EXPECT_FALSE(truncated.readVarint(v));
+  EXPECT_EQ(truncated.position(), 0);
+
+  BinaryReader overflow(std::string_view("\xff\xff\xff\xff\xff\xff\xff\xff\xff\x02", 10));
+  EXPECT_FALSE(overflow.readVarint(v));
+
+  ByteBuffer out;
+  BinaryWriter(out).writeVarint(uint64_t{1} << 40);
+  BinaryReader narrow(out);
+  uint32_t v32 = 0;
+  EXPECT_FALSE(narrow.readVarint(v32));
+  EXPECT_EQ(narrow.position(), 0);
+}
+
+TEST(BinarySerializationTest, StringsAreViewsIntoBuffer) {
+  ByteBuffer out;
+  BinaryWriter w(out);
+  const std::string name = "pickup";
+  w.reserve(BinaryWriter::stringSize(name) + BinaryWriter::bytesSize(3) + 4);
+  const size_t capacity = out.capacity();
+  w.writeString(name);
+  const uint8_t raw[] = {1, 2, 3};
+  w.writeBytes(raw, 3);
+  w.write<uint32_t>(7);
+  EXPECT_EQ(out.capacity(), capacity);
+
+  BinaryReader r(out);
+  std::string_view s;
+  std::string_view bytes;
+  uint32_t tail = 0;
+  EXPECT_TRUE(r.readString(s));
+  EXPECT_TRUE(r.readBytes(bytes));
+  EXPECT_TRUE(r.read(tail));
+  EXPECT_EQ(s, "pickup");
+  EXPECT_EQ(reinterpret_cast<const uint8_t*>(s.data()), out.data() + 1);
+  EXPECT_EQ(bytes, std::string_view("\x01\x02\x03", 3));
+  EXPECT_EQ(tail, 7u);
+}
+
+TEST(BinarySerializationTest, SoftFailIsSticky) {
+  ByteBuffer out;
+  BinaryWriter w(out);
+  w.write<uint16_t>(1);
+  w.writeVarint(100);  // 声称 100 字节，实际没有
+
+  BinaryReader r(out);
+  uint16_t a = 0;
+  std::string_view s;
+  uint32_t b = 0;
+  EXPECT_TRUE(r.read(a));
+  EXPECT_FALSE(r.readString(s));
+  EXPECT_EQ(r.position(), 2);
+  EXPECT_FALSE(r.read(b));
+  EXPECT_FALSE(r.skip(0));
+  EXPECT_FALSE(r.ok());
+}
+
+TEST(BinarySerializationTest, RawAndSkip) {
+  BinaryReader r(std::string_view("abcdef"));
+  std::string_view v;
+  EXPECT_TRUE(r.skip(2));
+  EXPECT_TRUE(r.readRaw(v, 3));
+  EXPECT_EQ(v, "cde");
+  EXPECT_EQ(r.remaining(), 1);
+  EXPECT_FALSE(r.readRaw(v, 2));
+  EXPECT_EQ(v, "cde");
+}
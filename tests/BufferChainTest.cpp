@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+
+#include "pickup/buffer/BufferChain.h"
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+using namespace pickup::buffer;
+
+TEST(BufferChainTest, AppendByReference) {
+  ByteSlice body = ByteSlice::copyOf("body");
+  BufferChain chain;
+  chain.append(ByteBuffer("head-"));
+  chain.append(body);
+  chain.append(std::string_view("-tail"));
+  EXPECT_EQ(chain.size(), 14);
+  EXPECT_EQ(chain.segmentCount(), 3);
+  EXPECT_EQ(body.useCount(), 2);
+  EXPECT_EQ(chain.flatten().toStringView(), "head-body-tail");
+}
+
+TEST(BufferChainTest, EmptySegmentsIgnored) {
+  BufferChain chain;
+  chain.append(ByteSlice());
+  chain.append(std::string_view());
+  chain.prepend(ByteBuffer());
+  EXPECT_TRUE(chain.empty());
+  EXPECT_EQ(chain.segmentCount(), 0);
+}
+
+TEST(BufferChainTest, Prepend) {
+  BufferChain chain;
+  chain.append(std::string_view("payload"));
+  chain.prepend(ByteSlice::copyOf("len:"));
+  EXPECT_EQ(chain.flatten().toStringView(), "len:payload");
+}
+
+TEST(BufferChainTest, CutSplitsAcrossSegments) {
+  BufferChain chain;
+  chain.append(std::string_view("abc"));
+  chain.append(std::string_view("defg"));
+  chain.append(std::string_view("hi"));
+
+  BufferChain head = chain.cut(5);
+  EXPECT_EQ(head.flatten().toStringView(), "abcde");
+  EXPECT_EQ(head.segmentCount(), 2);
+  EXPECT_EQ(chain.flatten().toStringView(), "fghi");
+  EXPECT_EQ(chain.size(), 4);
+
+  BufferChain rest = chain.cut(100);
+  EXPECT_EQ(rest.flatten().toStringView(), "fghi");
+  EXPECT_TRUE(chain.empty());
+}
+
+TEST(BufferChainTest, DrainAndIterate) {
+  BufferChain chain;
+  chain.append(std::string_view("xx"));
+  chain.append(std::string_view("yyy"));
+  chain.drain(3);
+  ASSERT_EQ(chain.segmentCount(), 1);
+  for (const ByteSlice& segment : chain) {
+    EXPECT_EQ(segment.toStringView(), "yy");
+  }
+}
+
+TEST(BufferChainTest, AppendChain) {
+  BufferChain a;
+  BufferChain b;
+  a.append(std::string_view("1"));
+  b.append(std::string_view("2"));
+  b.append(std::string_view("3"));
+  a.append(std::move(b));
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(a.flatten().toStringView(), "123");
+}
+
+TEST(BufferChainTest, ToIovecLimit) {
+  BufferChain chain;
+  chain.append(std::string_view("ab"));
+  chain.append(std::string_view("cd"));
+  chain.append(std::string_view("ef"));
+  IoVec iov[2];
+  EXPECT_EQ(chain.toIovec(iov, 2), 2);
+  EXPECT_EQ(iov[1].iov_len, 2);
+  EXPECT_EQ(std::string(static_cast<const char*>(iov[1].iov_base), 2), "cd");
+  EXPECT_EQ(chain.toIovec().size(), 3);
+}
+
+#if !defined(_WIN32)
+TEST(BufferChainTest, WritevReadvRoundTrip) {
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+
+  BufferChain out;
+  out.append(std::string_view("header|"));
+  out.append(ByteBuffer(std::string(1000, 'b')));
+  out.append(std::string_view("|trailer"));
+  auto iov = out.toIovec();
+  ASSERT_EQ(::writev(fds[1], iov.data(), static_cast<int>(iov.size())), static_cast<ssize_t>(out.size()));
+
+  BufferChain in;
+  auto readIov = in.prepareRead(2048, 512);
+  EXPECT_EQ(readIov.size(), 4);
+  const ssize_t n = ::readv(fds[0], readIov.data(), static_cast<int>(readIov.size()));
+  ASSERT_EQ(n, static_cast<ssize_t>(out.size()));
+  in.commitRead(static_cast<size_t>(n));
+  EXPECT_EQ(in.size(), out.size());
+  EXPECT_EQ(in.flatten(), out.flatten());
+
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+#endif
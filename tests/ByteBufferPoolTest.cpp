@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "pickup/buffer/ByteBufferArena.h"
+#include "pickup/buffer/ByteBufferPool.h"
+#include "pickup/buffer/ByteSlice.h"
+
+using namespace pickup::buffer;
+
+namespace {
+
+// 记录调用次数的 malloc 分配器
+class CountingAllocator : public ByteBufferAllocator {
+ public:
+  void* allocate(size_t size) override {
+    ++allocations;
+    return std::malloc(size);
+  }
+  void deallocate(void* ptr, size_t /*size*/) override {
+    ++deallocations;
+    std::free(ptr);
+  }
+
+  int allocations = 0;
+  int deallocations = 0;
+};
+
+}  // namespace
+
+TEST(ByteBufferAllocatorTest, CustomAllocatorUsed) {
+  CountingAllocator allocator;
+  {
+    ByteBuffer buf(&allocator);
+    EXPECT_EQ(buf.allocator(), &allocator);
+    for (int i = 0; i < 100; ++i) {
+      buf.append(std::string_view("0123456789"));
+    }
+    EXPECT_EQ(buf.size(), 1000);
+    EXPECT_GT(allocator.allocations, 0);
+  }
+  EXPECT_EQ(allocator.allocations, allocator.deallocations);
+}
+
+TEST(ByteBufferAllocatorTest, AllocatorFollowsMoveAndCopy) {
+  CountingAllocator allocator;
+  {
+    ByteBuffer a(&allocator);
+    a.append(std::string_view("data"));
+    ByteBuffer b(std::move(a));
+    EXPECT_EQ(b.allocator(), &allocator);
+    ByteBuffer c(b);
+    EXPECT_EQ(c.allocator(), &allocator);
+    ByteBuffer d;
+    d = c;
+    EXPECT_EQ(d.allocator(), nullptr);
+    EXPECT_EQ(d.toStringView(), "data");
+    ByteSlice slice(std::move(c));
+    EXPECT_EQ(slice.toStringView(), "data");
+  }
+  EXPECT_EQ(allocator.allocations, allocator.deallocations);
+}
+
+TEST(ByteBufferPoolTest, InvalidOptionsThrow) {
+  ByteBufferPoolOptions options;
+  options.minBlockSize = 4096;
+  options.maxBlockSize = 64;
+  EXPECT_THROW(ByteBufferPool{options}, std::invalid_argument);
+}
+
+TEST(ByteBufferPoolTest, GoodSizeRoundsToClass) {
+  ByteBufferPool pool;
+  EXPECT_EQ(pool.goodSize(1), 64);
+  EXPECT_EQ(pool.goodSize(64), 64);
+  EXPECT_EQ(pool.goodSize(65), 128);
+  EXPECT_EQ(pool.goodSize(1024 * 1024), 1024 * 1024);
+  EXPECT_EQ(pool.goodSize(1024 * 1024 + 1), 1024 * 1024 + 1);
+  EXPECT_EQ(pool.classCount(), 15);
+}
+
+TEST(ByteBufferPoolTest, ReusesReleasedBlocks) {
+  ByteBufferPool pool;
+  const ByteBuffer::Byte* first = nullptr;
+  {
+    ByteBuffer buf = pool.acquire(100);
+    EXPECT_EQ(buf.capacity(), 128);
+    buf.append(std::string_view("hello"));
+    first = buf.data();
+  }
+  auto stats = pool.stats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.recycled, 1);
+
+  ByteBuffer again = pool.acquire(120);
+  EXPECT_EQ(again.data(), first);
+  stats = pool.stats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_DOUBLE_EQ(stats.hitRate(), 0.5);
+
+  pool.resetStats();
+  EXPECT_EQ(pool.stats().hits, 0);
+}
+
+TEST(ByteBufferPoolTest, OversizedBypassesCache) {
+  ByteBufferPoolOptions options;
+  options.maxBlockSize = 4096;
+  ByteBufferPool pool(options);
+  { ByteBuffer buf = pool.acquire(10000); }
+  auto stats = pool.stats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.released, 1);
+  EXPECT_EQ(stats.recycled, 0);
+}
+
+TEST(ByteBufferPoolTest, CacheLimitPerClass) {
+  ByteBufferPoolOptions options;
+  options.maxCachedPerClass = 2;
+  ByteBufferPool pool(options);
+  {
+    ByteBuffer a = pool.acquire(64);
+    ByteBuffer b = pool.acquire(64);
+    ByteBuffer c = pool.acquire(64);
+  }
+  auto stats = pool.stats();
+  EXPECT_EQ(stats.recycled, 2);
+  EXPECT_EQ(stats.released, 1);
+}
+
+TEST(ByteBufferPoolTest, CrossThreadRelease) {
+  ByteBufferPool pool;
+  ByteBuffer buf = pool.acquire(256);
+  buf.append(std::string_view("payload"));
+  std::thread consumer([b = std::move(buf)]() mutable { EXPECT_EQ(b.toStringView(), "payload"); });
+  consumer.join();
+  auto stats = pool.stats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.recycled, 1);
+}
+
+TEST(ByteBufferPoolTest, StatsSumPerThreadCounters) {
+  ByteBufferPool pool;
+  constexpr int kThreads = 4;
+  constexpr int kRounds = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&pool] {
+      for (int i = 0; i < kRounds; ++i) {
+        ByteBuffer buf = pool.acquire(200);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  // 线程已退出，各自的计数仍计入汇总；每个线程只在第一次分配时未命中
+  auto stats = pool.stats();
+  EXPECT_EQ(stats.misses, kThreads);
+  EXPECT_EQ(stats.hits, kThreads * (kRounds - 1));
+  EXPECT_EQ(stats.recycled, kThreads * kRounds);
+  EXPECT_EQ(stats.released, 0);
+
+  pool.resetStats();
+  { ByteBuffer buf = pool.acquire(200); }
+  std::thread([&pool] { ByteBuffer buf = pool.acquire(200); }).join();
+  stats = pool.stats();
+  EXPECT_EQ(stats.misses, 2);
+  EXPECT_EQ(stats.hits, 0);
+  EXPECT_EQ(stats.recycled, 2);
+}
+
+TEST(ByteBufferArenaTest, BumpAllocation) {
+  ByteBufferArena arena(1024);
+  ByteBuffer a = arena.acquire(100);
+  ByteBuffer b = arena.acquire(100);
+  a.append(std::string_view("aaa"));
+  b.append(std::string_view("bbb"));
+  EXPECT_EQ(a.allocator(), &arena);
+  EXPECT_EQ(b.data() - a.data(), static_cast<std::ptrdiff_t>(arena.goodSize(100)));
+  EXPECT_EQ(arena.bytesReserved(), 1024);
+  EXPECT_EQ(a.toStringView(), "aaa");
+  EXPECT_EQ(b.toStringView(), "bbb");
+}
+
+TEST(ByteBufferArenaTest, GrowAndReset) {
+  ByteBufferArena arena(1024);
+  {
+    ByteBuffer buf(&arena);
+    for (int i = 0; i < 1000; ++i) {
+      buf.append(std::string_view("0123456789"));
+    }
+    EXPECT_EQ(buf.size(), 10000);
+    EXPECT_EQ(buf.toStringView().substr(9990), "0123456789");
+  }
+  EXPECT_GE(arena.bytesReserved(), 1024);
+  arena.reset();
+  EXPECT_EQ(arena.bytesUsed(), 0);
+  EXPECT_EQ(arena.bytesReserved(), 1024);
+
+  ByteBuffer next = arena.acquire(16);
+  next.append(std::string_view("x"));
+  EXPECT_EQ(next.toStringView(), "x");
+}
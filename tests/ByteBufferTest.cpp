@@ -211,3 +211,35 @@ TEST(ByteBufferTest, LargeAppend) {
     EXPECT_EQ(buf[i], static_cast<ByteBuffer::Byte>(i & 0xFF));
   }
 }
+
+TEST(ByteBufferTest, ShiftAdvancesWithoutMoving) {
+  ByteBuffer buf("abcdef");
+  const auto* second = buf.data() + 2;
+  buf.shift(2);
+  EXPECT_EQ(buf.data(), second);
+  EXPECT_EQ(buf.toStringView(), "cdef");
+  EXPECT_EQ(buf[0], 'c');
+}
+
+TEST(ByteBufferTest, AppendAfterShiftReclaimsPrefix) {
+  ByteBuffer buf;
+  buf.reserve(16);
+  const auto* start = buf.data();
+  buf.append(std::string_view("0123456789abcdef"));
+  buf.shift(12);
+  // 前缀足够大，追加时应就地压缩而非扩容
+  buf.append(std::string_view("XYZ"));
+  EXPECT_EQ(buf.data(), start);
+  EXPECT_EQ(buf.toStringView(), "cdefXYZ");
+}
+
+TEST(ByteBufferTest, FrameParsingLoop) {
+  ByteBuffer buf;
+  for (int i = 0; i < 1000; ++i) {
+    buf.append(std::string_view("frame;"));
+    ASSERT_EQ(buf.toStringView().substr(0, 6), "frame;");
+    buf.shift(6);
+  }
+  EXPECT_TRUE(buf.empty());
+  EXPECT_LE(buf.capacity(), 16);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+
+#include "pickup/buffer/ByteSlice.h"
+
+using namespace pickup::buffer;
+
+TEST(ByteSliceTest, DefaultIsEmpty) {
+  ByteSlice slice;
+  EXPECT_TRUE(slice.empty());
+  EXPECT_EQ(slice.size(), 0);
+  EXPECT_EQ(slice.useCount(), 0);
+}
+
+TEST(ByteSliceTest, TakesOverBufferWithoutCopy) {
+  ByteBuffer buf("hello world");
+  const auto* raw = buf.data();
+  ByteSlice slice(std::move(buf));
+  EXPECT_TRUE(buf.empty());
+  EXPECT_EQ(slice.data(), raw);
+  EXPECT_EQ(slice.toStringView(), "hello world");
+}
+
+TEST(ByteSliceTest, SubSliceSharesStorage) {
+  ByteSlice whole(ByteBuffer("hello world"));
+  ByteSlice word = whole.slice(6, 5);
+  EXPECT_EQ(word.toStringView(), "world");
+  EXPECT_EQ(word.data(), whole.data() + 6);
+  EXPECT_EQ(whole.useCount(), 2);
+
+  EXPECT_EQ(whole.slice(6).toStringView(), "world");
+  EXPECT_EQ(whole.slice(3, 100).toStringView(), "lo world");
+  EXPECT_TRUE(whole.slice(11).empty());
+}
+
+TEST(ByteSliceTest, OutlivesOriginal) {
+  ByteSlice tail;
+  {
+    ByteSlice whole(ByteBuffer("frame-payload"));
+    tail = whole.slice(6);
+  }
+  EXPECT_EQ(tail.useCount(), 1);
+  EXPECT_EQ(tail.toStringView(), "payload");
+}
+
+TEST(ByteSliceTest, PopFrontParsesFrames) {
+  ByteSlice stream = ByteSlice::copyOf("AAABBCCCC");
+  EXPECT_EQ(stream.popFront(3).toStringView(), "AAA");
+  EXPECT_EQ(stream.popFront(2).toStringView(), "BB");
+  EXPECT_EQ(stream.toStringView(), "CCCC");
+  EXPECT_EQ(stream.popFront(10).toStringView(), "CCCC");
+  EXPECT_TRUE(stream.empty());
+}
+
+TEST(ByteSliceTest, RemovePrefixSuffix) {
+  ByteSlice s = ByteSlice::copyOf("[payload]");
+  s.removePrefix(1);
+  s.removeSuffix(1);
+  EXPECT_EQ(s.toStringView(), "payload");
+  EXPECT_EQ(s.toByteBuffer(), ByteBuffer("payload"));
+  s.removeSuffix(100);
+  EXPECT_TRUE(s.empty());
+}
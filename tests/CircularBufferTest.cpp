@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <cstring>
+#include <memory>
+#include <vector>
 
 #include "pickup/buffer/CircularBuffer.h"
 
@@ -140,3 +142,78 @@ TEST(CircularBufferTest, DoubleAllocateFails) {
   EXPECT_TRUE(buf.allocate(8));
   // 第二次分配会触发 assert
 }
+
+TEST(CircularBufferTest, PeekConsumeSplitsAtWrapWhenNotMirrored) {
+  CircularBuffer buf;
+  ASSERT_TRUE(buf.allocate(8));
+  uint8_t data[6] = {1, 2, 3, 4, 5, 6};
+  EXPECT_TRUE(buf.write(data, 6));
+  buf.consume(5);
+  EXPECT_TRUE(buf.write(data, 4));
+
+  auto bytes = buf.peek();
+  ASSERT_EQ(bytes.size(), 3);
+  EXPECT_EQ(bytes[0], 6);
+  buf.consume(bytes.size());
+  bytes = buf.peek();
+  ASSERT_EQ(bytes.size(), 2);
+  EXPECT_EQ(bytes[1], 4);
+}
+
+TEST(CircularBufferTest, PrepareAndCommitWrite) {
+  CircularBuffer buf;
+  ASSERT_TRUE(buf.allocate(8));
+  auto room = buf.prepareWrite();
+  ASSERT_EQ(room.size(), 7);
+  room[0] = 42;
+  room[1] = 43;
+  buf.commitWrite(2);
+  EXPECT_EQ(buf.used(), 2);
+  uint8_t out[2] = {};
+  EXPECT_EQ(buf.read(out, 2), 2);
+  EXPECT_EQ(out[1], 43);
+}
+
+TEST(CircularBufferTest, MirroredWrapIsContiguous) {
+  CircularBuffer buf;
+  ASSERT_TRUE(buf.allocateMirrored(100));
+  if (!buf.mirrored()) {
+    GTEST_SKIP() << "memfd_create unavailable";
+  }
+  EXPECT_EQ(buf.size() % MirroredMemory::pageSize(), 0);
+
+  const size_t size = buf.size();
+  std::vector<uint8_t> fill(size - 10, 0);
+  ASSERT_TRUE(buf.write(fill.data(), fill.size()));
+  buf.consume(fill.size());
+
+  // 跨越回绕点写入 20 字节
+  uint8_t msg[20];
+  for (uint8_t i = 0; i < 20; ++i) {
+    msg[i] = i;
+  }
+  ASSERT_TRUE(buf.write(msg, sizeof(msg)));
+  auto bytes = buf.peek();
+  ASSERT_EQ(bytes.size(), 20);
+  EXPECT_EQ(std::memcmp(bytes.data(), msg, sizeof(msg)), 0);
+
+  auto room = buf.prepareWrite();
+  EXPECT_EQ(room.size(), buf.available());
+
+  uint8_t out[20] = {};
+  EXPECT_EQ(buf.read(out, sizeof(out)), 20);
+  EXPECT_EQ(std::memcmp(out, msg, sizeof(msg)), 0);
+  EXPECT_EQ(buf.used(), 0);
+}
+
+TEST(CircularBufferTest, MirroredDeallocateAndReallocate) {
+  CircularBuffer buf;
+  ASSERT_TRUE(buf.allocateMirrored(4096));
+  uint8_t data[3] = {1, 2, 3};
+  EXPECT_TRUE(buf.write(data, 3));
+  buf.deallocate();
+  EXPECT_EQ(buf.used(), 0);
+  EXPECT_FALSE(buf.mirrored());
+  ASSERT_TRUE(buf.allocate(16));
+  EXPECT_EQ(buf.used(), 0);
+}
@@ -0,0 +1,390 @@
+// 编解码器差分模糊测试：随机生成（并随机破坏）输入，逐个 SIMD 级别将快速路径
+// 与下面逐字节实现的参考版本比较。默认迭代次数适合日常 CI，长时间运行时可通过
+// 环境变量 PICKUP_FUZZ_ITERATIONS 放大。
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pickup/buffer/ByteBuffer.h"
+#include "pickup/codec/base64.h"
+#include "pickup/codec/hex.h"
+#include "pickup/codec/url.h"
+#include "pickup/utils/CpuFeatures.h"
+
+#include "SimdTestUtils.h"
+
+using namespace pickup::codec;
+using pickup::utils::SimdLevel;
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// 参考实现
+// ---------------------------------------------------------------------------
+
+namespace ref {
+
+struct Base64Alphabet {
+  std::string chars;
+  bool pad;
+};
+
+Base64Alphabet alphabetOf(base64::Variant variant) {
+  const std::string alnum = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+  switch (variant) {
+    case base64::Variant::StandardNoPad:
+      return {alnum + "+/", false};
+    case base64::Variant::UrlSafe:
+      return {alnum + "-_", true};
+    case base64::Variant::UrlSafeNoPad:
+      return {alnum + "-_", false};
+    case base64::Variant::Standard:
+    default:
+      return {alnum + "+/", true};
+  }
+}
+
+int valueOf(const Base64Alphabet& a, char c) {
+  const size_t pos = a.chars.find(c);
+  return pos == std::string::npos || c == '\0' ? -1 : static_cast<int>(pos);
+}
+
+std::string base64Encode(std::string_view in, base64::Variant variant) {
+  const Base64Alphabet a = alphabetOf(variant);
+  std::string out;
+  uint32_t acc = 0;
+  int bits = 0;
+  for (unsigned char c : in) {
+    acc = (acc << 8) | c;
+    bits += 8;
+    while (bits >= 6) {
+      bits -= 6;
+      out += a.chars[(acc >> bits) & 63];
+    }
+  }
+  if (bits > 0) {
+    out += a.chars[(acc << (6 - bits)) & 63];
+  }
+  while (a.pad && out.size() % 4 != 0) {
+    out += '=';
+  }
+  return out;
+}
+
+// 取合法前缀的所有 6 位值拼接，不足 8 位的尾部丢弃
+std::string base64DecodeValues(std::string_view in, const Base64Alphabet& a) {
+  std::string out;
+  uint32_t acc = 0;
+  int bits = 0;
+  for (char c : in) {
+    const int v = valueOf(a, c);
+    if (v < 0) {
+      break;
+    }
+    acc = (acc << 6) | static_cast<uint32_t>(v);
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      out += static_cast<char>((acc >> bits) & 0xFF);
+    }
+  }
+  return out;
+}
+
+std::string base64DecodeLenient(std::string_view in, base64::Variant variant) {
+  return base64DecodeValues(in, alphabetOf(variant));
+}
+
+// 返回解码结果或第一个错误的偏移
+std::pair<std::optional<std::string>, size_t> base64DecodeStrict(std::string_view in, base64::Variant variant) {
+  const Base64Alphabet a = alphabetOf(variant);
+  const size_t len = in.size();
+  size_t p = 0;
+  while (p < len && valueOf(a, in[p]) >= 0) {
+    ++p;
+  }
+  if (p < len) {
+    if (!a.pad || in[p] != '=') {
+      return {std::nullopt, p};
+    }
+    // '=' 只能出现在最后一组的第 3、4 位，且之后只能是 '='
+    const bool inLastGroup = p / 4 == (len - 1) / 4;
+    const bool restIsPadding = std::all_of(in.begin() + static_cast<std::ptrdiff_t>(p), in.end(),
+                                           [](char c) { return c == '='; });
+    if (!inLastGroup || p % 4 < 2 || !restIsPadding) {
+      return {std::nullopt, p};
+    }
+  }
+  if (a.pad && len % 4 != 0) {
+    return {std::nullopt, len};
+  }
+  if (!a.pad && len % 4 == 1) {
+    return {std::nullopt, len - 1};
+  }
+  return {base64DecodeValues(in, a), len};
+}
+
+int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+std::optional<std::vector<uint8_t>> hexDecode(std::string_view in) {
+  if (in.size() % 2 != 0) {
+    return std::nullopt;
+  }
+  std::vector<uint8_t> out;
+  for (size_t i = 0; i < in.size(); i += 2) {
+    const int high = hexValue(in[i]);
+    const int low = hexValue(in[i + 1]);
+    if (high < 0 || low < 0) {
+      return std::nullopt;
+    }
+    out.push_back(static_cast<uint8_t>(high * 16 + low));
+  }
+  return out;
+}
+
+std::optional<std::vector<uint8_t>> hexDecodeWithSeparator(std::string_view in, char separator) {
+  std::string clean;
+  for (char c : in) {
+    if (c != separator) {
+      clean += c;
+    }
+  }
+  return hexDecode(clean);
+}
+
+std::string urlEncode(std::string_view in, url::Component component) {
+  std::string keep;
+  if (component == url::Component::Path) keep = "!$&'()*+,;=:@/";
+  if (component == url::Component::Query) keep = "!$'()*,;:@/?";
+  std::string out;
+  for (unsigned char c : in) {
+    const bool alnum = (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+    if (alnum || (c != 0 && (std::string_view("-._~").find(static_cast<char>(c)) != std::string_view::npos ||
+                             keep.find(static_cast<char>(c)) != std::string::npos))) {
+      out += static_cast<char>(c);
+    } else if (component == url::Component::Form && c == ' ') {
+      out += '+';
+    } else {
+      static const char kHex[] = "0123456789ABCDEF";
+      out += '%';
+      out += kHex[c >> 4];
+      out += kHex[c & 15];
+    }
+  }
+  return out;
+}
+
+std::pair<std::optional<std::string>, size_t> urlDecode(std::string_view in, url::Component component) {
+  std::string out;
+  for (size_t i = 0; i < in.size(); ++i) {
+    if (in[i] == '%') {
+      if (i + 2 >= in.size() || hexValue(in[i + 1]) < 0 || hexValue(in[i + 2]) < 0) {
+        return {std::nullopt, i};
+      }
+      out += static_cast<char>(hexValue(in[i + 1]) * 16 + hexValue(in[i + 2]));
+      i += 2;
+    } else if (in[i] == '+' && component == url::Component::Form) {
+      out += ' ';
+    } else {
+      out += in[i];
+    }
+  }
+  return {out, in.size()};
+}
+
+}  // namespace ref
+
+// ---------------------------------------------------------------------------
+// 输入生成
+// ---------------------------------------------------------------------------
+
+size_t fuzzIterations() {
+  const char* env = std::getenv("PICKUP_FUZZ_ITERATIONS");
+  return env != nullptr ? std::strtoull(env, nullptr, 10) : 300;
+}
+
+class Generator {
+ public:
+  explicit Generator(uint32_t seed) : rng_(seed) {}
+
+  size_t length() {
+    // 大多数落在向量块边界附近，偶尔取较长输入
+    const uint32_t r = next(100);
+    return r < 90 ? next(200) : next(5000);
+  }
+
+  std::string bytes(size_t len) {
+    std::string s(len, '\0');
+    for (auto& c : s) {
+      c = static_cast<char>(next(256));
+    }
+    return s;
+  }
+
+  // 以 charset 中的字符为主，混入少量任意字节
+  std::string text(size_t len, std::string_view charset) {
+    std::string s(len, '\0');
+    for (auto& c : s) {
+      c = next(16) == 0 ? static_cast<char>(next(256)) : charset[next(static_cast<uint32_t>(charset.size()))];
+    }
+    return s;
+  }
+
+  // 随机破坏：替换若干字节为"危险"字符、截断或保持不变
+  std::string mutate(std::string s) {
+    static constexpr std::string_view kTricky = "=+/-_% :\x80\xff\0G`@z";
+    const uint32_t mode = next(4);
+    if (mode == 0 || s.empty()) {
+      return s;
+    }
+    if (mode == 1) {
+      s.resize(next(static_cast<uint32_t>(s.size())));
+      return s;
+    }
+    const uint32_t count = 1 + next(3);
+    for (uint32_t k = 0; k < count; ++k) {
+      s[next(static_cast<uint32_t>(s.size()))] = kTricky[next(static_cast<uint32_t>(kTricky.size()))];
+    }
+    return s;
+  }
+
+  uint32_t next(uint32_t bound) { return std::uniform_int_distribution<uint32_t>(0, bound - 1)(rng_); }
+
+ private:
+  std::mt19937 rng_;
+};
+
+class CodecFuzzTest : public ::testing::Test {
+ protected:
+  const std::vector<SimdLevel> levels_ = pickup::test::simdLevels();
+
+ private:
+  pickup::test::ScopedSimdLevelLimit limit_;  // 用例逐级设置上限，结束后恢复
+};
+
+constexpr base64::Variant kVariants[] = {base64::Variant::Standard, base64::Variant::StandardNoPad,
+                                         base64::Variant::UrlSafe, base64::Variant::UrlSafeNoPad};
+
+}  // namespace
+
+TEST_F(CodecFuzzTest, Base64MatchesReference) {
+  Generator gen(1);
+  const size_t iterations = fuzzIterations();
+  for (size_t it = 0; it < iterations; ++it) {
+    const std::string raw = gen.bytes(gen.length());
+    const base64::Variant variant = kVariants[gen.next(4)];
+    const std::string encoded = ref::base64Encode(raw, variant);
+    const std::string input = gen.mutate(encoded);
+    const auto expectedStrict = ref::base64DecodeStrict(input, variant);
+    const std::string expectedLenient = ref::base64DecodeLenient(input, variant);
+
+    for (SimdLevel level : levels_) {
+      pickup::utils::setSimdLevelLimit(level);
+      SCOPED_TRACE(testing::Message() << "iteration " << it << " level " << pickup::utils::toString(level)
+                                      << " input \"" << input << "\"");
+      ASSERT_EQ(base64::encode(raw, variant), encoded);
+      ASSERT_EQ(base64::decode(input, variant), expectedLenient);
+      size_t offset = 0;
+      ASSERT_EQ(base64::decodeStrict(input, variant, &offset), expectedStrict.first);
+      ASSERT_EQ(offset, expectedStrict.second);
+    }
+  }
+}
+
+TEST_F(CodecFuzzTest, Base64StreamingMatchesOneShot) {
+  Generator gen(2);
+  const size_t iterations = fuzzIterations();
+  for (size_t it = 0; it < iterations; ++it) {
+    const std::string raw = gen.bytes(gen.length());
+    const base64::Variant variant = kVariants[gen.next(4)];
+    const std::string input = gen.mutate(ref::base64Encode(raw, variant));
+
+    for (SimdLevel level : levels_) {
+      pickup::utils::setSimdLevelLimit(level);
+      SCOPED_TRACE(testing::Message() << "iteration " << it << " level " << pickup::utils::toString(level));
+      base64::Encoder enc(variant);
+      base64::Decoder dec(variant);
+      pickup::buffer::ByteBuffer encoded;
+      pickup::buffer::ByteBuffer decoded;
+      for (size_t pos = 0; pos < raw.size();) {
+        const size_t n = std::min<size_t>(1 + gen.next(70), raw.size() - pos);
+        enc.update(std::span(reinterpret_cast<const uint8_t*>(raw.data()) + pos, n), encoded);
+        pos += n;
+      }
+      enc.finish(encoded);
+      for (size_t pos = 0; pos < input.size();) {
+        const size_t n = std::min<size_t>(1 + gen.next(70), input.size() - pos);
+        dec.update(std::string_view(input).substr(pos, n), decoded);
+        pos += n;
+      }
+      dec.finish(decoded);
+      ASSERT_EQ(encoded.toStringView(), ref::base64Encode(raw, variant));
+      ASSERT_EQ(decoded.toStringView(), ref::base64DecodeLenient(input, variant));
+    }
+  }
+}
+
+TEST_F(CodecFuzzTest, HexMatchesReference) {
+  Generator gen(3);
+  const size_t iterations = fuzzIterations();
+  for (size_t it = 0; it < iterations; ++it) {
+    const std::string raw = gen.bytes(gen.length());
+    const std::vector<uint8_t> bytes(raw.begin(), raw.end());
+    const bool uppercase = gen.next(2) == 0;
+    const std::string encoded = hex::encode(bytes, uppercase);
+    const std::string input = gen.mutate(encoded);
+    const char separator = ":- A"[gen.next(4)];
+    const std::string separated = gen.mutate(hex::encodeWithSeparator(bytes, uppercase, separator));
+
+    for (SimdLevel level : levels_) {
+      pickup::utils::setSimdLevelLimit(level);
+      SCOPED_TRACE(testing::Message() << "iteration " << it << " level " << pickup::utils::toString(level));
+      ASSERT_EQ(hex::decode(encoded), bytes);
+      ASSERT_EQ(hex::decode(input), ref::hexDecode(input));
+      ASSERT_EQ(hex::decodeWithSeparator(separated, separator), ref::hexDecodeWithSeparator(separated, separator));
+    }
+  }
+}
+
+TEST_F(CodecFuzzTest, UrlMatchesReference) {
+  Generator gen(4);
+  const size_t iterations = fuzzIterations();
+  constexpr url::Component kComponents[] = {url::Component::Unreserved, url::Component::Path,
+                                            url::Component::Query, url::Component::Form};
+  for (size_t it = 0; it < iterations; ++it) {
+    const std::string text = gen.text(gen.length(), "abcXYZ019-._~ !$&'()*+,;=:@/?#%");
+    const url::Component component = kComponents[gen.next(4)];
+    const std::string encoded = ref::urlEncode(text, component);
+    const std::string input = gen.mutate(encoded);
+    const auto expected = ref::urlDecode(input, component);
+
+    for (SimdLevel level : levels_) {
+      pickup::utils::setSimdLevelLimit(level);
+      SCOPED_TRACE(testing::Message() << "iteration " << it << " level " << pickup::utils::toString(level));
+      ASSERT_EQ(url::encode(text, component), encoded);
+      ASSERT_EQ(url::encodedLength(text, component), encoded.size());
+      size_t offset = 0;
+      ASSERT_EQ(url::decodeStrict(input, component, &offset), expected.first);
+      ASSERT_EQ(offset, expected.second);
+      std::string inPlace = input;
+      ASSERT_EQ(url::decodeInPlace(inPlace, component), expected.first.has_value());
+      if (expected.first) {
+        ASSERT_EQ(inPlace, *expected.first);
+      }
+    }
+  }
+}
@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pickup/config/ConfigWatcher.h"
+
+using namespace pickup::config;
+using namespace std::chrono_literals;
+
+namespace {
+
+class CountingObserver : public pickup::utils::Observer {
+ public:
+  void update(const pickup::utils::Observable*, const pickup::utils::ObserverArg* arg) override {
+    const auto* change = dynamic_cast<const ConfigWatcher<>::ChangeArg*>(arg);
+    if (change && change->config) {
+      lastGeneration = change->generation;
+      lastPort = change->config->get<int>("server", "port", 0);
+    }
+    ++count;
+  }
+
+  std::atomic<int> count{0};
+  std::atomic<uint64_t> lastGeneration{0};
+  std::atomic<int> lastPort{0};
+};
+
+template <typename Pred>
+bool waitFor(Pred pred, std::chrono::milliseconds timeout = 5000ms) {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (!pred()) {
+    if (std::chrono::steady_clock::now() > deadline) return false;
+    std::this_thread::sleep_for(5ms);
+  }
+  return true;
+}
+
+}  // namespace
+
+class ConfigWatcherTest : public ::testing::Test {
+ protected:
+  std::filesystem::path dir_;
+  std::string path_;
+
+  void SetUp() override {
+    dir_ = std::filesystem::temp_directory_path() /
+           ("pickup_watch_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+    path_ = (dir_ / "app.ini").string();
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir_); }
+
+  void writeFile(const std::string& content) {
+    std::ofstream ofs(path_, std::ios::binary | std::ios::trunc);
+    ofs << content;
+  }
+
+  // 写临时文件再 rename，模拟部署工具的原子替换
+  void replaceFile(const std::string& content) {
+    const std::string tmp = path_ + ".tmp";
+    {
+      std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+      ofs << content;
+    }
+    std::filesystem::rename(tmp, path_);
+  }
+};
+
+TEST_F(ConfigWatcherTest, InitialLoad) {
+  writeFile("[server]\nport=8080\n");
+  ConfigWatcher<> watcher(path_);
+  EXPECT_FALSE(watcher.snapshot());
+  ASSERT_TRUE(watcher.start());
+  EXPECT_TRUE(watcher.watching());
+  EXPECT_EQ(watcher.generation(), 1u);
+  ASSERT_TRUE(watcher.snapshot());
+  EXPECT_EQ(watcher.snapshot()->get<int>("server", "port"), 8080);
+}
+
+TEST_F(ConfigWatcherTest, ReloadsOnWrite) {
+  writeFile("[server]\nport=1\n");
+  ConfigWatcher<> watcher(path_);
+  ASSERT_TRUE(watcher.start(10ms));
+  auto first = watcher.snapshot();
+
+  writeFile("[server]\nport=2\n");
+  ASSERT_TRUE(waitFor([&] { return watcher.generation() >= 2; }));
+  ASSERT_TRUE(waitFor([&] { return watcher.snapshot()->get<int>("server", "port") == 2; }));
+  // 旧快照保持不变
+  EXPECT_EQ(first->get<int>("server", "port"), 1);
+}
+
+TEST_F(ConfigWatcherTest, ReloadsOnRename) {
+  writeFile("[server]\nport=1\n");
+  ConfigWatcher<> watcher(path_);
+  ASSERT_TRUE(watcher.start(10ms));
+
+  replaceFile("[server]\nport=3\n");
+  ASSERT_TRUE(waitFor([&] { return watcher.snapshot()->get<int>("server", "port") == 3; }));
+}
+
+TEST_F(ConfigWatcherTest, IgnoresOtherFiles) {
+  writeFile("[server]\nport=1\n");
+  ConfigWatcher<> watcher(path_);
+  ASSERT_TRUE(watcher.start(10ms));
+
+  std::ofstream((dir_ / "other.ini").string()) << "x=1\n";
+  std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(watcher.generation(), 1u);
+}
+
+TEST_F(ConfigWatcherTest, FailedReloadKeepsSnapshot) {
+  writeFile("[server]\nport=1\n");
+  ConfigWatcher<> watcher(path_);
+  ASSERT_TRUE(watcher.start(10ms));
+
+  writeFile("[server\nport=2\n");
+  ASSERT_TRUE(waitFor([&] { return watcher.failedReloads() >= 1; }));
+  EXPECT_EQ(watcher.generation(), 1u);
+  EXPECT_EQ(watcher.snapshot()->get<int>("server", "port"), 1);
+}
+
+TEST_F(ConfigWatcherTest, MissingFileLoadsWhenCreated) {
+  ConfigWatcher<> watcher(path_);
+  EXPECT_FALSE(watcher.start(10ms));
+  EXPECT_FALSE(watcher.snapshot());
+
+  replaceFile("[server]\nport=4\n");
+  ASSERT_TRUE(waitFor([&] { return watcher.snapshot() != nullptr; }));
+  EXPECT_EQ(watcher.snapshot()->get<int>("server", "port"), 4);
+}
+
+TEST_F(ConfigWatcherTest, NotifiesObservers) {
+  writeFile("[server]\nport=1\n");
+  ConfigWatcher<> watcher(path_);
+  auto observer = std::make_shared<CountingObserver>();
+  watcher.addObserver(observer);
+  ASSERT_TRUE(watcher.start(10ms));
+  EXPECT_EQ(observer->count, 1);
+
+  writeFile("[server]\nport=5\n");
+  ASSERT_TRUE(waitFor([&] { return observer->lastPort == 5; }));
+  EXPECT_EQ(observer->lastGeneration, watcher.generation());
+}
+
+TEST_F(ConfigWatcherTest, ReaderCachesUntilGenerationChanges) {
+  writeFile("[server]\nport=1\n");
+  ConfigWatcher<> watcher(path_);
+  ConfigWatcher<>::Reader reader(watcher);
+  EXPECT_EQ(reader.get(), nullptr);
+
+  ASSERT_TRUE(watcher.reload());
+  const INIReader* first = reader.get();
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(reader.get(), first);
+  EXPECT_EQ(reader->get<int>("server", "port"), 1);
+
+  writeFile("[server]\nport=6\n");
+  ASSERT_TRUE(watcher.reload());
+  EXPECT_NE(reader.get(), first);
+  EXPECT_EQ((*reader).get<int>("server", "port"), 6);
+}
+
+TEST_F(ConfigWatcherTest, ConcurrentReadersSeeConsistentSnapshots) {
+  writeFile("[a]\nv=0\n[b]\nv=0\n");
+  ConfigWatcher<> watcher(path_);
+  ASSERT_TRUE(watcher.start(1ms));
+
+  std::atomic<bool> done{false};
+  std::atomic<int> mismatches{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 2; ++t) {
+    readers.emplace_back([&] {
+      ConfigWatcher<>::Reader reader(watcher);
+      while (!done) {
+        const INIReader* config = reader.get();
+        if (config->get<int>("a", "v") != config->get<int>("b", "v")) ++mismatches;
+      }
+    });
+  }
+  for (int i = 1; i <= 20; ++i) {
+    replaceFile("[a]\nv=" + std::to_string(i) + "\n[b]\nv=" + std::to_string(i) + "\n");
+    watcher.reload();
+  }
+  done = true;
+  for (auto& r : readers) r.join();
+  EXPECT_EQ(mismatches, 0);
+  EXPECT_EQ(watcher.snapshot()->get<int>("a", "v"), 20);
+}
+
+TEST_F(ConfigWatcherTest, CustomLoader) {
+  writeFile("ignored");
+  ConfigWatcher<std::string> watcher(path_, [](const std::string& path) {
+    return std::make_shared<const std::string>("loaded:" + std::filesystem::path(path).filename().string());
+  });
+  ASSERT_TRUE(watcher.reload());
+  EXPECT_EQ(*watcher.snapshot(), "loaded:app.ini");
+}
+
+TEST_F(ConfigWatcherTest, StopIsIdempotent) {
+  writeFile("k=v\n");
+  ConfigWatcher<> watcher(path_);
+  watcher.start();
+  watcher.stop();
+  EXPECT_FALSE(watcher.watching());
+  watcher.stop();
+  EXPECT_TRUE(watcher.snapshot());
+}
+
+TEST_F(ConfigWatcherTest, StartFailsWithoutDirectory) {
+  ConfigWatcher<> watcher((dir_ / "missing" / "app.ini").string());
+  EXPECT_FALSE(watcher.start(10ms));
+  EXPECT_FALSE(watcher.watching());
+  EXPECT_FALSE(watcher.snapshot());
+}
+
+#if defined(__linux__)
+TEST_F(ConfigWatcherTest, WatchingClearsWhenDirectoryRemoved) {
+  writeFile("[server]\nport=1\n");
+  ConfigWatcher<> watcher(path_);
+  ASSERT_TRUE(watcher.start(10ms));
+  ASSERT_TRUE(watcher.watching());
+
+  std::filesystem::remove_all(dir_);
+  EXPECT_TRUE(waitFor([&] { return !watcher.watching(); }));
+  EXPECT_EQ(watcher.snapshot()->get<int>("server", "port"), 1);
+
+  // 目录恢复后可以重新开始监视
+  std::filesystem::create_directories(dir_);
+  writeFile("[server]\nport=2\n");
+  ASSERT_TRUE(watcher.start(10ms));
+  EXPECT_TRUE(watcher.watching());
+  EXPECT_EQ(watcher.snapshot()->get<int>("server", "port"), 2);
+}
+#endif
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "pickup/time/Time.h"
+#include "pickup/time/Timezone.h"
+#include "pickup/timer/CronSchedule.h"
+#include "pickup/timer/Timer.h"
+
+using namespace pickup::timer;
+using pickup::time::Timespan;
+using pickup::time::Timestamp;
+using pickup::time::Timezone;
+using pickup::time::UtcTime;
+
+namespace {
+
+Timestamp utc(int year, int month, int day, int hour, int minute, int second = 0) {
+  return UtcTime(year, month, day, hour, minute, second).utcstamp();
+}
+
+}  // namespace
+
+TEST(CronScheduleTest, EveryMinuteAlignsToZeroSecond) {
+  auto s = CronSchedule::parse("0 * * * * *", Timezone::utc());
+  auto next = s.next(utc(2024, 1, 15, 10, 30, 17));
+  ASSERT_TRUE(next.has_value());
+  EXPECT_EQ(*next, utc(2024, 1, 15, 10, 31, 0));
+  // 严格晚于参考时刻
+  EXPECT_EQ(*s.next(utc(2024, 1, 15, 10, 31, 0)), utc(2024, 1, 15, 10, 32, 0));
+}
+
+TEST(CronScheduleTest, DailyInFixedTimezone) {
+  Timezone cst("CST", Timespan::hours(8));
+  auto s = CronSchedule::parse("30 2 * * *", cst);
+  // 02:30 +08:00 == 18:30Z 前一天
+  EXPECT_EQ(*s.next(utc(2024, 1, 15, 0, 0)), utc(2024, 1, 15, 18, 30));
+  EXPECT_EQ(*s.next(utc(2024, 1, 15, 18, 30)), utc(2024, 1, 16, 18, 30));
+}
+
+TEST(CronScheduleTest, RangesStepsAndLists) {
+  auto s = CronSchedule::parse("*/15 9-17 * * MON-FRI", Timezone::utc());
+  // 2024-01-13 为周六，下一个命中为周一 09:00
+  EXPECT_EQ(*s.next(utc(2024, 1, 13, 12, 0)), utc(2024, 1, 15, 9, 0));
+  EXPECT_EQ(*s.next(utc(2024, 1, 15, 9, 0)), utc(2024, 1, 15, 9, 15));
+  EXPECT_EQ(*s.next(utc(2024, 1, 15, 17, 45)), utc(2024, 1, 16, 9, 0));
+
+  auto list = CronSchedule::parse("0 0 1,15 * *", Timezone::utc());
+  EXPECT_EQ(*list.next(utc(2024, 1, 2, 0, 0)), utc(2024, 1, 15, 0, 0));
+  EXPECT_EQ(*list.next(utc(2024, 1, 15, 0, 0)), utc(2024, 2, 1, 0, 0));
+}
+
+TEST(CronScheduleTest, DayOfMonthOrWeekday) {
+  // 日与周均受限时取“或”：每月 13 日或每个周五
+  auto s = CronSchedule::parse("0 0 13 * 5", Timezone::utc());
+  EXPECT_EQ(*s.next(utc(2024, 1, 1, 0, 0)), utc(2024, 1, 5, 0, 0));
+  EXPECT_EQ(*s.next(utc(2024, 1, 12, 0, 0)), utc(2024, 1, 13, 0, 0));
+}
+
+TEST(CronScheduleTest, LeapDayAndMacros) {
+  auto leap = CronSchedule::parse("0 0 29 2 *", Timezone::utc());
+  EXPECT_EQ(*leap.next(utc(2024, 3, 1, 0, 0)), utc(2028, 2, 29, 0, 0));
+
+  auto yearly = CronSchedule::parse("@yearly", Timezone::utc());
+  EXPECT_EQ(*yearly.next(utc(2024, 6, 1, 0, 0)), utc(2025, 1, 1, 0, 0));
+
+  auto sunday = CronSchedule::parse("0 0 * * 7", Timezone::utc());
+  EXPECT_EQ(*sunday.next(utc(2024, 1, 15, 0, 0)), utc(2024, 1, 21, 0, 0));
+}
+
+TEST(CronScheduleTest, ImpossibleScheduleHasNoNext) {
+  auto s = CronSchedule::parse("0 0 30 2 *", Timezone::utc());
+  EXPECT_FALSE(s.next(utc(2024, 1, 1, 0, 0)).has_value());
+}
+
+TEST(CronScheduleTest, InvalidExpressionThrows) {
+  EXPECT_THROW(CronSchedule::parse("* * * *"), std::invalid_argument);
+  EXPECT_THROW(CronSchedule::parse("60 * * * *"), std::invalid_argument);
+  EXPECT_THROW(CronSchedule::parse("5-1 * * * *"), std::invalid_argument);
+  EXPECT_THROW(CronSchedule::parse("0 0 * FOO *"), std::invalid_argument);
+  EXPECT_THROW(CronSchedule::parse("@never"), std::invalid_argument);
+}
+
+TEST(CronScheduleTest, LocalDailyMatchesLocalFields) {
+  auto s = CronSchedule::daily(2, 30);
+  auto next = s.next(Timestamp(Timestamp::utc()));
+  ASSERT_TRUE(next.has_value());
+  pickup::time::LocalTime local(*next);
+  EXPECT_EQ(local.hour(), 2);
+  EXPECT_EQ(local.minute(), 30);
+  EXPECT_EQ(local.second(), 0);
+}
+
+TEST(CronScheduleTest, TimerScheduleAtFiresEverySecond) {
+  Timer timer;
+  std::atomic<int> counter{0};
+  auto task = timer.scheduleAt([&] { counter.fetch_add(1); }, CronSchedule::parse("* * * * * *"));
+  EXPECT_TRUE(timer.isScheduled(task));
+  std::this_thread::sleep_for(std::chrono::milliseconds(2100));
+  EXPECT_GE(counter.load(), 2);
+  EXPECT_TRUE(timer.cancel(task));
+  EXPECT_FALSE(timer.isScheduled(task));
+}
+
+TEST(CronScheduleTest, TimerScheduleAtRejectsImpossible) {
+  Timer timer;
+  EXPECT_THROW(timer.scheduleAt([] {}, CronSchedule::parse("0 0 30 2 *")), std::invalid_argument);
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pickup/config/INIParser.h"
+
+using namespace pickup::config;
+
+namespace {
+
+// 把事件记录成字符串，便于整体比较
+class Recorder : public INIParser::Handler {
+ public:
+  bool onSection(std::string_view section, int line) override {
+    events.push_back(std::to_string(line) + " [" + std::string(section) + "]");
+    return true;
+  }
+
+  bool onValue(std::string_view section, std::string_view name, std::string_view value, int line) override {
+    events.push_back(std::to_string(line) + " " + std::string(section) + "." + std::string(name) + "=" +
+                     std::string(value));
+    return stopAfter == 0 || events.size() < stopAfter;
+  }
+
+  bool onContinuation(std::string_view section, std::string_view name, std::string_view value,
+                      int line) override {
+    events.push_back(std::to_string(line) + " " + std::string(section) + "." + std::string(name) + "+" +
+                     std::string(value));
+    return true;
+  }
+
+  bool onError(int line) override {
+    events.push_back(std::to_string(line) + " error");
+    return continueOnError;
+  }
+
+  std::vector<std::string> events;
+  size_t stopAfter = 0;
+  bool continueOnError = true;
+};
+
+}  // namespace
+
+TEST(INIParserTest, EmitsEventsInOrder) {
+  Recorder recorder;
+  const auto error = INIParser::parse(
+      "\xEF\xBB\xBFglobal = 1\r\n; comment\n[db]\nhost=localhost ; inline\nlist = a\n  b\n\n  c\n[Cache]\nttl:60",
+      recorder);
+  EXPECT_FALSE(error.has_value());
+  const std::vector<std::string> expected = {
+      "1 .global=1", "3 [db]", "4 db.host=localhost", "5 db.list=a", "6 db.list+b",
+      "8 db.list+c", "9 [Cache]", "10 Cache.ttl=60",
+  };
+  EXPECT_EQ(recorder.events, expected);
+}
+
+TEST(INIParserTest, ValuesPointIntoInput) {
+  const std::string text = "[s]\nkey = value\n";
+  std::string_view captured;
+  INIParser::parse(text, [&](std::string_view, std::string_view, std::string_view value) {
+    captured = value;
+    return true;
+  });
+  EXPECT_EQ(captured, "value");
+  EXPECT_GE(captured.data(), text.data());
+  EXPECT_LE(captured.data() + captured.size(), text.data() + text.size());
+}
+
+TEST(INIParserTest, ReportsFirstErrorAndContinues) {
+  Recorder recorder;
+  const auto error = INIParser::parse("a=1\n[broken\nnoseparator\nb=2\n", recorder);
+  ASSERT_TRUE(error.has_value());
+  EXPECT_EQ(error->kind, INIParser::ParseError::Kind::Syntax);
+  EXPECT_EQ(error->line, 2);
+  const std::vector<std::string> expected = {"1 .a=1", "2 error", "3 error", "4 .b=2"};
+  EXPECT_EQ(recorder.events, expected);
+}
+
+TEST(INIParserTest, HandlerCanStop) {
+  Recorder recorder;
+  recorder.stopAfter = 2;
+  INIParser::parse("a=1\nb=2\nc=3\n", recorder);
+  EXPECT_EQ(recorder.events.size(), 2u);
+
+  Recorder onError;
+  onError.continueOnError = false;
+  const auto error = INIParser::parse("a=1\n???\nc=3\n", onError);
+  ASSERT_TRUE(error.has_value());
+  EXPECT_EQ(error->line, 2);
+  EXPECT_EQ(onError.events.size(), 2u);
+}
+
+TEST(INIParserTest, DuplicateKeysAreReportedEachTime) {
+  std::vector<std::string> values;
+  INIParser::parse("k=1\nk=2\n", [&](std::string_view, std::string_view, std::string_view value) {
+    values.emplace_back(value);
+    return true;
+  });
+  EXPECT_EQ(values, (std::vector<std::string>{"1", "2"}));
+}
+
+TEST(INIParserTest, ParseFile) {
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "pickup_ini_parser_test.ini").string();
+  {
+    std::ofstream ofs(path, std::ios::binary);
+    ofs << "[routes]\n";
+    for (int i = 0; i < 1000; ++i) ofs << "r" << i << " = 10.0." << i / 256 << "." << i % 256 << "\n";
+  }
+  struct Counter : INIParser::Handler {
+    size_t routes = 0;
+    bool onValue(std::string_view section, std::string_view, std::string_view, int) override {
+      routes += section == "routes";
+      return true;
+    }
+  } counter;
+  EXPECT_FALSE(INIParser::parseFile(path, counter).has_value());
+  EXPECT_EQ(counter.routes, 1000u);
+  std::remove(path.c_str());
+
+  const auto error = INIParser::parseFile("/nonexistent/file.ini", counter);
+  ASSERT_TRUE(error.has_value());
+  EXPECT_EQ(error->kind, INIParser::ParseError::Kind::FileOpen);
+}
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include "pickup/config/INIReader.h"
 
@@ -280,3 +285,173 @@ TEST(INIReaderTest, GetBooleanCaseInsensitive) {
   EXPECT_TRUE(reader.getBoolean("", "b", false));
   EXPECT_TRUE(reader.getBoolean("", "c", false));
 }
+
+TEST(INIReaderTest, FindReturnsViewIntoText) {
+  std::istringstream ss("[Server]\nHost = example.com\nPort=8080\n");
+  INIReader reader(ss);
+  std::string_view section = "SERVER";
+  auto host = reader.find(section, std::string_view("host"));
+  ASSERT_TRUE(host.has_value());
+  EXPECT_EQ(*host, "example.com");
+  EXPECT_FALSE(reader.find("server", "missing").has_value());
+  EXPECT_FALSE(reader.find("other", "host").has_value());
+  EXPECT_EQ(reader.getView("server", "port", "0"), "8080");
+  EXPECT_EQ(reader.getView("server", "user", "nobody"), "nobody");
+}
+
+TEST(INIReaderTest, ViewsSurviveCopyAndMove) {
+  std::string_view value;
+  INIReader copy;
+  {
+    std::istringstream ss("k=v\nmulti=a\n  b\n");
+    INIReader reader(ss);
+    value = reader.getView("", "k", "");
+    copy = reader;
+    INIReader moved(std::move(reader));
+    EXPECT_EQ(moved.getView("", "multi", ""), "a\nb");
+  }
+  EXPECT_EQ(value, "v");
+  EXPECT_EQ(copy.getView("", "multi", ""), "a\nb");
+}
+
+TEST(INIReaderTest, SectionsMergeCaseInsensitively) {
+  std::istringstream ss("[Net]\na=1\n[NET]\nb=2\nA=3\n");
+  INIReader reader(ss);
+  EXPECT_EQ(reader.get("net", "a", ""), "1\n3");
+  EXPECT_EQ(reader.get("net", "B", ""), "2");
+  EXPECT_TRUE(reader.hasSection("Net"));
+  EXPECT_TRUE(reader.hasSection("NET"));
+}
+
+TEST(INIReaderTest, DefaultConstructedHasNoValues) {
+  INIReader reader;
+  EXPECT_FALSE(reader.hasValue("", "key"));
+  EXPECT_EQ(reader.get("", "key", "d"), "d");
+  EXPECT_FALSE(reader.find("", "key").has_value());
+}
+
+TEST(INIReaderTest, IntegerLenientForms) {
+  std::istringstream ss("a=+17\nb=010\nc=12abc\nd=0x\ne=99999999999999999999\nf=-0x10\n");
+  INIReader reader(ss);
+  EXPECT_EQ(reader.getInteger("", "a", 0), 17);
+  EXPECT_EQ(reader.getInteger("", "b", 0), 8);
+  EXPECT_EQ(reader.getInteger("", "c", 0), 12);
+  EXPECT_EQ(reader.getInteger("", "d", 5), 0);
+  EXPECT_EQ(reader.getInteger("", "e", 5), 5);
+  EXPECT_EQ(reader.getInteger("", "f", 0), -16);
+}
+
+TEST(INIReaderTest, RealLenientForms) {
+  std::istringstream ss("a=+2.5\nb=1e3x\nc=0x1p4\nd=--1\n");
+  INIReader reader(ss);
+  EXPECT_DOUBLE_EQ(reader.getReal("", "a", 0.0), 2.5);
+  EXPECT_DOUBLE_EQ(reader.getReal("", "b", 0.0), 1000.0);
+  EXPECT_DOUBLE_EQ(reader.getReal("", "c", 0.0), 16.0);
+  EXPECT_DOUBLE_EQ(reader.getReal("", "d", 7.0), 7.0);
+  EXPECT_FLOAT_EQ(reader.getFloat("", "a", 0.0f), 2.5f);
+}
+
+TEST(INIReaderTest, TypedGet) {
+  std::istringstream ss(
+      "[svc]\nport=8080\nratio=0.75\nenabled=on\nname=edge\nbig=300\nhex=0x10\nneg=-5\n");
+  INIReader reader(ss);
+  EXPECT_EQ(reader.get<int>("svc", "port"), 8080);
+  EXPECT_EQ(reader.get<uint16_t>("svc", "port", 0), 8080);
+  EXPECT_DOUBLE_EQ(*reader.get<double>("svc", "ratio"), 0.75);
+  EXPECT_FLOAT_EQ(*reader.get<float>("svc", "ratio"), 0.75f);
+  EXPECT_EQ(reader.get<bool>("svc", "enabled"), true);
+  EXPECT_EQ(reader.get<std::string>("svc", "name"), "edge");
+  EXPECT_EQ(reader.get<std::string_view>("svc", "name"), "edge");
+
+  // 整串匹配、范围检查
+  EXPECT_FALSE(reader.get<uint8_t>("svc", "big").has_value());
+  EXPECT_FALSE(reader.get<int>("svc", "hex").has_value());
+  EXPECT_FALSE(reader.get<unsigned>("svc", "neg").has_value());
+  EXPECT_FALSE(reader.get<int>("svc", "name").has_value());
+  EXPECT_FALSE(reader.get<int>("svc", "missing").has_value());
+  EXPECT_EQ(reader.get<int>("svc", "missing", 42), 42);
+  EXPECT_EQ(reader.get<uint64_t>("svc", "port"), 8080u);
+}
+
+TEST(INIReaderTest, TypedGetUnsigned64BeyondInt64) {
+  std::istringstream ss("v=18446744073709551615\n");
+  INIReader reader(ss);
+  EXPECT_EQ(reader.get<uint64_t>("", "v"), UINT64_MAX);
+  EXPECT_FALSE(reader.get<int64_t>("", "v").has_value());
+}
+
+TEST(INIReaderTest, MixedTypedReadsOfSameKey) {
+  std::istringstream ss("v=12abc\nn=1\nbad=x\n");
+  INIReader reader(ss);
+  // 第一次读取的类型被缓存，其余类型照常解析，且重复读取结果一致
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(reader.getInteger("", "v", 0), 12);
+    EXPECT_FALSE(reader.get<int>("", "v").has_value());
+    EXPECT_DOUBLE_EQ(reader.getReal("", "v", 0.0), 12.0);
+    EXPECT_EQ(reader.get<bool>("", "n"), true);
+    EXPECT_EQ(reader.get<int>("", "n"), 1);
+    EXPECT_FLOAT_EQ(*reader.get<float>("", "n"), 1.0f);
+    EXPECT_FALSE(reader.get<double>("", "bad").has_value());
+    EXPECT_EQ(reader.getInteger("", "bad", 7), 7);
+  }
+}
+
+TEST(INIReaderTest, ConcurrentTypedReads) {
+  std::string text;
+  for (int i = 0; i < 256; ++i) text += "k" + std::to_string(i) + "=" + std::to_string(i) + "\n";
+  std::istringstream ss(text);
+  const INIReader reader(ss);
+  std::vector<std::thread> threads;
+  std::atomic<int> mismatches{0};
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&reader, &mismatches, t] {
+      for (int i = 0; i < 256; ++i) {
+        const std::string key = "k" + std::to_string(i);
+        const bool ok = t % 2 == 0 ? reader.get<int>("", key) == i : reader.getReal("", key, -1.0) == i;
+        if (!ok) ++mismatches;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(mismatches.load(), 0);
+}
+
+TEST(INIReaderTest, Durations) {
+  using pickup::time::Timespan;
+  std::istringstream ss(
+      "a=100ms\nb=1.5s\nc=1h30m\nd=250 us\ne=0\nf=-2m\ng=10\nh=5 parsecs\ni=2d 3h\n");
+  INIReader reader(ss);
+  EXPECT_EQ(reader.get<Timespan>("", "a"), Timespan::milliseconds(100));
+  EXPECT_EQ(reader.get<Timespan>("", "b"), Timespan::milliseconds(1500));
+  EXPECT_EQ(reader.get<Timespan>("", "c"), Timespan::minutes(90));
+  EXPECT_EQ(reader.get<Timespan>("", "d"), Timespan::microseconds(250));
+  EXPECT_EQ(reader.get<Timespan>("", "e"), Timespan::zero());
+  EXPECT_EQ(reader.get<Timespan>("", "f"), Timespan::minutes(-2));
+  EXPECT_FALSE(reader.get<Timespan>("", "g").has_value());
+  EXPECT_FALSE(reader.get<Timespan>("", "h").has_value());
+  EXPECT_EQ(reader.get<Timespan>("", "i"), Timespan::hours(51));
+  EXPECT_EQ(reader.get<Timespan>("", "missing", Timespan::seconds(3)), Timespan::seconds(3));
+  EXPECT_FALSE(INIReader::parseDuration("9999999999d").has_value());
+  // 整数部分乘以单位不溢出，加上小数部分才溢出
+  EXPECT_FALSE(INIReader::parseDuration("9223372036.9s").has_value());
+  EXPECT_EQ(INIReader::parseDuration("9223372036.8s"), Timespan(9223372036800000000LL));
+  EXPECT_FALSE(INIReader::parseDuration("1.s").has_value());
+}
+
+TEST(INIReaderTest, Lists) {
+  using pickup::time::Timespan;
+  std::istringstream ss(
+      "hosts = a.example, b.example ,,c.example\nports=80,443\nbad=1,x\n"
+      "delays=10ms,1s\nmulti=1\n  2, 3\nempty=\n");
+  INIReader reader(ss);
+  auto hosts = reader.getList<std::string_view>("", "hosts");
+  ASSERT_TRUE(hosts.has_value());
+  EXPECT_EQ(*hosts, (std::vector<std::string_view>{"a.example", "b.example", "c.example"}));
+  EXPECT_EQ(reader.getList<int>("", "ports"), (std::vector<int>{80, 443}));
+  EXPECT_FALSE(reader.getList<int>("", "bad").has_value());
+  EXPECT_EQ(reader.getList<Timespan>("", "delays"),
+            (std::vector<Timespan>{Timespan::milliseconds(10), Timespan::seconds(1)}));
+  EXPECT_EQ(reader.getList<int>("", "multi"), (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(reader.getList<int>("", "empty"), std::vector<int>{});
+  EXPECT_FALSE(reader.getList<int>("", "missing").has_value());
+}
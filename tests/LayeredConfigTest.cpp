@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pickup/config/LayeredConfig.h"
+
+using namespace pickup::config;
+using pickup::time::Timespan;
+
+namespace {
+
+INIReader readerOf(const std::string& text) {
+  std::istringstream ss(text);
+  return INIReader(ss);
+}
+
+}  // namespace
+
+TEST(LayeredConfigTest, LaterLayersWin) {
+  LayeredConfig config;
+  config.addReader("defaults", readerOf("[server]\nport=80\nhost=localhost\n[log]\nlevel=info\n"));
+  config.addReader("host", readerOf("[Server]\nPort=8080\n"));
+  config.addOverrides("cli", {"log.level=debug", "novalue", "top=1"});
+  EXPECT_TRUE(config.build());
+
+  EXPECT_EQ(config.layerCount(), 3u);
+  EXPECT_EQ(config.size(), 4u);
+  EXPECT_EQ(config.find("server", "port"), "8080");
+  EXPECT_EQ(config.sourceOf("SERVER", "port"), "host");
+  EXPECT_EQ(config.find("server", "host"), "localhost");
+  EXPECT_EQ(config.sourceOf("server", "host"), "defaults");
+  EXPECT_EQ(config.find("log", "level"), "debug");
+  EXPECT_EQ(config.sourceOf("log", "level"), "cli");
+  EXPECT_EQ(config.find("", "top"), "1");
+  EXPECT_FALSE(config.find("server", "missing").has_value());
+  EXPECT_FALSE(config.sourceOf("server", "missing").has_value());
+}
+
+TEST(LayeredConfigTest, TypedKeys) {
+  LayeredConfig config;
+  config.addReader("file", readerOf("[svc]\nport=9000\nratio=0.5\nenabled=yes\nname=edge\ntimeout=250ms\n"));
+  auto port = config.registerKey<int>("svc", "port", 80);
+  auto ratio = config.registerKey<float>("svc", "ratio", 1.0f);
+  auto enabled = config.registerKey<bool>("svc", "enabled", false);
+  auto name = config.registerKey<std::string_view>("svc", "name", "none");
+  auto timeout = config.registerKey<Timespan>("svc", "timeout", Timespan::seconds(1));
+  auto retries = config.registerKey<unsigned>("svc", "retries", 3u);
+
+  // build() 之前得到默认值
+  EXPECT_EQ(config.get(port), 80);
+  EXPECT_EQ(config.get(name), "none");
+  EXPECT_FALSE(config.sourceOf(port).has_value());
+
+  ASSERT_TRUE(config.build());
+  EXPECT_EQ(config.get(port), 9000);
+  EXPECT_FLOAT_EQ(config.get(ratio), 0.5f);
+  EXPECT_TRUE(config.get(enabled));
+  EXPECT_EQ(config.get(name), "edge");
+  EXPECT_EQ(config.get(timeout), Timespan::milliseconds(250));
+  EXPECT_EQ(config.get(retries), 3u);
+  EXPECT_EQ(config.sourceOf(port), "file");
+  EXPECT_FALSE(config.sourceOf(retries).has_value());
+  EXPECT_NE(port.slot(), ratio.slot());
+}
+
+TEST(LayeredConfigTest, InvalidValuesFallBackToDefault) {
+  LayeredConfig config;
+  config.addReader("file", readerOf("[svc]\nport=http\nsmall=300\ndelay=soon\n"));
+  auto port = config.registerKey<int>("svc", "port", 80);
+  auto small = config.registerKey<uint8_t>("svc", "small", 7);
+  auto delay = config.registerKey<Timespan>("svc", "delay", Timespan::seconds(2));
+  EXPECT_FALSE(config.build());
+  EXPECT_EQ(config.get(port), 80);
+  EXPECT_EQ(config.get(small), 7);
+  EXPECT_EQ(config.get(delay), Timespan::seconds(2));
+  EXPECT_FALSE(config.sourceOf(port).has_value());
+  EXPECT_EQ(config.invalidKeys(), (std::vector<std::string>{"svc.port", "svc.small", "svc.delay"}));
+}
+
+TEST(LayeredConfigTest, RegisterAfterBuild) {
+  LayeredConfig config;
+  config.addReader("file", readerOf("[a]\nb=42\n"));
+  config.build();
+  auto key = config.registerKey<long>("A", "B", 0);
+  EXPECT_EQ(config.get(key), 42);
+  EXPECT_EQ(config.sourceOf(key), "file");
+}
+
+TEST(LayeredConfigTest, EnvironmentLayer) {
+  ::setenv("PICKUP_TEST_SERVER_PORT", "7070", 1);
+  ::setenv("PICKUP_TEST_DB_POOL_SIZE", "16", 1);
+  ::setenv("PICKUP_TEST_GLOBAL", "env", 1);
+  ::setenv("PICKUP_TEST_UNKNOWN_KEY", "ignored", 1);
+
+  LayeredConfig config;
+  config.addReader("defaults", readerOf("global=file\n[server]\nport=80\n"));
+  config.addEnvironment("env", "PICKUP_TEST_");
+  config.addOverrides("cli", std::vector<LayeredConfig::Override>{{"server", "port", "9090"}});
+  auto pool = config.registerKey<int>("db", "pool-size", 4);
+  ASSERT_TRUE(config.build());
+
+  EXPECT_EQ(config.find("", "global"), "env");
+  EXPECT_EQ(config.sourceOf("", "global"), "env");
+  EXPECT_EQ(config.find("server", "port"), "9090");
+  EXPECT_EQ(config.sourceOf("server", "port"), "cli");
+  EXPECT_EQ(config.get(pool), 16);
+  EXPECT_EQ(config.sourceOf(pool), "env");
+  EXPECT_FALSE(config.find("unknown", "key").has_value());
+
+  ::unsetenv("PICKUP_TEST_SERVER_PORT");
+  ::unsetenv("PICKUP_TEST_DB_POOL_SIZE");
+  ::unsetenv("PICKUP_TEST_GLOBAL");
+  ::unsetenv("PICKUP_TEST_UNKNOWN_KEY");
+}
+
+TEST(LayeredConfigTest, AddFileMissing) {
+  LayeredConfig config;
+  auto error = config.addFile("host", "/nonexistent/host.ini");
+  ASSERT_TRUE(error.has_value());
+  EXPECT_EQ(error->kind, INIReader::ParseError::Kind::FileOpen);
+  EXPECT_EQ(config.layerCount(), 0u);
+}
+
+TEST(LayeredConfigTest, ForEachReportsSources) {
+  LayeredConfig config;
+  config.addReader("a", readerOf("x=1\ny=1\n"));
+  config.addReader("b", readerOf("y=2\n"));
+  config.build();
+  std::map<std::string, std::string> seen;
+  config.forEach([&](std::string_view, std::string_view name, std::string_view value, std::string_view layer) {
+    seen[std::string(name)] = std::string(value) + "@" + std::string(layer);
+  });
+  EXPECT_EQ(seen, (std::map<std::string, std::string>{{"x", "1@a"}, {"y", "2@b"}}));
+}
+
+TEST(LayeredConfigTest, RebuildAfterAddingLayer) {
+  LayeredConfig config;
+  config.addReader("a", readerOf("k=1\n"));
+  auto key = config.registerKey<int>("", "k", 0);
+  config.build();
+  EXPECT_EQ(config.get(key), 1);
+  config.addOverrides("cli", {"k=2"});
+  config.build();
+  EXPECT_EQ(config.get(key), 2);
+  EXPECT_EQ(config.sourceOf(key), "cli");
+}
+
+TEST(LayeredConfigTest, FloatOutOfRangeFallsBackToDefault) {
+  LayeredConfig config;
+  config.addReader("file", readerOf("big=1e300\nsmall=-1e39\nok=3.0e38\ninf=inf\n"));
+  auto big = config.registerKey<float>("", "big", 1.0f);
+  auto small = config.registerKey<float>("", "small", 2.0f);
+  auto ok = config.registerKey<float>("", "ok", 0.0f);
+  auto inf = config.registerKey<float>("", "inf", 0.0f);
+  auto wide = config.registerKey<double>("", "big", 0.0);
+  EXPECT_FALSE(config.build());
+  EXPECT_EQ(config.get(big), 1.0f);
+  EXPECT_EQ(config.get(small), 2.0f);
+  EXPECT_FALSE(config.sourceOf(big).has_value());
+  EXPECT_FLOAT_EQ(config.get(ok), 3.0e38f);
+  EXPECT_TRUE(std::isinf(config.get(inf)));
+  EXPECT_DOUBLE_EQ(config.get(wide), 1e300);
+  EXPECT_EQ(config.invalidKeys(), (std::vector<std::string>{".big", ".small"}));
+}
+
+TEST(LayeredConfigTest, RebuildReinternsStrings) {
+  LayeredConfig config;
+  config.addReader("a", readerOf("[svc]\nname=edge\n"));
+  auto name = config.registerKey<std::string_view>("svc", "name", "none");
+  auto missing = config.registerKey<std::string_view>("svc", "missing", "fallback");
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(config.build());
+    EXPECT_EQ(config.get(name), "edge");
+    EXPECT_EQ(config.get(missing), "fallback");
+    EXPECT_EQ(config.find("SVC", "Name"), "edge");
+  }
+  config.addOverrides("cli", {"svc.name=core"});
+  ASSERT_TRUE(config.build());
+  EXPECT_EQ(config.get(name), "core");
+  EXPECT_EQ(config.get(missing), "fallback");
+}
@@ -124,3 +124,27 @@ TEST(LexicalCastTest, SameType) {
   ASSERT_TRUE(r.has_value());
   EXPECT_EQ(*r, 100);
 }
+
+TEST(LexicalCastTest, FloatingDoesNotReadPastView) {
+  const std::string text = "1.5e3";
+  auto r = lexicalCast<double>(std::string_view(text).substr(0, 3));
+  ASSERT_TRUE(r.has_value());
+  EXPECT_DOUBLE_EQ(*r, 1.5);
+  EXPECT_FALSE(lexicalCast<double>(std::string_view("1.5x")).has_value());
+}
+
+TEST(LexicalCastTest, FloatingSignAndRejectedForms) {
+  auto plus = lexicalCast<double>(std::string_view("+1.5"));
+  ASSERT_TRUE(plus.has_value());
+  EXPECT_DOUBLE_EQ(*plus, 1.5);
+  auto minus = lexicalCast<float>(std::string_view("-2.5"));
+  ASSERT_TRUE(minus.has_value());
+  EXPECT_FLOAT_EQ(*minus, -2.5f);
+
+  // 与 strtod 不同：不接受前导空白与十六进制浮点，符号也只能有一个
+  EXPECT_FALSE(lexicalCast<double>(std::string_view(" 1.5")).has_value());
+  EXPECT_FALSE(lexicalCast<double>(std::string_view("0x1p3")).has_value());
+  EXPECT_FALSE(lexicalCast<double>(std::string_view("+-1.5")).has_value());
+  EXPECT_FALSE(lexicalCast<double>(std::string_view("++1.5")).has_value());
+  EXPECT_FALSE(lexicalCast<double>(std::string_view("+")).has_value());
+}
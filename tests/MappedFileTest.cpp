@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "pickup/buffer/BinaryReader.h"
+#include "pickup/buffer/MappedFile.h"
+
+using namespace pickup::buffer;
+
+class MappedFileTest : public ::testing::Test {
+ protected:
+  std::string path_;
+
+  void SetUp() override {
+    path_ = (std::filesystem::temp_directory_path() /
+             ("pickup_mapped_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name())))
+                .string();
+    std::remove(path_.c_str());
+  }
+
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  void writeFile(const std::string& content) {
+    std::ofstream ofs(path_, std::ios::binary);
+    ofs << content;
+  }
+
+  std::string readFile() {
+    std::ifstream ifs(path_, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  }
+};
+
+TEST_F(MappedFileTest, OpenMissingFails) {
+  MappedFile file;
+  EXPECT_FALSE(file.openRead(path_));
+  EXPECT_FALSE(file.isOpen());
+}
+
+TEST_F(MappedFileTest, ReadOnlyView) {
+  writeFile("hello mapped world");
+  MappedFile file;
+  ASSERT_TRUE(file.openRead(path_));
+  EXPECT_TRUE(file.isOpen());
+  EXPECT_FALSE(file.writable());
+  EXPECT_EQ(file.view(), "hello mapped world");
+  EXPECT_EQ(file.bytes().size(), 18);
+  EXPECT_EQ(file.toByteBuffer().toStringView(), "hello mapped world");
+  EXPECT_TRUE(file.advise(MappedFile::Advice::Sequential));
+  EXPECT_TRUE(file.advise(MappedFile::Advice::WillNeed, 6, 6));
+  EXPECT_FALSE(file.append("x"));
+
+  BinaryReader reader(file.view());
+  std::string_view word;
+  EXPECT_TRUE(reader.readRaw(word, 5));
+  EXPECT_EQ(word, "hello");
+}
+
+TEST_F(MappedFileTest, EmptyFile) {
+  writeFile("");
+  MappedFile file;
+  ASSERT_TRUE(file.openRead(path_));
+  EXPECT_TRUE(file.empty());
+  EXPECT_EQ(file.data(), nullptr);
+  EXPECT_FALSE(file.advise(MappedFile::Advice::Sequential));
+}
+
+TEST_F(MappedFileTest, MoveTransfersMapping) {
+  writeFile("abc");
+  MappedFile a;
+  ASSERT_TRUE(a.openRead(path_));
+  MappedFile b(std::move(a));
+  EXPECT_FALSE(a.isOpen());
+  EXPECT_EQ(b.view(), "abc");
+  MappedFile c;
+  c = std::move(b);
+  EXPECT_EQ(c.view(), "abc");
+}
+
+TEST_F(MappedFileTest, AppendGrowsAndTruncatesOnClose) {
+  {
+    MappedFile file;
+    ASSERT_TRUE(file.openAppend(path_, 16));
+    EXPECT_TRUE(file.writable());
+    const size_t initial = file.capacity();
+    std::string line(100, 'a');
+    for (int i = 0; i < 100; ++i) {
+      ASSERT_TRUE(file.append(line));
+    }
+    EXPECT_EQ(file.size(), 10000);
+    EXPECT_GE(file.capacity(), 10000);
+    EXPECT_GE(file.capacity(), initial);
+    EXPECT_TRUE(file.sync());
+  }
+  EXPECT_EQ(std::filesystem::file_size(path_), 10000);
+}
+
+TEST_F(MappedFileTest, AppendToExistingFile) {
+  writeFile("head|");
+  {
+    MappedFile file;
+    ASSERT_TRUE(file.openAppend(path_));
+    EXPECT_EQ(file.view(), "head|");
+    ASSERT_TRUE(file.append("tail"));
+    EXPECT_EQ(file.view(), "head|tail");
+  }
+  EXPECT_EQ(readFile(), "head|tail");
+}
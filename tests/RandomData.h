@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace pickup {
+namespace test {
+
+// 测试与基准共用的确定性伪随机数据（LCG），同一 seed 在各平台上生成相同内容
+
+/** @brief 生成 len 个伪随机字节，Container 为 std::string 或 std::vector<uint8_t> 等字节容器 */
+template <typename Container = std::string>
+Container randomBytes(size_t len, uint32_t seed) {
+  Container out(len, typename Container::value_type{});
+  for (auto& c : out) {
+    seed = seed * 1664525u + 1013904223u;
+    c = static_cast<typename Container::value_type>(seed >> 24);
+  }
+  return out;
+}
+
+/** @brief 由 alphabet 中字符组成的伪随机文本，字母表小时子串与分隔符会频繁落在各个块边界上 */
+inline std::string randomText(size_t len, uint32_t seed, std::string_view alphabet) {
+  std::string s(len, '\0');
+  for (auto& c : s) {
+    seed = seed * 1664525u + 1013904223u;
+    c = alphabet[(seed >> 16) % alphabet.size()];
+  }
+  return s;
+}
+
+}  // namespace test
+}  // namespace pickup
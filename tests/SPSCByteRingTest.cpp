@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "pickup/buffer/SPSCByteRing.h"
+
+using namespace pickup::buffer;
+
+TEST(SPSCByteRingTest, CapacityRoundsToPowerOfTwo) {
+  SPSCByteRing ring(100);
+  EXPECT_EQ(ring.capacity(), 128);
+  EXPECT_EQ(ring.available(), 128);
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(SPSCByteRingTest, WriteAndReadFullCapacity) {
+  SPSCByteRing ring(8);
+  const uint8_t data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+  EXPECT_TRUE(ring.write(data, 8));
+  EXPECT_EQ(ring.used(), 8);
+  EXPECT_FALSE(ring.write(data, 1));
+
+  uint8_t out[8] = {};
+  EXPECT_EQ(ring.read(out, sizeof(out)), 8);
+  EXPECT_EQ(out[7], 8);
+  EXPECT_EQ(ring.read(out, sizeof(out)), 0);
+}
+
+TEST(SPSCByteRingTest, RejectsNullAndEmpty) {
+  SPSCByteRing ring(8);
+  const uint8_t data[1] = {1};
+  EXPECT_FALSE(ring.write(nullptr, 1));
+  EXPECT_FALSE(ring.write(data, 0));
+  EXPECT_EQ(ring.read(nullptr, 1), 0);
+}
+
+TEST(SPSCByteRingTest, PeekReturnsTwoSpansWhenWrapped) {
+  SPSCByteRing ring(8);
+  const uint8_t first[6] = {0, 1, 2, 3, 4, 5};
+  ASSERT_TRUE(ring.write(first, 6));
+  ring.consume(5);
+  const uint8_t second[5] = {6, 7, 8, 9, 10};
+  ASSERT_TRUE(ring.write(second, 5));
+
+  auto spans = ring.peek();
+  ASSERT_EQ(spans.size(), 6);
+  ASSERT_EQ(spans.first.size(), 3);
+  ASSERT_EQ(spans.second.size(), 3);
+  EXPECT_EQ(spans.first[0], 5);
+  EXPECT_EQ(spans.second[2], 10);
+
+  auto limited = ring.peek(2);
+  EXPECT_EQ(limited.size(), 2);
+  EXPECT_TRUE(limited.second.empty());
+
+  ring.consume(4);
+  EXPECT_EQ(ring.used(), 2);
+  EXPECT_EQ(ring.peek().first[0], 9);
+}
+
+TEST(SPSCByteRingTest, PrepareAndCommitWrite) {
+  SPSCByteRing ring(8);
+  const uint8_t pad[7] = {};
+  ASSERT_TRUE(ring.write(pad, 7));
+  ring.consume(7);
+
+  auto spans = ring.prepareWrite(5);
+  ASSERT_EQ(spans.first.size(), 1);
+  ASSERT_EQ(spans.second.size(), 4);
+  spans.first[0] = 'a';
+  spans.second[0] = 'b';
+  ring.commitWrite(2);
+
+  uint8_t out[4] = {};
+  EXPECT_EQ(ring.read(out, sizeof(out)), 2);
+  EXPECT_EQ(out[0], 'a');
+  EXPECT_EQ(out[1], 'b');
+}
+
+TEST(SPSCByteRingTest, ConcurrentProducerConsumer) {
+  constexpr size_t kTotal = 1 << 20;
+  SPSCByteRing ring(1024);
+
+  std::thread producer([&ring] {
+    uint8_t chunk[97];
+    size_t sent = 0;
+    while (sent < kTotal) {
+      const size_t len = std::min(sizeof(chunk), kTotal - sent);
+      for (size_t i = 0; i < len; ++i) {
+        chunk[i] = static_cast<uint8_t>(sent + i);
+      }
+      while (!ring.write(chunk, len)) {
+        std::this_thread::yield();
+      }
+      sent += len;
+    }
+  });
+
+  size_t received = 0;
+  bool ordered = true;
+  while (received < kTotal) {
+    auto spans = ring.peek();
+    for (auto span : {spans.first, spans.second}) {
+      for (uint8_t b : span) {
+        ordered = ordered && b == static_cast<uint8_t>(received);
+        ++received;
+      }
+    }
+    ring.consume(spans.size());
+    if (spans.empty()) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(ring.empty());
+}
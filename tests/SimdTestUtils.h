@@ -0,0 +1,67 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <cctype>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "pickup/utils/CpuFeatures.h"
+
+namespace pickup {
+namespace test {
+
+/** @brief 本机支持的全部 SIMD 级别，从 None 起按升序排列 */
+inline std::vector<utils::SimdLevel> simdLevels() {
+  std::vector<utils::SimdLevel> levels;
+  for (int i = 0; i <= static_cast<int>(utils::detectedSimdLevel()); ++i) {
+    levels.push_back(static_cast<utils::SimdLevel>(i));
+  }
+  return levels;
+}
+
+/** @brief 构造时记录当前 SIMD 级别上限（可选地设置新上限），析构时恢复 */
+class ScopedSimdLevelLimit {
+ public:
+  ScopedSimdLevelLimit() noexcept : previous_(utils::simdLevelLimit()) {}
+  explicit ScopedSimdLevelLimit(utils::SimdLevel limit) noexcept : ScopedSimdLevelLimit() {
+    utils::setSimdLevelLimit(limit);
+  }
+  ~ScopedSimdLevelLimit() { utils::setSimdLevelLimit(previous_); }
+
+  ScopedSimdLevelLimit(const ScopedSimdLevelLimit&) = delete;
+  ScopedSimdLevelLimit& operator=(const ScopedSimdLevelLimit&) = delete;
+
+ private:
+  utils::SimdLevel previous_;
+};
+
+/**
+ * @brief 按 SIMD 级别参数化的测试基类，每个用例在 GetParam() 级别上限下运行，结束后恢复原上限
+ *
+ * 用法：
+ *   class FooSimdTest : public pickup::test::SimdLevelTest {};
+ *   INSTANTIATE_TEST_SUITE_P(Levels, FooSimdTest, ::testing::ValuesIn(pickup::test::simdLevels()),
+ *                            pickup::test::simdLevelName);
+ */
+class SimdLevelTest : public ::testing::TestWithParam<utils::SimdLevel> {
+ protected:
+  void SetUp() override { limit_.emplace(GetParam()); }
+  void TearDown() override { limit_.reset(); }
+
+ private:
+  std::optional<ScopedSimdLevelLimit> limit_;
+};
+
+/** @brief 参数化测试名；"sse4.2" 含 '.'，只保留字母数字 */
+inline std::string simdLevelName(const ::testing::TestParamInfo<utils::SimdLevel>& info) {
+  std::string name;
+  for (const char* p = utils::toString(info.param); *p; ++p) {
+    if (std::isalnum(static_cast<unsigned char>(*p))) name += *p;
+  }
+  return name;
+}
+
+}  // namespace test
+}  // namespace pickup
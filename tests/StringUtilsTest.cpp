@@ -1,10 +1,18 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <string_view>
 #include <string>
 #include <vector>
 
 #include "pickup/utils/StringUtils.h"
 
+#include "RandomData.h"
+#include "SimdTestUtils.h"
+
 using namespace pickup::utils;
+using pickup::test::randomText;
 
 TEST(StringUtilsTest, ToUpper) {
   EXPECT_EQ(toUpper("abc"), "ABC");
@@ -173,6 +181,17 @@ TEST(StringUtilsTest, SplitNoMatch) {
   EXPECT_EQ(parts[0], "abc");
 }
 
+TEST(StringUtilsTest, SplitChar) {
+  auto parts = split("a,b,,c,", ',');
+  ASSERT_EQ(parts.size(), 5);
+  EXPECT_EQ(parts[0], "a");
+  EXPECT_EQ(parts[1], "b");
+  EXPECT_EQ(parts[2], "");
+  EXPECT_EQ(parts[3], "c");
+  EXPECT_EQ(parts[4], "");
+  EXPECT_EQ(split("", ',').size(), 1);
+}
+
 TEST(StringUtilsTest, SplitAnyOf) {
   auto parts = splitAnyOf("a,b;c", ",;");
   ASSERT_EQ(parts.size(), 3);
@@ -206,3 +225,254 @@ TEST(StringUtilsTest, JoinString) {
   std::vector<std::string> parts = {"a", "b", "c"};
   EXPECT_EQ(join(" -> ", parts), "a -> b -> c");
 }
+
+TEST(StringUtilsTest, ToUpperLowerInPlace) {
+  std::string s = "aBc123-Xy";
+  toUpperInPlace(s);
+  EXPECT_EQ(s, "ABC123-XY");
+  toLowerInPlace(s);
+  EXPECT_EQ(s, "abc123-xy");
+  std::string empty;
+  toLowerInPlace(empty);
+  EXPECT_EQ(empty, "");
+}
+
+TEST(StringUtilsTest, AcceptsStringView) {
+  const std::string line = "GET /api/v1/users HTTP/1.1";
+  const std::string_view path = std::string_view(line).substr(4, 13);
+  EXPECT_TRUE(startsWith(path, "/api"));
+  EXPECT_TRUE(endsWith(path, "users"));
+  EXPECT_TRUE(contains(path, "v1"));
+  EXPECT_FALSE(contains(path, "HTTP"));
+  EXPECT_TRUE(compareNoCase(path, "/API/V1/USERS"));
+  EXPECT_EQ(toUpper(path), "/API/V1/USERS");
+  EXPECT_EQ(replaceAll(path, "v1", "v2"), "/api/v2/users");
+}
+
+TEST(StringUtilsTest, TrimView) {
+  const std::string s = " \t hello world \n";
+  EXPECT_EQ(trimView(s), "hello world");
+  EXPECT_EQ(trimLeftView(s), "hello world \n");
+  EXPECT_EQ(trimRightView(s), " \t hello world");
+  EXPECT_EQ(trimView("xxhixx", "x"), "hi");
+  EXPECT_EQ(trimView("   "), "");
+  EXPECT_EQ(trimView(""), "");
+  // 结果指向原字符串内部
+  EXPECT_EQ(trimView(s).data(), s.data() + 3);
+}
+
+TEST(StringUtilsTest, StripPrefixSuffixView) {
+  const std::string s = "prefix_body_suffix";
+  EXPECT_EQ(stripPrefixView(s, "prefix_"), "body_suffix");
+  EXPECT_EQ(stripPrefixView(s, "nope"), s);
+  EXPECT_EQ(stripSuffixView(s, "_suffix"), "prefix_body");
+  EXPECT_EQ(stripSuffixView(s, "nope"), s);
+  EXPECT_EQ(stripPrefixView(s, "prefix_").data(), s.data() + 7);
+}
+
+TEST(StringUtilsTest, SplitView) {
+  const std::string line = "GET /index.html HTTP/1.1";
+  std::vector<std::string_view> parts(splitView(line, ' ').begin(), splitView(line, ' ').end());
+  ASSERT_EQ(parts.size(), 3);
+  EXPECT_EQ(parts[0], "GET");
+  EXPECT_EQ(parts[1], "/index.html");
+  EXPECT_EQ(parts[2], "HTTP/1.1");
+  EXPECT_EQ(parts[1].data(), line.data() + 4);
+
+  size_t count = 0;
+  for (std::string_view part : splitView("a::b::", "::")) {
+    EXPECT_TRUE(part == "a" || part == "b" || part.empty());
+    ++count;
+  }
+  EXPECT_EQ(count, 3);
+}
+
+TEST(StringUtilsTest, SplitViewEdgeCases) {
+  auto collect = [](SplitView view) { return std::vector<std::string_view>(view.begin(), view.end()); };
+  EXPECT_EQ(collect(splitView("", ',')), std::vector<std::string_view>{""});
+  EXPECT_EQ(collect(splitView(",", ',')), (std::vector<std::string_view>{"", ""}));
+  EXPECT_EQ(collect(splitView("ab", "")), (std::vector<std::string_view>{"a", "b"}));
+  EXPECT_TRUE(collect(splitView("", "")).empty());
+  EXPECT_EQ(collect(splitAnyOfView("a=1;b=2", "=;")), (std::vector<std::string_view>{"a", "1", "b", "2"}));
+  EXPECT_EQ(collect(splitAnyOfView("abc", "")), std::vector<std::string_view>{"abc"});
+}
+
+TEST(StringUtilsTest, SplitViewIsForwardRange) {
+  static_assert(std::ranges::forward_range<SplitView>);
+  static_assert(std::ranges::borrowed_range<SplitView>);
+  static_assert(std::ranges::view<SplitView>);
+
+  const SplitView view = splitView("k1=v1&k2=v2&k3=v3", '&');
+  EXPECT_EQ(std::ranges::distance(view), 3);
+  EXPECT_EQ(view.front(), "k1=v1");
+  EXPECT_FALSE(view.empty());
+
+  auto it = view.begin();
+  auto copy = it++;
+  EXPECT_EQ(*copy, "k1=v1");
+  EXPECT_EQ(*it, "k2=v2");
+  EXPECT_EQ(std::next(copy), it);
+  EXPECT_EQ(std::ranges::next(it, 2), view.end());
+  // 与 split("", c) 一致，空字符串产生一个空片段
+  EXPECT_EQ(std::ranges::distance(SplitView()), 1);
+  EXPECT_EQ(SplitView::iterator(), view.end());
+}
+
+TEST(StringUtilsTest, JoinStringView) {
+  const std::string line = "a b  c";
+  const std::vector<std::string_view> parts(splitView(line, ' ').begin(), splitView(line, ' ').end());
+  EXPECT_EQ(join(',', parts), "a,b,,c");
+  EXPECT_EQ(join(std::string_view("::"), parts), "a::b::::c");
+  EXPECT_EQ(join(',', std::vector<std::string_view>{}), "");
+}
+
+TEST(StringUtilsTest, JoinBracedListAndRanges) {
+  // 花括号列表只匹配 std::vector<std::string> 重载，不能因视图重载变得有歧义
+  EXPECT_EQ(join(",", {"a", "b"}), "a,b");
+  EXPECT_EQ(join(',', {std::string("a")}), "a");
+  EXPECT_EQ(join(',', {}), "");
+  EXPECT_EQ(join('-', splitView("x y z", ' ')), "x-y-z");
+  const std::string_view pieces[] = {"p", "q"};
+  EXPECT_EQ(join(std::string_view(", "), pieces), "p, q");
+}
+
+namespace {
+
+// 基于 std::string 查找的参考实现，与 SIMD 内核的结果逐一比较
+std::vector<std::string> referenceSplit(const std::string& str, const std::string& delimiter) {
+  std::vector<std::string> vec;
+  size_t start = 0;
+  size_t pos = 0;
+  while ((pos = str.find(delimiter, start)) != std::string::npos) {
+    vec.push_back(str.substr(start, pos - start));
+    start = pos + delimiter.size();
+  }
+  vec.push_back(str.substr(start));
+  return vec;
+}
+
+std::vector<std::string> referenceSplitAnyOf(const std::string& str, const std::string& delimiters) {
+  std::vector<std::string> vec;
+  size_t start = 0;
+  size_t pos = 0;
+  while ((pos = str.find_first_of(delimiters, start)) != std::string::npos) {
+    vec.push_back(str.substr(start, pos - start));
+    start = pos + 1;
+  }
+  vec.push_back(str.substr(start));
+  return vec;
+}
+
+std::string referenceReplaceAll(std::string str, const std::string& from, const std::string& to) {
+  size_t pos = 0;
+  while ((pos = str.find(from, pos)) != std::string::npos) {
+    str.replace(pos, from.size(), to);
+    pos += to.size();
+  }
+  return str;
+}
+
+std::string referenceTrim(const std::string& str, const std::string& chars) {
+  const size_t first = str.find_first_not_of(chars);
+  if (first == std::string::npos) return "";
+  return str.substr(first, str.find_last_not_of(chars) - first + 1);
+}
+
+const std::string kAlphabet = std::string("abc ,;=\t\n\xE4\xB8\xAD") + '\0';
+
+class StringUtilsSimdTest : public pickup::test::SimdLevelTest {};
+
+}  // namespace
+
+TEST_P(StringUtilsSimdTest, ContainsAndSplitMatchReference) {
+  const std::vector<std::string> patterns = {"a", "ab", "abc", "a b", ", ", "cba,", "aaaa", "\xE4\xB8\xAD",
+                                             std::string("a\0b", 3), "abcabcabcabcabcabcabcabcabcabcabcab"};
+  for (size_t len = 0; len < 100; ++len) {
+    const std::string text = randomText(len, static_cast<uint32_t>(len) + 1, kAlphabet);
+    for (const auto& pattern : patterns) {
+      EXPECT_EQ(contains(text, pattern), text.find(pattern) != std::string::npos) << len << " " << pattern;
+      EXPECT_EQ(split(text, pattern), referenceSplit(text, pattern)) << len << " " << pattern;
+      const auto view = splitView(text, pattern);
+      EXPECT_TRUE(std::ranges::equal(view, referenceSplit(text, pattern))) << len << " " << pattern;
+    }
+  }
+}
+
+TEST_P(StringUtilsSimdTest, ContainsLongInput) {
+  std::string text(5000, 'a');
+  EXPECT_FALSE(contains(text, "ab"));
+  text[4998] = 'b';
+  EXPECT_TRUE(contains(text, "ab"));
+  EXPECT_TRUE(contains(text, "aaab"));
+  EXPECT_FALSE(contains(text, "aaabb"));
+  text[4999] = 'c';
+  EXPECT_TRUE(contains(text, "abc"));
+}
+
+TEST_P(StringUtilsSimdTest, ReplaceAllMatchesReference) {
+  const std::string text = randomText(500, 7, "ab ,");
+  for (const std::string from : {"a", "ab", "ba", "a,b", "aa", ", "}) {
+    for (const std::string to : {"", "x", "xyz", "ab"}) {
+      EXPECT_EQ(replaceAll(text, from, to), referenceReplaceAll(text, from, to)) << from << " -> " << to;
+    }
+  }
+  EXPECT_EQ(replaceAll("aaaa", "aa", "a"), "aa");
+  EXPECT_EQ(replaceAll("abc", "abcd", "x"), "abc");
+}
+
+TEST_P(StringUtilsSimdTest, SplitAnyOfMatchesReference) {
+  const std::vector<std::string> sets = {"",
+                                         ",",
+                                         ",;",
+                                         " \t\n",
+                                         "=;, \t\nxyz",
+                                         "\xE4",
+                                         "\xB8,",
+                                         std::string(1, '\0'),
+                                         "0123456789ABCDEFGHIJ,",      // 超过 16 个成员
+                                         "0123456789ABCDEFGHIJ\xAD"};  // 超过 16 个成员且含非 ASCII
+  for (size_t len = 0; len < 100; ++len) {
+    const std::string text = randomText(len, static_cast<uint32_t>(len) * 31 + 5, kAlphabet);
+    for (const auto& set : sets) {
+      EXPECT_EQ(splitAnyOf(text, set), referenceSplitAnyOf(text, set)) << len;
+      EXPECT_TRUE(std::ranges::equal(splitAnyOfView(text, set), referenceSplitAnyOf(text, set))) << len;
+    }
+  }
+}
+
+TEST_P(StringUtilsSimdTest, TrimMatchesReference) {
+  for (const std::string chars : {" ", " \t\n", "ab", "\xE4\xB8\xAD ", ""}) {
+    for (size_t pad = 0; pad < 40; ++pad) {
+      const std::string edge = randomText(pad, static_cast<uint32_t>(pad) + 3, chars.empty() ? " " : chars);
+      const std::string text = edge + "x y\xE4z" + edge;
+      std::string left = text;
+      std::string right = text;
+      std::string both = text;
+      trimLeft(left, chars);
+      trimRight(right, chars);
+      trim(both, chars);
+      const size_t first = text.find_first_not_of(chars);
+      EXPECT_EQ(left, first == std::string::npos ? "" : text.substr(first));
+      EXPECT_EQ(right, text.substr(0, text.find_last_not_of(chars) + 1));
+      EXPECT_EQ(both, referenceTrim(text, chars));
+      EXPECT_EQ(trimView(text, chars), referenceTrim(text, chars));
+    }
+    std::string blank(50, ' ');
+    trim(blank, " ");
+    EXPECT_EQ(blank, "");
+  }
+}
+
+TEST_P(StringUtilsSimdTest, IsBlankLongInput) {
+  std::string text(100, ' ');
+  for (size_t i = 0; i < text.size(); ++i) text[i] = " \t\n\r\f\v"[i % 6];
+  EXPECT_TRUE(isBlank(text));
+  for (size_t i = 0; i < text.size(); ++i) {
+    std::string s = text;
+    s[i] = (i % 2) ? 'x' : '\xA0';
+    EXPECT_FALSE(isBlank(s)) << i;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Levels, StringUtilsSimdTest, ::testing::ValuesIn(pickup::test::simdLevels()),
+                         pickup::test::simdLevelName);
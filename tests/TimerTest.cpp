@@ -127,3 +127,75 @@ TEST(TimerTest, StopTimer) {
   // stop 后剩余任务可能已执行或丢弃
   EXPECT_NO_THROW(timer.stop());
 }
+
+TEST(TimerTest, StatsCountFiredAndPending) {
+  Timer timer;
+  auto pendingTask = std::make_shared<TimerTaskAdapter>([] {});
+  timer.schedule(pendingTask, std::chrono::seconds(10));
+  std::atomic<int> counter{0};
+  for (int i = 0; i < 3; ++i) {
+    timer.schedule([&] { counter.fetch_add(1); }, std::chrono::milliseconds(1));
+  }
+  timer.schedule([] { throw std::runtime_error("boom"); }, std::chrono::milliseconds(1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  const TimerStats stats = timer.stats();
+  EXPECT_EQ(counter.load(), 3);
+  EXPECT_EQ(stats.pending, 1u);
+  EXPECT_EQ(stats.fired, 4u);
+  EXPECT_EQ(stats.exceptions, 1u);
+  EXPECT_EQ(stats.lag.count, 4u);
+  EXPECT_EQ(stats.execution.count, 4u);
+  EXPECT_GE(stats.lag.percentile(1.0), stats.lag.percentile(0.5));
+
+  timer.resetStats();
+  EXPECT_EQ(timer.stats().fired, 0u);
+  EXPECT_EQ(timer.stats().pending, 1u);
+}
+
+TEST(TimerTest, StatsFixedRateOverrun) {
+  Timer timer;
+  // 每次执行耗时超过周期，续排时必然已落后
+  auto task = timer.scheduleAtFixedRate([] { std::this_thread::sleep_for(std::chrono::milliseconds(5)); },
+                                        std::chrono::milliseconds(1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  timer.cancel(task);
+  EXPECT_GT(timer.stats().fixedRateOverruns, 0u);
+}
+
+TEST(TimerTest, LatencyHistogramPercentile) {
+  LatencyHistogram h;
+  EXPECT_EQ(h.percentile(0.5), std::chrono::nanoseconds::zero());
+  EXPECT_EQ(LatencyHistogram::bucketOf(std::chrono::nanoseconds(0)), 0u);
+  EXPECT_EQ(LatencyHistogram::bucketOf(std::chrono::nanoseconds(1)), 1u);
+  EXPECT_EQ(LatencyHistogram::bucketOf(std::chrono::nanoseconds(1000)), 10u);
+
+  h.buckets[LatencyHistogram::bucketOf(std::chrono::nanoseconds(100))] = 9;
+  h.buckets[LatencyHistogram::bucketOf(std::chrono::nanoseconds(5000))] = 1;
+  h.count = 10;
+  h.total = std::chrono::nanoseconds(9 * 100 + 5000);
+  h.max = std::chrono::nanoseconds(5000);
+  EXPECT_EQ(h.percentile(0.5), std::chrono::nanoseconds(127));
+  EXPECT_EQ(h.percentile(1.0), std::chrono::nanoseconds(5000));
+  EXPECT_EQ(h.mean(), std::chrono::nanoseconds(590));
+}
+
+TEST(TimerTest, HighResolutionFiresOnTime) {
+  TimerOptions options;
+  options.highResolution = true;
+  options.spinWindow = std::chrono::microseconds(200);
+  Timer timer(options);
+
+  std::atomic<int> counter{0};
+  auto task = timer.scheduleAtFixedRate([&] { counter.fetch_add(1); }, std::chrono::milliseconds(2));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  timer.cancel(task);
+  EXPECT_GE(counter.load(), 10);
+
+  // 休眠期间新增的更早任务应能打断等待
+  std::atomic<bool> executed{false};
+  timer.schedule([] {}, std::chrono::seconds(10));
+  timer.schedule([&] { executed.store(true); }, std::chrono::milliseconds(5));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_TRUE(executed.load());
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "pickup/buffer/TraceBuffer.h"
+
+using namespace pickup::buffer;
+
+namespace {
+
+void writeString(TraceBuffer& trace, std::string_view s) {
+  trace.write(reinterpret_cast<const uint8_t*>(s.data()), s.size());
+}
+
+}  // namespace
+
+TEST(TraceBufferTest, CapacityRoundsToPowerOfTwo) {
+  TraceBuffer trace(100);
+  EXPECT_EQ(trace.capacity(), 128);
+  EXPECT_EQ(trace.mode(), TraceBuffer::Mode::Bytes);
+  EXPECT_TRUE(trace.snapshot().empty());
+}
+
+TEST(TraceBufferTest, BytesModeKeepsNewest) {
+  TraceBuffer trace(16);
+  writeString(trace, "0123456789");
+  EXPECT_EQ(trace.snapshot().toStringView(), "0123456789");
+  writeString(trace, "abcdefghij");
+  EXPECT_EQ(trace.snapshot().toStringView(), "456789abcdefghij");
+  EXPECT_EQ(trace.totalWritten(), 20);
+  EXPECT_EQ(trace.droppedBytes(), 4);
+}
+
+TEST(TraceBufferTest, BytesModeOversizedWrite) {
+  TraceBuffer trace(16);
+  writeString(trace, "xx");
+  writeString(trace, "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+  EXPECT_EQ(trace.snapshot().toStringView(), "KLMNOPQRSTUVWXYZ");
+  EXPECT_EQ(trace.totalWritten(), 28);
+}
+
+TEST(TraceBufferTest, RecordsModeEvictsWholeRecords) {
+  TraceBuffer trace(32, TraceBuffer::Mode::Records);
+  EXPECT_TRUE(trace.writeRecord("first", 5));    // 9 字节
+  EXPECT_TRUE(trace.writeRecord("second", 6));   // 10 字节
+  EXPECT_TRUE(trace.writeRecord("third!", 6));   // 10 字节，共 29
+  auto records = trace.snapshotRecords();
+  ASSERT_EQ(records.size(), 3);
+  EXPECT_EQ(records[0].toStringView(), "first");
+
+  EXPECT_TRUE(trace.writeRecord("fourth", 6));  // 需淘汰 "first"
+  records = trace.snapshotRecords();
+  ASSERT_EQ(records.size(), 3);
+  EXPECT_EQ(records[0].toStringView(), "second");
+  EXPECT_EQ(records[2].toStringView(), "fourth");
+  EXPECT_EQ(trace.droppedRecords(), 1);
+  EXPECT_EQ(trace.droppedBytes(), 9);
+}
+
+TEST(TraceBufferTest, RecordsModeRejectsOversized) {
+  TraceBuffer trace(16, TraceBuffer::Mode::Records);
+  std::string big(13, 'x');
+  EXPECT_FALSE(trace.writeRecord(big.data(), big.size()));
+  EXPECT_TRUE(trace.writeRecord(big.data(), 12));
+  EXPECT_EQ(trace.snapshotRecords().size(), 1);
+}
+
+TEST(TraceBufferTest, WriteModeMismatch) {
+  // 调试构建中断言失败；release 构建中拒绝写入，分帧保持完整
+  TraceBuffer records(32, TraceBuffer::Mode::Records);
+  ASSERT_TRUE(records.writeRecord("kept", 4));
+  EXPECT_DEBUG_DEATH(writeString(records, "raw"), "Mode::Bytes");
+  auto slices = records.snapshotRecords();
+  ASSERT_EQ(slices.size(), 1);
+  EXPECT_EQ(slices[0].toStringView(), "kept");
+
+  TraceBuffer bytes(32);
+  EXPECT_DEBUG_DEATH(EXPECT_FALSE(bytes.writeRecord("rec", 3)), "Mode::Records");
+  EXPECT_TRUE(bytes.snapshot().empty());
+}
+
+TEST(TraceBufferTest, SnapshotWhileWriting) {
+  TraceBuffer trace(256, TraceBuffer::Mode::Records);
+  std::atomic<bool> stop{false};
+
+  // 每条记录为 8 字节：4 字节序号 + 4 字节序号的按位取反，用于校验记录完整性
+  std::thread writer([&] {
+    for (uint32_t seq = 0; !stop.load(std::memory_order_relaxed); ++seq) {
+      uint32_t rec[2] = {seq, ~seq};
+      trace.writeRecord(rec, sizeof(rec));
+    }
+  });
+
+  bool intact = true;
+  bool ordered = true;
+  for (int i = 0; i < 2000; ++i) {
+    auto records = trace.snapshotRecords();
+    uint32_t prev = 0;
+    for (size_t j = 0; j < records.size(); ++j) {
+      uint32_t rec[2];
+      ASSERT_EQ(records[j].size(), sizeof(rec));
+      std::memcpy(rec, records[j].data(), sizeof(rec));
+      intact = intact && rec[1] == ~rec[0];
+      ordered = ordered && (j == 0 || rec[0] == prev + 1);
+      prev = rec[0];
+    }
+  }
+  stop = true;
+  writer.join();
+  EXPECT_TRUE(intact);
+  EXPECT_TRUE(ordered);
+}
@@ -1,9 +1,19 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
+#include "pickup/buffer/ByteBuffer.h"
 #include "pickup/codec/base64.h"
 
+#include "RandomData.h"
+#include "SimdTestUtils.h"
+
 using namespace pickup::codec;
+using pickup::test::randomBytes;
 
 TEST(Base64Test, EncodeEmpty) {
   EXPECT_EQ(base64::encode(""), "");
@@ -73,3 +83,220 @@ TEST(Base64Test, RoundtripUrlSafe) {
   auto decoded = base64::decode(from_url);
   EXPECT_EQ(decoded, input);
 }
+
+namespace {
+
+// 参考实现：逐字符查表，用于校验各 SIMD 路径
+std::string referenceEncode(const std::string& in) {
+  static const char kChars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  size_t i = 0;
+  for (; i + 3 <= in.size(); i += 3) {
+    const uint32_t n = (uint32_t(uint8_t(in[i])) << 16) | (uint32_t(uint8_t(in[i + 1])) << 8) | uint8_t(in[i + 2]);
+    out += kChars[n >> 18];
+    out += kChars[(n >> 12) & 63];
+    out += kChars[(n >> 6) & 63];
+    out += kChars[n & 63];
+  }
+  if (i < in.size()) {
+    const bool two = in.size() - i == 2;
+    const uint32_t n = (uint32_t(uint8_t(in[i])) << 16) | (two ? uint32_t(uint8_t(in[i + 1])) << 8 : 0);
+    out += kChars[n >> 18];
+    out += kChars[(n >> 12) & 63];
+    out += two ? kChars[(n >> 6) & 63] : '=';
+    out += '=';
+  }
+  return out;
+}
+
+class Base64SimdTest : public pickup::test::SimdLevelTest {};
+
+}  // namespace
+
+TEST_P(Base64SimdTest, EncodeMatchesReference) {
+  for (size_t len = 0; len < 300; ++len) {
+    const std::string in = randomBytes(len, static_cast<uint32_t>(len));
+    ASSERT_EQ(base64::encode(in), referenceEncode(in)) << "len=" << len;
+  }
+}
+
+TEST_P(Base64SimdTest, RoundtripLarge) {
+  const std::string in = randomBytes(100000, 42);
+  const std::string encoded = base64::encode(in);
+  EXPECT_EQ(encoded, referenceEncode(in));
+  EXPECT_EQ(base64::decode(encoded), in);
+}
+
+TEST_P(Base64SimdTest, DecodeStopsAtInvalidCharacter) {
+  const std::string in = randomBytes(300, 7);
+  const std::string encoded = base64::encode(in);
+  // 在不同位置插入非法字符：解码结果应为该位置之前的完整组加上部分组
+  for (size_t pos = 0; pos < encoded.size(); pos += 5) {
+    std::string broken = encoded;
+    broken[pos] = '*';
+    const size_t groups = pos / 4;
+    const size_t partial = pos % 4;
+    const size_t expected = groups * 3 + (partial > 0 ? partial - 1 : 0);
+    const std::string decoded = base64::decode(broken);
+    ASSERT_EQ(decoded.size(), expected) << "pos=" << pos;
+    EXPECT_EQ(decoded, in.substr(0, expected));
+  }
+}
+
+TEST_P(Base64SimdTest, DecodeRejectsHighBytes) {
+  std::string encoded = base64::encode(randomBytes(96, 3));
+  encoded[70] = static_cast<char>(0xC1);
+  EXPECT_EQ(base64::decode(encoded).size(), 52u);  // 17 个完整组 + 2 个字符的部分组
+}
+
+INSTANTIATE_TEST_SUITE_P(Levels, Base64SimdTest, ::testing::ValuesIn(pickup::test::simdLevels()),
+                         pickup::test::simdLevelName);
+
+TEST(Base64Test, EncodeIntoBuffer) {
+  const std::string input = "foobar!";
+  std::string out(base64::encodedLength(input.size()), '\0');
+  const size_t n = base64::encode(reinterpret_cast<const uint8_t*>(input.data()), input.size(), out.data());
+  EXPECT_EQ(n, out.size());
+  EXPECT_EQ(out, "Zm9vYmFyIQ==");
+}
+
+TEST(Base64Test, DecodeIntoBuffer) {
+  const std::string encoded = "Zm9vYmFyIQ==";
+  std::vector<uint8_t> out(base64::maxDecodedLength(encoded.size()));
+  const size_t n = base64::decode(encoded.data(), encoded.size(), out.data());
+  EXPECT_EQ(std::string(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(n)), "foobar!");
+}
+
+TEST_P(Base64SimdTest, StreamingEncoderMatchesOneShot) {
+  const std::string in = randomBytes(5000, 11);
+  for (size_t chunk : {1u, 2u, 5u, 47u, 100u, 4096u}) {
+    base64::Encoder enc;
+    pickup::buffer::ByteBuffer out;
+    for (size_t pos = 0; pos < in.size(); pos += chunk) {
+      const size_t n = std::min(chunk, in.size() - pos);
+      enc.update(std::span(reinterpret_cast<const uint8_t*>(in.data()) + pos, n), out);
+    }
+    enc.finish(out);
+    EXPECT_EQ(out.toStringView(), base64::encode(in)) << "chunk=" << chunk;
+  }
+}
+
+TEST_P(Base64SimdTest, StreamingDecoderMatchesOneShot) {
+  const std::string in = randomBytes(5000, 13);
+  const std::string encoded = base64::encode(in);
+  for (size_t chunk : {1u, 3u, 7u, 64u, 999u, 8192u}) {
+    base64::Decoder dec;
+    pickup::buffer::ByteBuffer out;
+    for (size_t pos = 0; pos < encoded.size(); pos += chunk) {
+      dec.update(std::span(encoded.data() + pos, std::min(chunk, encoded.size() - pos)), out);
+    }
+    dec.finish(out);
+    EXPECT_EQ(out.toStringView(), in) << "chunk=" << chunk;
+  }
+}
+
+TEST(Base64StreamTest, EncoderCarriesPartialGroup) {
+  base64::Encoder enc;
+  char out[16];
+  const uint8_t a[] = {'f'};
+  const uint8_t b[] = {'o', 'o', 'b'};
+  EXPECT_EQ(enc.update(a, out), 0u);
+  EXPECT_EQ(enc.pending(), 1u);
+  EXPECT_EQ(enc.update(b, out), 4u);
+  EXPECT_EQ(std::string(out, 4), "Zm9v");
+  EXPECT_EQ(enc.pending(), 1u);
+  EXPECT_EQ(enc.finish(out), 4u);
+  EXPECT_EQ(std::string(out, 4), "Yg==");
+  EXPECT_EQ(enc.pending(), 0u);
+}
+
+TEST(Base64StreamTest, EncoderRejectsSmallOutput) {
+  base64::Encoder enc;
+  const uint8_t in[6] = {};
+  char out[7];
+  EXPECT_THROW(enc.update(in, out), std::length_error);
+}
+
+TEST(Base64StreamTest, DecoderStopsAtPadding) {
+  base64::Decoder dec;
+  pickup::buffer::ByteBuffer out;
+  const std::string first = "Zm9vY";
+  const std::string second = "g==Zm9v";
+  dec.update(first, out);
+  EXPECT_FALSE(dec.stopped());
+  dec.update(second, out);
+  EXPECT_TRUE(dec.stopped());
+  dec.update(std::string_view("QUJD"), out);  // 停止后忽略
+  dec.finish(out);
+  EXPECT_EQ(out.toStringView(), "foob");
+  EXPECT_FALSE(dec.stopped());  // finish 后复位
+}
+
+TEST(Base64VariantTest, EncodeVariants) {
+  const std::string input = "\xFB\xFF\xBF\xFE";
+  EXPECT_EQ(base64::encode(input, base64::Variant::Standard), "+/+//g==");
+  EXPECT_EQ(base64::encode(input, base64::Variant::StandardNoPad), "+/+//g");
+  EXPECT_EQ(base64::encode(input, base64::Variant::UrlSafe), "-_-__g==");
+  EXPECT_EQ(base64::encode(input, base64::Variant::UrlSafeNoPad), "-_-__g");
+  EXPECT_EQ(base64::encodedLength(4, base64::Variant::UrlSafeNoPad), 6u);
+  EXPECT_EQ(base64::encodedLength(5, base64::Variant::UrlSafeNoPad), 7u);
+  EXPECT_EQ(base64::encodedLength(6, base64::Variant::UrlSafeNoPad), 8u);
+}
+
+TEST_P(Base64SimdTest, UrlSafeMatchesConversion) {
+  for (size_t len = 0; len < 200; ++len) {
+    const std::string in = randomBytes(len, static_cast<uint32_t>(len) + 100);
+    const std::string urlSafe = base64::encode(in, base64::Variant::UrlSafeNoPad);
+    ASSERT_EQ(urlSafe, base64::toUrlSafe(base64::encode(in))) << "len=" << len;
+    EXPECT_EQ(base64::decode(urlSafe, base64::Variant::UrlSafe), in);
+    EXPECT_EQ(base64::decodeStrict(urlSafe, base64::Variant::UrlSafeNoPad), in);
+  }
+}
+
+TEST(Base64VariantTest, StrictAcceptsCanonical) {
+  EXPECT_EQ(base64::decodeStrict("Zm9vYg=="), "foob");
+  EXPECT_EQ(base64::decodeStrict("Zm9vYmE="), "fooba");
+  EXPECT_EQ(base64::decodeStrict("Zm9vYmFy"), "foobar");
+  EXPECT_EQ(base64::decodeStrict(""), "");
+  EXPECT_EQ(base64::decodeStrict("Zm9vYg", base64::Variant::StandardNoPad), "foob");
+}
+
+TEST(Base64VariantTest, StrictReportsErrorOffset) {
+  size_t offset = 0;
+  EXPECT_FALSE(base64::decodeStrict("Zm9v*mFy", base64::Variant::Standard, &offset));
+  EXPECT_EQ(offset, 4u);
+  EXPECT_FALSE(base64::decodeStrict("Zm9vYg", base64::Variant::Standard, &offset));
+  EXPECT_EQ(offset, 6u);  // 缺少填充
+  EXPECT_FALSE(base64::decodeStrict("Zm=vYmFy", base64::Variant::Standard, &offset));
+  EXPECT_EQ(offset, 2u);
+  EXPECT_FALSE(base64::decodeStrict("Zm9vY===", base64::Variant::Standard, &offset));
+  EXPECT_EQ(offset, 5u);
+  EXPECT_FALSE(base64::decodeStrict("Zm9vYg==", base64::Variant::StandardNoPad, &offset));
+  EXPECT_EQ(offset, 6u);
+  EXPECT_FALSE(base64::decodeStrict("Zm9vY", base64::Variant::StandardNoPad, &offset));
+  EXPECT_EQ(offset, 4u);
+  EXPECT_FALSE(base64::decodeStrict("Zm9v+mFy", base64::Variant::UrlSafe, &offset));
+  EXPECT_EQ(offset, 4u);
+}
+
+TEST_P(Base64SimdTest, StrictFindsFirstBadCharacterInLongInput) {
+  const std::string encoded = base64::encode(randomBytes(600, 5));
+  for (size_t pos = 0; pos < encoded.size() - 4; pos += 13) {
+    std::string broken = encoded;
+    broken[pos] = ' ';
+    std::vector<uint8_t> out(base64::maxDecodedLength(broken.size()));
+    const auto status = base64::decodeStrict(broken.data(), broken.size(), out.data(), base64::Variant::Standard);
+    ASSERT_FALSE(status.ok);
+    EXPECT_EQ(status.errorOffset, pos);
+    EXPECT_EQ(status.written, pos / 4 * 3);
+  }
+}
+
+TEST(Base64VariantTest, StreamingUrlSafeNoPad) {
+  base64::Encoder enc(base64::Variant::UrlSafeNoPad);
+  pickup::buffer::ByteBuffer out;
+  const std::string input = "\xFB\xFF\xBF\xFE";
+  enc.update(std::span(reinterpret_cast<const uint8_t*>(input.data()), input.size()), out);
+  enc.finish(out);
+  EXPECT_EQ(out.toStringView(), "-_-__g");
+}
@@ -1,12 +1,19 @@
 #include <gtest/gtest.h>
+#include <cctype>
 #include <cstdint>
+#include <cstdio>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 #include "pickup/codec/hex.h"
 
+#include "RandomData.h"
+#include "SimdTestUtils.h"
+
 using namespace pickup::codec;
+using pickup::test::randomBytes;
 
 TEST(HexTest, EncodeEmpty) {
   EXPECT_EQ(hex::encode(nullptr, 0), "");
@@ -122,3 +129,97 @@ TEST(HexTest, RoundtripWithSeparator) {
   ASSERT_TRUE(decoded.has_value());
   EXPECT_EQ(*decoded, original);
 }
+
+namespace {
+
+std::string referenceEncode(const std::vector<uint8_t>& data, bool uppercase) {
+  std::string out;
+  char buf[3];
+  for (uint8_t b : data) {
+    std::snprintf(buf, sizeof(buf), uppercase ? "%02X" : "%02x", b);
+    out += buf;
+  }
+  return out;
+}
+
+class HexSimdTest : public pickup::test::SimdLevelTest {};
+
+}  // namespace
+
+TEST_P(HexSimdTest, EncodeMatchesReference) {
+  for (size_t len = 0; len < 200; ++len) {
+    const auto data = randomBytes<std::vector<uint8_t>>(len, static_cast<uint32_t>(len));
+    ASSERT_EQ(hex::encode(data), referenceEncode(data, true)) << "len=" << len;
+    ASSERT_EQ(hex::encode(data, false), referenceEncode(data, false)) << "len=" << len;
+  }
+}
+
+TEST_P(HexSimdTest, DecodeRoundtripMixedCase) {
+  for (size_t len = 0; len < 200; ++len) {
+    const auto data = randomBytes<std::vector<uint8_t>>(len, static_cast<uint32_t>(len) + 7);
+    std::string encoded = referenceEncode(data, len % 2 == 0);
+    if (!encoded.empty()) {
+      encoded[0] = static_cast<char>(std::tolower(static_cast<unsigned char>(encoded[0])));
+    }
+    const auto decoded = hex::decode(encoded);
+    ASSERT_TRUE(decoded.has_value()) << "len=" << len;
+    EXPECT_EQ(*decoded, data);
+  }
+}
+
+TEST_P(HexSimdTest, DecodeRejectsInvalidAnywhere) {
+  const std::string encoded = hex::encode(randomBytes<std::vector<uint8_t>>(100, 3));
+  // 覆盖区间边界附近的字符：'/' ':' '@' 'G' '`' 'g' 及高位字节
+  for (const char bad : {'/', ':', '@', 'G', '`', 'g', ' ', static_cast<char>(0xC6)}) {
+    for (size_t pos = 0; pos < encoded.size(); pos += 11) {
+      std::string broken = encoded;
+      broken[pos] = bad;
+      ASSERT_FALSE(hex::decode(broken).has_value()) << "pos=" << pos << " char=" << static_cast<int>(bad);
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Levels, HexSimdTest, ::testing::ValuesIn(pickup::test::simdLevels()),
+                         pickup::test::simdLevelName);
+
+TEST(HexTest, EncodeIntoSpan) {
+  const uint8_t data[] = {0xDE, 0xAD, 0xBE, 0xEF};
+  char out[8];
+  EXPECT_EQ(hex::encode(data, out, false), 8u);
+  EXPECT_EQ(std::string(out, 8), "deadbeef");
+  char small[7];
+  EXPECT_THROW(hex::encode(data, small), std::length_error);
+}
+
+TEST(HexTest, DecodeIntoSpan) {
+  uint8_t out[4] = {};
+  auto n = hex::decode(std::string_view("DeadBeef"), out);
+  ASSERT_TRUE(n.has_value());
+  EXPECT_EQ(*n, 4u);
+  EXPECT_EQ(out[0], 0xDE);
+  EXPECT_EQ(out[3], 0xEF);
+  EXPECT_FALSE(hex::decode(std::string_view("DEADBEE"), out).has_value());
+  EXPECT_FALSE(hex::decode(std::string_view("DEADBEEX"), out).has_value());
+}
+
+TEST(HexTest, DecodeWithSeparatorIrregular) {
+  // 非规整格式走逐字符跳过的路径，结果与删除分隔符后解码一致
+  auto result = hex::decodeWithSeparator("ABCD EF");
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(*result, (std::vector<uint8_t>{0xAB, 0xCD, 0xEF}));
+  result = hex::decodeWithSeparator(" A B ");
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(*result, (std::vector<uint8_t>{0xAB}));
+  EXPECT_FALSE(hex::decodeWithSeparator("AB CD E").has_value());
+  EXPECT_FALSE(hex::decodeWithSeparator("AB:CD EF", ':').has_value());
+}
+
+TEST(HexTest, DecodeWithSeparatorIntoSpan) {
+  const auto data = randomBytes<std::vector<uint8_t>>(64, 9);
+  const std::string encoded = hex::encodeWithSeparator(data, false, ':');
+  std::vector<uint8_t> out(hex::maxDecodedLength(encoded.size()));
+  const auto n = hex::decodeWithSeparator(encoded, out, ':');
+  ASSERT_TRUE(n.has_value());
+  out.resize(*n);
+  EXPECT_EQ(out, data);
+}
@@ -1,8 +1,15 @@
 #include <gtest/gtest.h>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "pickup/codec/url.h"
 
+#include "SimdTestUtils.h"
+
 using namespace pickup::codec;
 
 TEST(UrlTest, EncodeEmpty) {
@@ -75,3 +82,140 @@ TEST(UrlTest, CharsetRoundtrip) {
     EXPECT_EQ(decoded, input) << "Failed roundtrip for input: " << input;
   }
 }
+
+namespace {
+
+// 参考实现：逐字节判断，用于校验批量扫描路径
+std::string referenceEncode(const std::string& input, const std::string& keep, bool spaceAsPlus) {
+  static const char kHex[] = "0123456789ABCDEF";
+  std::string out;
+  for (unsigned char ch : input) {
+    const bool alnum = (ch >= '0' && ch <= '9') || (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z');
+    if (alnum || std::string("-._~").find(static_cast<char>(ch)) != std::string::npos ||
+        (ch != 0 && keep.find(static_cast<char>(ch)) != std::string::npos)) {
+      out += static_cast<char>(ch);
+    } else if (spaceAsPlus && ch == ' ') {
+      out += '+';
+    } else {
+      out += '%';
+      out += kHex[ch >> 4];
+      out += kHex[ch & 0x0F];
+    }
+  }
+  return out;
+}
+
+std::string allBytes(size_t repeat) {
+  std::string s;
+  for (size_t r = 0; r < repeat; ++r) {
+    for (int i = 0; i < 256; ++i) {
+      s += static_cast<char>(i);
+    }
+    s += "a-long-run-of-unreserved-characters-0123456789";
+  }
+  return s;
+}
+
+class UrlSimdTest : public pickup::test::SimdLevelTest {};
+
+}  // namespace
+
+TEST_P(UrlSimdTest, ComponentsMatchReference) {
+  const std::string input = allBytes(3);
+  EXPECT_EQ(url::encode(input, url::Component::Unreserved), referenceEncode(input, "", false));
+  EXPECT_EQ(url::encode(input, url::Component::Form), referenceEncode(input, "", true));
+  EXPECT_EQ(url::encode(input, url::Component::Path), referenceEncode(input, "!$&'()*+,;=:@/", false));
+  EXPECT_EQ(url::encode(input, url::Component::Query), referenceEncode(input, "!$'()*,;:@/?", false));
+  EXPECT_EQ(url::encode(input), referenceEncode(input, "", true));
+}
+
+TEST_P(UrlSimdTest, DecodeRoundtrip) {
+  const std::string input = allBytes(3);
+  for (auto component : {url::Component::Unreserved, url::Component::Path, url::Component::Query,
+                         url::Component::Form}) {
+    const auto decoded = url::decodeStrict(url::encode(input, component), component);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(*decoded, input);
+  }
+}
+
+// 每个长度、每个位置放一个需转义的字节，覆盖向量主循环与重叠读取的结尾
+TEST_P(UrlSimdTest, SingleEscapeAtEveryPosition) {
+  for (size_t len = 1; len <= 96; ++len) {
+    for (size_t pos = 0; pos < len; ++pos) {
+      std::string input(len, 'a');
+      input[pos] = '%';
+      EXPECT_EQ(url::encode(input, url::Component::Unreserved), referenceEncode(input, "", false))
+          << len << " " << pos;
+    }
+    const std::string plain(len, 'z');
+    EXPECT_EQ(url::encode(plain, url::Component::Path), plain) << len;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Levels, UrlSimdTest, ::testing::ValuesIn(pickup::test::simdLevels()),
+                         pickup::test::simdLevelName);
+
+TEST(UrlTest, EncodePathKeepsSeparators) {
+  EXPECT_EQ(url::encode("/a b/c:d@e", url::Component::Path), "/a%20b/c:d@e");
+  EXPECT_EQ(url::encode("a=b&c+d", url::Component::Query), "a%3Db%26c%2Bd");
+  EXPECT_EQ(url::encodedLength("a b", url::Component::Form), 3u);
+  EXPECT_EQ(url::encodedLength("a b", url::Component::Path), 5u);
+}
+
+TEST(UrlTest, EncodeIntoSpan) {
+  char out[8];
+  EXPECT_EQ(url::encode("a b", out, url::Component::Path), 5u);
+  EXPECT_EQ(std::string(out, 5), "a%20b");
+  char small[4];
+  EXPECT_THROW(url::encode("a b", small, url::Component::Path), std::length_error);
+}
+
+TEST(UrlTest, DecodeStrictReportsMalformedEscape) {
+  size_t offset = 0;
+  EXPECT_FALSE(url::decodeStrict("abc%XYdef", url::Component::Form, &offset).has_value());
+  EXPECT_EQ(offset, 3u);
+  EXPECT_FALSE(url::decodeStrict("abc%4", url::Component::Form, &offset).has_value());
+  EXPECT_EQ(offset, 3u);
+  EXPECT_EQ(url::decodeStrict("a+b%2B", url::Component::Form), "a b+");
+  EXPECT_EQ(url::decodeStrict("a+b%2B", url::Component::Path), "a+b+");
+}
+
+TEST(UrlTest, DecodeInPlace) {
+  std::string s = "hello%20world%21+and+more";
+  ASSERT_TRUE(url::decodeInPlace(s));
+  EXPECT_EQ(s, "hello world! and more");
+
+  std::string bad = "ok%2";
+  size_t offset = 0;
+  EXPECT_FALSE(url::decodeInPlace(bad, url::Component::Form, &offset));
+  EXPECT_EQ(offset, 2u);
+}
+
+TEST(UrlTest, DecodeIntoSameBuffer) {
+  char buf[] = "x%41y%42z";
+  const auto status = url::decode(std::string_view(buf, 9), std::span<char>(buf, 9), url::Component::Path);
+  ASSERT_TRUE(status.ok);
+  EXPECT_EQ(std::string(buf, status.written), "xAyBz");
+}
+
+TEST(UrlTest, QueryStringIteratesPairs) {
+  std::vector<std::pair<std::string_view, std::string_view>> pairs;
+  for (const auto& [key, value] : url::QueryString("?a=1&&b=x%20y&flag&=v&c=#frag")) {
+    pairs.emplace_back(key, value);
+  }
+  ASSERT_EQ(pairs.size(), 5u);
+  EXPECT_EQ(pairs[0], std::make_pair(std::string_view("a"), std::string_view("1")));
+  EXPECT_EQ(pairs[1], std::make_pair(std::string_view("b"), std::string_view("x%20y")));
+  EXPECT_EQ(pairs[2], std::make_pair(std::string_view("flag"), std::string_view("")));
+  EXPECT_EQ(pairs[3], std::make_pair(std::string_view(""), std::string_view("v")));
+  EXPECT_EQ(pairs[4], std::make_pair(std::string_view("c"), std::string_view("")));
+}
+
+TEST(UrlTest, QueryStringFind) {
+  const url::QueryString query("token=abc&page=2&page=3");
+  EXPECT_EQ(query.find("page"), "2");
+  EXPECT_EQ(query.find("token"), "abc");
+  EXPECT_FALSE(query.find("missing").has_value());
+  EXPECT_EQ(url::QueryString("").begin(), url::QueryString("").end());
+}